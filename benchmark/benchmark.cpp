@@ -0,0 +1,43 @@
+#include "benchmark.hpp"
+
+#include <fmt/format.h>
+
+#include <array>
+
+namespace cqasm::benchmark {
+
+/**
+ * Prints a line with the name of a benchmark, its duration per run, and its throughput.
+ */
+void print_result(std::string_view name, double seconds_per_run, double items_per_run, std::string_view items_name) {
+    fmt::print("{:<48} {:>12.3f} ms/run {:>16.0f} {}/s\n", name, seconds_per_run * 1e3, items_per_run / seconds_per_run,
+        items_name);
+}
+
+/**
+ * Generates a cQASM v3 program with the given number of statements,
+ * mixing declarations, gates with and without parameters, gate modifiers, non-gate instructions, and comments.
+ */
+std::string generate_program(size_t number_of_statements) {
+    static constexpr std::array<std::string_view, 10> statements{
+        "H q[0:7]",
+        "CNOT q[0], q[1]  // entangle",
+        "Rx(pi / 2) q[2]",
+        "CR(1.5707963267948966) q[3], q[4]",
+        "inv.X q[5]",
+        "pow(2).ctrl.Y q[6], q[7]",
+        "b[0, 1] = measure q[0, 1]",
+        "reset q[2]",
+        "barrier q[0:3]",
+        "wait(2 * 3 + 1) q[4]",
+    };
+    std::string ret{ "version 3.0\n\n/* generated program */\nqubit[8] q\nbit[8] b\n" };
+    ret.reserve(ret.size() + number_of_statements * 24);
+    for (size_t i = 0; i < number_of_statements; ++i) {
+        ret += statements[i % statements.size()];
+        ret += '\n';
+    }
+    return ret;
+}
+
+}  // namespace cqasm::benchmark
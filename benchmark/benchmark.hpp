@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>  // size_t
+#include <string>
+#include <string_view>
+
+namespace cqasm::benchmark {
+
+/**
+ * Runs the given function repeatedly, for at least the given amount of time,
+ * and returns the average duration of a run, in seconds.
+ */
+template <typename F>
+double seconds_per_run(F&& f, std::chrono::duration<double> min_duration = std::chrono::seconds{ 1 }) {
+    using clock = std::chrono::steady_clock;
+    size_t runs = 0;
+    auto start = clock::now();
+    auto elapsed = std::chrono::duration<double>{};
+    do {
+        f();
+        ++runs;
+        elapsed = clock::now() - start;
+    } while (elapsed < min_duration);
+    return elapsed.count() / static_cast<double>(runs);
+}
+
+/**
+ * Prints a line with the name of a benchmark, its duration per run, and its throughput.
+ */
+void print_result(std::string_view name, double seconds_per_run, double items_per_run, std::string_view items_name);
+
+/**
+ * Generates a cQASM v3 program with the given number of statements,
+ * mixing declarations, gates with and without parameters, gate modifiers, non-gate instructions, and comments.
+ */
+std::string generate_program(size_t number_of_statements);
+
+}  // namespace cqasm::benchmark
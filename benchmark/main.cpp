@@ -0,0 +1,19 @@
+#include <fmt/format.h>
+
+#include "v3x/benchmarks.hpp"
+
+int main() {
+    fmt::print("cQASM v3 benchmarks\n");
+    cqasm::v3x::benchmark::run_lexer_benchmarks();
+    cqasm::v3x::benchmark::run_parser_benchmarks();
+    cqasm::v3x::benchmark::run_parser_session_benchmarks();
+    cqasm::v3x::benchmark::run_allocation_benchmarks();
+    cqasm::v3x::benchmark::run_source_location_benchmarks();
+    cqasm::v3x::benchmark::run_semantic_analyzer_benchmarks();
+    cqasm::v3x::benchmark::run_overload_resolution_benchmarks();
+    cqasm::v3x::benchmark::run_analyzer_construction_benchmarks();
+    cqasm::v3x::benchmark::run_concurrent_analysis_benchmarks();
+    cqasm::v3x::benchmark::run_incremental_parser_benchmarks();
+    cqasm::v3x::benchmark::run_expression_benchmarks();
+    return 0;
+}
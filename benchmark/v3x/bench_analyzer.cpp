@@ -0,0 +1,106 @@
+#include <fmt/format.h>
+
+#include <cstddef>  // size_t
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "libqasm/tree.hpp"
+#include "libqasm/v3x/analyzer.hpp"
+#include "libqasm/v3x/cqasm.hpp"
+#include "libqasm/v3x/semantic.hpp"
+#include "libqasm/v3x/values.hpp"
+#include "v3x/benchmarks.hpp"
+
+namespace cqasm::v3x::benchmark {
+
+using cqasm::benchmark::generate_program;
+using cqasm::benchmark::print_result;
+using cqasm::benchmark::seconds_per_run;
+
+/**
+ * Returns a reference to the qubit at the given index of a qubit array.
+ */
+values::Value qubit_operand(const tree::One<semantic::Variable>& qubits, primitives::Int index) {
+    tree::Many<values::ConstInt> indices{};
+    indices.add(tree::make<values::ConstInt>(index));
+    return values::Value{ tree::make<values::IndexRef>(tree::Link<semantic::Variable>{ qubits }, indices) };
+}
+
+void run_analyzer_construction_benchmarks() {
+    print_result("analyzer_construction/register_defaults",
+        seconds_per_run([]() {
+            analyzer::Analyzer analyzer{};
+            analyzer.register_default_constants();
+            analyzer.register_default_functions();
+            analyzer.register_default_instructions();
+        }),
+        1, "analyzers");
+    auto construction_time = seconds_per_run([]() { static_cast<void>(default_analyzer()); });
+    print_result("analyzer_construction/default_analyzer", construction_time, 1, "analyzers");
+    for (size_t number_of_statements : { 10, 200 }) {
+        auto input = generate_program(number_of_statements);
+        auto end_to_end_time = seconds_per_run(
+            [&input]() { static_cast<void>(default_analyzer().analyze_string(input, "input.cq")); });
+        print_result(fmt::format("analyzer_construction/analyze_string/{}", number_of_statements), end_to_end_time, 1,
+            "programs");
+        fmt::print("{:<48} {:>12.1f} % of analyze_string\n",
+            fmt::format("analyzer_construction/share/{}", number_of_statements),
+            100 * construction_time / end_to_end_time);
+    }
+}
+
+void run_concurrent_analysis_benchmarks() {
+    constexpr size_t programs_per_thread = 100;
+    const auto analyzer = default_analyzer();
+    const auto input = generate_program(200);
+    for (size_t number_of_threads : { 1, 4 }) {
+        print_result(fmt::format("concurrent_analysis/threads/{}", number_of_threads),
+            seconds_per_run([&analyzer, &input, number_of_threads]() {
+                std::vector<std::thread> threads;
+                for (size_t i = 0; i < number_of_threads; ++i) {
+                    threads.emplace_back([&analyzer, &input]() {
+                        for (size_t j = 0; j < programs_per_thread; ++j) {
+                            static_cast<void>(analyzer.analyze_string(input, "input.cq"));
+                        }
+                    });
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            }),
+            static_cast<double>(number_of_threads * programs_per_thread), "programs");
+    }
+}
+
+void run_overload_resolution_benchmarks() {
+    constexpr size_t number_of_gates = 1'000'000;
+    analyzer::Analyzer analyzer{};
+    analyzer.register_default_constants();
+    analyzer.register_default_functions();
+    analyzer.register_default_instructions();
+    auto qubits = tree::make<semantic::Variable>("q", tree::make<types::QubitArray>(8));
+    auto qubits_operand = values::Value{ tree::make<values::VariableRef>(tree::Link<semantic::Variable>{ qubits }) };
+    struct Gate {
+        std::string name;
+        values::Values operands;
+    };
+    const auto gates = {
+        Gate{ "H", values::Values{ qubit_operand(qubits, 0) } },
+        Gate{ "CNOT", values::Values{ qubit_operand(qubits, 0), qubit_operand(qubits, 1) } },
+        Gate{ "X", values::Values{ qubits_operand } },
+    };
+    for (const auto& [name, operands] : gates) {
+        auto gate = tree::make<semantic::Gate>(name);
+        print_result(fmt::format("overload_resolution/{}/{}", name, number_of_gates),
+            seconds_per_run([&analyzer, &name = name, &gate, &operands = operands]() {
+                for (size_t i = 0; i < number_of_gates; ++i) {
+                    static_cast<void>(analyzer.resolve_instruction(name, gate, operands));
+                }
+            }),
+            static_cast<double>(number_of_gates), "gates");
+    }
+}
+
+}  // namespace cqasm::v3x::benchmark
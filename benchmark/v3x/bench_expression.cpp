@@ -0,0 +1,81 @@
+#include <fmt/format.h>
+
+#include <cstddef>  // size_t
+#include <string>
+#include <string_view>
+#include <utility>  // pair
+
+#include "benchmark.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "libqasm/v3x/parse_options.hpp"
+#include "v3x/benchmarks.hpp"
+
+namespace cqasm::v3x::benchmark {
+
+using cqasm::benchmark::print_result;
+using cqasm::benchmark::seconds_per_run;
+
+/**
+ * Returns a deep expression, nesting the given number of binary operations in parentheses, e.g. '((1 + 2) * 3)'.
+ */
+std::string generate_deep_expression(size_t number_of_operations) {
+    static constexpr std::string_view operators[] = { " + ", " * ", " - ", " / " };
+    std::string ret{ "1" };
+    for (size_t i = 0; i < number_of_operations; ++i) {
+        ret = fmt::format("({}{}{})", ret, operators[i % 4], i + 2);
+    }
+    return ret;
+}
+
+/**
+ * Returns a wide expression, chaining the given number of binary operations of different precedences,
+ * e.g. '1 + 2 * 3 - 4 ** 5'.
+ */
+std::string generate_wide_expression(size_t number_of_operations) {
+    static constexpr std::string_view operators[] = { " + ", " * ", " - ", " ** ", " / ", " << ", " < ", " && " };
+    std::string ret{ "1" };
+    for (size_t i = 0; i < number_of_operations; ++i) {
+        ret += fmt::format("{}{}", operators[i % 8], i + 2);
+    }
+    return ret;
+}
+
+/**
+ * Returns a program with the given number of instructions, each of them with the given expression as a parameter.
+ */
+std::string generate_expression_program(const std::string& expression, size_t number_of_instructions) {
+    std::string ret{ "version 3.0\nqubit q\n" };
+    for (size_t i = 0; i < number_of_instructions; ++i) {
+        ret += fmt::format("Rx({}) q\n", expression);
+    }
+    return ret;
+}
+
+void run_expression_benchmarks() {
+    struct Configuration {
+        std::string name;
+        parser::ParseOptions options;
+    };
+    const auto configurations = {
+        Configuration{ "antlr", { .build_mode = parser::BuildMode::statement_by_statement } },
+        Configuration{ "precedence_climbing",
+            { .build_mode = parser::BuildMode::statement_by_statement,
+                .expression_parser = parser::ExpressionParserType::precedence_climbing } },
+    };
+    const size_t number_of_instructions = 1'000;
+    for (size_t number_of_operations : { 8, 64 }) {
+        const auto shapes = { std::pair{ "deep", generate_deep_expression(number_of_operations) },
+            std::pair{ "wide", generate_wide_expression(number_of_operations) } };
+        for (const auto& [shape, expression] : shapes) {
+            auto input = generate_expression_program(expression, number_of_instructions);
+            for (const auto& [name, options] : configurations) {
+                print_result(fmt::format("expression/{}/{}/{}", name, shape, number_of_operations),
+                    seconds_per_run(
+                        [&input, &options = options]() { parser::parse_string(input, "input.cq", options); }),
+                    static_cast<double>(number_of_instructions), "expressions");
+            }
+        }
+    }
+}
+
+}  // namespace cqasm::v3x::benchmark
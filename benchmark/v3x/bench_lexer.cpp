@@ -0,0 +1,48 @@
+#include <antlr4-runtime.h>
+#include <fmt/format.h>
+
+#include <cstddef>  // size_t
+#include <string>
+
+#include "benchmark.hpp"
+#include "libqasm/v3x/CqasmLexer.h"
+#include "libqasm/v3x/cqasm_fast_lexer.hpp"
+#include "v3x/benchmarks.hpp"
+
+namespace cqasm::v3x::benchmark {
+
+using cqasm::benchmark::generate_program;
+using cqasm::benchmark::print_result;
+using cqasm::benchmark::seconds_per_run;
+
+/**
+ * Drains a token source and returns the number of tokens, including EOF.
+ */
+size_t count_tokens(antlr4::TokenSource& token_source) {
+    size_t ret = 1;
+    while (token_source.nextToken()->getType() != antlr4::Token::EOF) {
+        ++ret;
+    }
+    return ret;
+}
+
+template <typename Lexer>
+size_t lex(const std::string& input) {
+    antlr4::ANTLRInputStream is{ input };
+    Lexer lexer{ &is };
+    lexer.removeErrorListeners();
+    return count_tokens(lexer);
+}
+
+void run_lexer_benchmarks() {
+    for (size_t number_of_statements : { 1'000, 100'000 }) {
+        auto input = generate_program(number_of_statements);
+        auto tokens = static_cast<double>(lex<CqasmLexer>(input));
+        print_result(fmt::format("lexer/antlr/{}", number_of_statements),
+            seconds_per_run([&input]() { lex<CqasmLexer>(input); }), tokens, "tokens");
+        print_result(fmt::format("lexer/hand_written/{}", number_of_statements),
+            seconds_per_run([&input]() { lex<parser::CqasmFastLexer>(input); }), tokens, "tokens");
+    }
+}
+
+}  // namespace cqasm::v3x::benchmark
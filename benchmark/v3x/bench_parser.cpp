@@ -0,0 +1,154 @@
+#include <fmt/format.h>
+
+#include <cstddef>  // size_t
+#include <string>
+
+#include "benchmark.hpp"
+#include "libqasm/v3x/analyzer.hpp"
+#include "libqasm/v3x/incremental_parser.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "libqasm/v3x/parse_options.hpp"
+#include "libqasm/v3x/parser_session.hpp"
+#include "libqasm/v3x/syntactic.hpp"
+#include "libqasm/v3x/syntax_checker.hpp"
+#include "v3x/benchmarks.hpp"
+
+namespace cqasm::v3x::benchmark {
+
+using cqasm::benchmark::generate_program;
+using cqasm::benchmark::print_result;
+using cqasm::benchmark::seconds_per_run;
+
+void run_parser_benchmarks() {
+    struct Configuration {
+        std::string name;
+        parser::ParseOptions options;
+    };
+    const auto configurations = {
+        Configuration{ "ll", {} },
+        Configuration{ "sll_then_ll", { .prediction_strategy = parser::PredictionStrategy::sll_then_ll } },
+        Configuration{ "statement_by_statement", { .build_mode = parser::BuildMode::statement_by_statement } },
+        Configuration{ "parallel_chunks", { .build_mode = parser::BuildMode::parallel_chunks } },
+    };
+    for (size_t number_of_statements : { 1'000, 100'000 }) {
+        auto input = generate_program(number_of_statements);
+        for (const auto& [name, options] : configurations) {
+            print_result(fmt::format("parser/{}/{}", name, number_of_statements),
+                seconds_per_run([&input, &options = options]() { parser::parse_string(input, "input.cq", options); }),
+                static_cast<double>(number_of_statements), "statements");
+        }
+        // Recognition only, without building the syntactic AST
+        print_result(fmt::format("parser/check_string/{}", number_of_statements),
+            seconds_per_run([&input]() { parser::check_string(input, "input.cq"); }),
+            static_cast<double>(number_of_statements), "statements");
+    }
+}
+
+void run_allocation_benchmarks() {
+    constexpr size_t number_of_statements = 1'000'000;
+    auto input = generate_program(number_of_statements);
+    for (auto allocation_mode : { parser::AllocationMode::heap, parser::AllocationMode::arena }) {
+        auto name = allocation_mode == parser::AllocationMode::heap ? "heap" : "arena";
+        print_result(fmt::format("allocation/{}/{}", name, number_of_statements),
+            seconds_per_run([&input, allocation_mode]() {
+                parser::parse_string(input, "input.cq", { .allocation_mode = allocation_mode });
+            }),
+            static_cast<double>(number_of_statements), "statements");
+    }
+    // Every node allocated from the arena would otherwise be a heap allocation of its own
+    auto arena = parser::parse_string(input, "input.cq", { .allocation_mode = parser::AllocationMode::arena }).arena;
+    fmt::print("{:<48} {:>12} nodes {:>12} chunks {:>12.1f} MiB\n",
+        fmt::format("allocation/arena_usage/{}", number_of_statements), arena->number_of_allocations(),
+        arena->number_of_chunks(), static_cast<double>(arena->memory_usage()) / (1024 * 1024));
+}
+
+namespace {
+
+/**
+ * Counts the nodes of a syntactic tree annotated with their source location.
+ */
+class SourceLocationCounter : public syntactic::RecursiveVisitor {
+public:
+    size_t count = 0;
+
+    void visit_node(syntactic::Node& node) override {
+        if (node.get_annotation_ptr<parser::SourceLocation>() != nullptr) {
+            ++count;
+        }
+    }
+};
+
+}  // namespace
+
+void run_source_location_benchmarks() {
+    constexpr size_t number_of_statements = 1'000'000;
+    auto input = generate_program(number_of_statements);
+    analyzer::Analyzer analyzer{};
+    analyzer.register_default_constants();
+    analyzer.register_default_functions();
+    analyzer.register_default_instructions();
+    for (auto source_location_mode :
+         { parser::SourceLocationMode::all_nodes, parser::SourceLocationMode::statements }) {
+        auto name = source_location_mode == parser::SourceLocationMode::all_nodes ? "all_nodes" : "statements";
+        print_result(fmt::format("source_location/parse/{}/{}", name, number_of_statements),
+            seconds_per_run([&input, source_location_mode]() {
+                parser::parse_string(input, "input.cq", { .source_location_mode = source_location_mode });
+            }),
+            static_cast<double>(number_of_statements), "statements");
+        analyzer.source_location_mode = source_location_mode;
+        print_result(fmt::format("source_location/analyze/{}/{}", name, number_of_statements),
+            seconds_per_run([&input, &analyzer]() { static_cast<void>(analyzer.analyze_string(input, "input.cq")); }),
+            static_cast<double>(number_of_statements), "statements");
+        // Every annotation is a SourceLocation, allocated together with its reference count
+        SourceLocationCounter counter{};
+        auto parse_result = parser::parse_string(input, "input.cq", { .source_location_mode = source_location_mode });
+        parse_result.root->visit(counter);
+        fmt::print("{:<48} {:>12} annotations {:>12.1f} MiB\n",
+            fmt::format("source_location/usage/{}/{}", name, number_of_statements), counter.count,
+            static_cast<double>(counter.count * sizeof(parser::SourceLocation)) / (1024 * 1024));
+    }
+}
+
+void run_semantic_analyzer_benchmarks() {
+    analyzer::Analyzer analyzer{};
+    analyzer.register_default_constants();
+    analyzer.register_default_functions();
+    analyzer.register_default_instructions();
+    for (size_t number_of_statements : { 1'000, 100'000 }) {
+        // Parse once, so that only the semantic analysis is measured
+        auto input = generate_program(number_of_statements);
+        auto parse_result = parser::parse_string(input, "input.cq");
+        print_result(fmt::format("semantic_analyzer/analyze/{}", number_of_statements),
+            seconds_per_run([&analyzer, &parse_result]() { static_cast<void>(analyzer.analyze(parse_result)); }),
+            static_cast<double>(number_of_statements), "statements");
+    }
+}
+
+void run_parser_session_benchmarks() {
+    for (size_t number_of_statements : { 10, 200 }) {
+        auto input = generate_program(number_of_statements);
+        print_result(fmt::format("parser_session/parse_string/{}", number_of_statements),
+            seconds_per_run([&input]() { parser::parse_string(input, "input.cq"); }), 1, "parses");
+        parser::ParserSession parser_session{};
+        print_result(fmt::format("parser_session/session/{}", number_of_statements),
+            seconds_per_run([&input, &parser_session]() { parser_session.parse_string(input, "input.cq"); }), 1,
+            "parses");
+    }
+}
+
+void run_incremental_parser_benchmarks() {
+    for (size_t number_of_statements : { 1'000, 100'000 }) {
+        auto input = generate_program(number_of_statements);
+        parser::IncrementalParser incremental_parser{ input, "input.cq" };
+        // Type and delete a space at the end of a line in the middle of the program
+        auto offset = input.find('\n', input.size() / 2);
+        print_result(fmt::format("incremental_parser/edit/{}", number_of_statements),
+            seconds_per_run([&incremental_parser, offset]() {
+                incremental_parser.apply_edit({ offset, 0, " " });
+                incremental_parser.apply_edit({ offset, 1, "" });
+            }),
+            2, "edits");
+    }
+}
+
+}  // namespace cqasm::v3x::benchmark
@@ -0,0 +1,70 @@
+#pragma once
+
+namespace cqasm::v3x::benchmark {
+
+/**
+ * Compares the parse time of a program with a million statements,
+ * with the nodes of the syntactic AST allocated from the heap and from an arena,
+ * and reports the number of nodes allocated from the arena, i.e. the number of heap allocations it saves.
+ */
+void run_allocation_benchmarks();
+
+/**
+ * Compares the cost of constructing an analyzer with the default constants, functions, and instructions,
+ * registering them from scratch and sharing them with a prototype analyzer,
+ * and reports the share of the construction in the time to analyze small programs.
+ */
+void run_analyzer_construction_benchmarks();
+
+/**
+ * Measures the throughput, in programs per second, of analyzing small programs
+ * with one analyzer shared by one and by four threads.
+ */
+void run_concurrent_analysis_benchmarks();
+
+/**
+ * Compares the cost per expression, for deep and wide expressions,
+ * of the ANTLR-generated and the precedence climbing expression parsers.
+ */
+void run_expression_benchmarks();
+
+/**
+ * Measures the cost per edit of an IncrementalParser, for a small and a large program.
+ */
+void run_incremental_parser_benchmarks();
+
+/**
+ * Compares the throughput, in tokens per second, of the ANTLR-generated and the hand-written lexers.
+ */
+void run_lexer_benchmarks();
+
+/**
+ * Measures the cost per gate of resolving the instruction overload of a million gates with the same operand types,
+ * for a single-qubit gate, a two-qubit gate, and a single-qubit gate on a whole qubit array.
+ */
+void run_overload_resolution_benchmarks();
+
+/**
+ * Compares the throughput, in statements per second, of the parser with different parse options,
+ * and of the recognition-only check_string.
+ */
+void run_parser_benchmarks();
+
+/**
+ * Compares the cost per parse of small programs, with a new parser for every parse, and with a reused ParserSession.
+ */
+void run_parser_session_benchmarks();
+
+/**
+ * Measures the semantic analysis time per statement of an already parsed program, for a small and a large program.
+ */
+void run_semantic_analyzer_benchmarks();
+
+/**
+ * Compares the parse and analysis time of a program with a million statements,
+ * with all the syntactic nodes annotated with their source location, and with only statements and gates,
+ * and reports the number of annotations, and the memory used by them, in each mode.
+ */
+void run_source_location_benchmarks();
+
+}  // namespace cqasm::v3x::benchmark
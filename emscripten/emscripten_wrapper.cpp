@@ -35,7 +35,9 @@ std::string EmscriptenWrapper::parse_string_to_json(const std::string& data, con
  * The JSON representation of each error follows the Language Server Protocol (LSP) specification.
  * Every error is mapped to an LSP Diagnostic structure:
  * severity is hardcoded to 1 at the moment (value corresponding to an Error level).
+ * All calls share one analyzer, so its parser session is only constructed once.
  */
 std::string EmscriptenWrapper::analyze_string_to_json(const std::string& data, const std::string& file_name) {
-    return V3xAnalyzer{}.analyze_string_to_json(data, file_name);
+    static const V3xAnalyzer analyzer{};
+    return analyzer.analyze_string_to_json(data, file_name);
 }
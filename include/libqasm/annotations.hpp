@@ -6,14 +6,83 @@
 
 #include <fmt/ostream.h>
 
+#include <cstddef>  // size_t
 #include <cstdint>
 #include <optional>
+#include <ostream>
 #include <string>
+#include <string_view>
 
 namespace cqasm::annotations {
 
+/**
+ * Name of a source file, stored once in a process-wide file table.
+ *
+ * Every distinct file name is stored only once in the table, so all the source locations of a file
+ * share the same name instead of holding a copy of it. An entry is kept alive by the file names pointing to it,
+ * e.g. by the source locations of the nodes of a tree, and is freed together with the last of them,
+ * so the table only holds the names of the files in use. An empty file name is the same as no file name.
+ * It can be used as an std::optional<std::string>.
+ */
+class FileName {
+    struct Data;
+    struct Table;
+
+    /**
+     * Entry of the file name in the file table, or null if there is no file name.
+     */
+    Data* data_ = nullptr;
+
+    static Table& table();
+    static Data* intern(std::string_view file_name);
+    static bool try_add_reference(Data* data);
+    static void release(Data* data);
+
+public:
+    FileName() = default;
+    FileName(const FileName& other);
+    FileName(FileName&& other) noexcept;
+    FileName& operator=(const FileName& other);
+    FileName& operator=(FileName&& other) noexcept;
+    ~FileName();
+
+    FileName(std::nullopt_t);  // NOLINT(google-explicit-constructor)
+    FileName(const std::optional<std::string>& file_name);  // NOLINT(google-explicit-constructor)
+    FileName(const std::string& file_name);  // NOLINT(google-explicit-constructor)
+    FileName(const char* file_name);  // NOLINT(google-explicit-constructor)
+
+    [[nodiscard]] bool has_value() const;
+
+    /**
+     * Returns the file name.
+     * Throws a std::bad_optional_access if there is no file name.
+     */
+    [[nodiscard]] const std::string& value() const;
+
+    /**
+     * Returns the file name, or the default value if there is no file name.
+     */
+    [[nodiscard]] std::string_view value_or(std::string_view default_value) const;
+
+    [[nodiscard]] bool operator==(const FileName& other) const = default;
+    [[nodiscard]] bool operator==(const std::string& other) const;
+    [[nodiscard]] bool operator==(const char* other) const;
+
+    /**
+     * Number of distinct names in the file table, i.e. of the file names in use.
+     */
+    [[nodiscard]] static size_t table_size();
+};
+
 /**
  * Source location annotation object, containing source file line numbers etc.
+ *
+ * It holds a reference to a shared file name, and the 32-bit lines and columns of its range,
+ * i.e. 24 bytes on 64-bit platforms, instead of 56 bytes with a copy of the file name.
+ * Lines and columns are stored eagerly, as they are read from the tokens.
+ * Byte-offset spans, with lines and columns computed lazily from a line index of the source, are not implemented:
+ * columns count code points rather than bytes,
+ * and the incremental parser shifts the locations of the statements after an edit by lines.
  */
 struct SourceLocation {
     /**
@@ -50,7 +119,7 @@ struct SourceLocation {
     /**
      * The name of the source file.
      */
-    std::optional<std::string> file_name;
+    FileName file_name;
 
     /**
      * The source location range.
@@ -61,16 +130,15 @@ struct SourceLocation {
      * Constructs a source location object.
      */
     SourceLocation() = default;
-    explicit SourceLocation(const std::optional<std::string>& file_name, const Range& range);
+    explicit SourceLocation(const FileName& file_name, const Range& range);
     SourceLocation(const SourceLocation& other) = default;
     SourceLocation(SourceLocation&& other) noexcept = default;
     SourceLocation& operator=(const SourceLocation& other) = default;
     SourceLocation& operator=(SourceLocation&& other) noexcept = default;
 
     bool operator==(const SourceLocation& other) const = default;
-    // Some versions of clang still do not implement operator<=> for std::optional
-    // So they will complain if we try to define a default operator<=> on a struct that contains a std::optional
-    // This implementation just does not check the optional file_name
+    // File names are compared by ID, which does not follow the order of the names
+    // This implementation just does not check the file_name
     // Instead, it just assumes that, when comparing source locations, the file_name will be the same
     // This will always be the case if we are just parsing or analyzing a file or a string
     auto operator<=>(const SourceLocation& other) const { return range <=> other.range; }
@@ -81,6 +149,11 @@ struct SourceLocation {
     void expand_to_include(const Index& last);
 };
 
+/**
+ * Stream << overload for file names.
+ */
+std::ostream& operator<<(std::ostream& os, const FileName& object);
+
 /**
  * Stream << overload for source location objects.
  */
@@ -92,4 +165,6 @@ std::ostream& operator<<(std::ostream& os, const SourceLocation& object);
  * std::ostream support via fmt (uses operator<<).
  */
 template <>
+struct fmt::formatter<cqasm::annotations::FileName> : ostream_formatter {};
+template <>
 struct fmt::formatter<cqasm::annotations::SourceLocation> : ostream_formatter {};
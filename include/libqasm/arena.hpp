@@ -0,0 +1,119 @@
+/** \file
+ * Contains the Arena class, a monotonic memory arena for tree nodes, and the allocator and scope used with it.
+ */
+
+#pragma once
+
+#include <cstddef>  // byte, size_t
+#include <memory>  // shared_ptr, unique_ptr
+#include <utility>  // move
+#include <vector>
+
+namespace cqasm::tree {
+
+/**
+ * Monotonic memory arena, from which tree::make allocates nodes while an ArenaScope is active.
+ *
+ * Memory is handed out from large chunks by bumping a pointer, and is never given back to the arena:
+ * all the chunks are freed at once, when the arena is destroyed.
+ * A node allocated from an arena shares the ownership of the arena, together with its control block,
+ * so the arena outlives all its nodes, even those kept after the tree they were built for has been discarded.
+ *
+ * An arena is not thread-safe: it must only be allocated from by one thread at a time.
+ * Nodes allocated from it can be used, and released, from any thread.
+ */
+class Arena {
+    std::vector<std::unique_ptr<std::byte[]>> chunks_;
+    std::byte* next_ = nullptr;
+    size_t available_ = 0;
+    size_t next_chunk_size_ = initial_chunk_size;
+    size_t number_of_allocations_ = 0;
+    size_t memory_usage_ = 0;
+
+public:
+    /**
+     * Size of the first chunk, in bytes. Every following chunk doubles in size, up to max_chunk_size.
+     */
+    static constexpr size_t initial_chunk_size = 64 * 1024;
+
+    /**
+     * Maximum size of a chunk, in bytes, except for the chunk of an allocation larger than that.
+     */
+    static constexpr size_t max_chunk_size = 16 * 1024 * 1024;
+
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * Allocates size bytes, aligned to alignment, which has to be a power of two.
+     */
+    [[nodiscard]] void* allocate(size_t size, size_t alignment);
+
+    /**
+     * Number of allocations done from the arena.
+     */
+    [[nodiscard]] size_t number_of_allocations() const;
+
+    /**
+     * Number of chunks allocated by the arena from the heap.
+     */
+    [[nodiscard]] size_t number_of_chunks() const;
+
+    /**
+     * Total size of the chunks, in bytes.
+     */
+    [[nodiscard]] size_t memory_usage() const;
+
+    /**
+     * Arena tree::make allocates from in the current thread, or nullptr if there is none.
+     */
+    [[nodiscard]] static const std::shared_ptr<Arena>& current();
+};
+
+/**
+ * Standard allocator allocating from an arena, and sharing its ownership.
+ * Deallocation does nothing, as the memory of an arena is only freed when the arena is destroyed.
+ */
+template <class T>
+class ArenaAllocator {
+    std::shared_ptr<Arena> arena_;
+
+    template <class U>
+    friend class ArenaAllocator;
+
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<Arena> arena)
+    : arena_{ std::move(arena) } {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other)  // NOLINT(google-explicit-constructor)
+    : arena_{ other.arena_ } {}
+
+    [[nodiscard]] T* allocate(size_t n) { return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T))); }
+
+    void deallocate(T* /* p */, size_t /* n */) noexcept {}
+
+    template <class U>
+    [[nodiscard]] bool operator==(const ArenaAllocator<U>& rhs) const {
+        return arena_ == rhs.arena_;
+    }
+};
+
+/**
+ * Makes tree::make allocate from the given arena in the current thread, for the lifetime of the scope.
+ * A null arena makes tree::make allocate from the heap. Scopes can be nested.
+ */
+class ArenaScope {
+    std::shared_ptr<Arena> previous_;
+
+public:
+    explicit ArenaScope(std::shared_ptr<Arena> arena);
+    ~ArenaScope();
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+};
+
+}  // namespace cqasm::tree
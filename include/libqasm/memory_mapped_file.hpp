@@ -0,0 +1,45 @@
+/** \file
+ * Contains the MemoryMappedFile class, a read-only view over the contents of a file.
+ */
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <filesystem>
+#include <string_view>
+
+namespace cqasm {
+
+/**
+ * Read-only memory mapping of a whole file.
+ *
+ * The file contents are paged in by the operating system on demand, instead of being read into a buffer,
+ * so mapping even a very large file is cheap, and its contents are not copied.
+ * Throws a ParseError if the file cannot be opened or mapped.
+ */
+class MemoryMappedFile {
+    /**
+     * Start of the mapping, or nullptr for an empty file, which cannot be mapped.
+     */
+    const char* data_ = nullptr;
+
+    /**
+     * Size of the file, in bytes.
+     */
+    size_t size_ = 0;
+
+public:
+    explicit MemoryMappedFile(const std::filesystem::path& file_path);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    /**
+     * Contents of the file.
+     * The view is only valid for the lifetime of the mapping.
+     */
+    [[nodiscard]] std::string_view data() const noexcept;
+};
+
+}  // namespace cqasm
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <exception>
+#include <limits>  // numeric_limits
+#include <mutex>  // unique_lock
+#include <optional>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>  // pair
@@ -81,6 +85,10 @@ public:
  * but maybe also a lambda to represent the actual function.
  * Note that ambiguous overloads are silently resolved by using the last applicable overload,
  * so more specific overloads should always be added last.
+ *
+ * Resolutions are memoized by the promotion codes of the arguments, as returned by promotion_code,
+ * which determine whether and how an argument is promoted to a parameter type.
+ * An argument list with the same codes as a previous one is then promoted straight to the winning overload.
  */
 template <class T, class TypeBase, class Node>
 class OverloadResolver {
@@ -89,15 +97,136 @@ class OverloadResolver {
     using Value = tree::One<Node>;
     using Values = tree::Any<Node>;
 
+    /**
+     * Index of the winning overload of an argument list for which no overload is applicable.
+     */
+    static constexpr size_t no_overload = std::numeric_limits<size_t>::max();
+
     std::vector<Overload<T, TypeBase>> overloads;
 
+    /**
+     * Index of the winning overload for the argument lists resolved so far, keyed by their packed promotion codes.
+     * The cache is not copied, and is cleared when an overload is added.
+     */
+    mutable std::unordered_map<std::string, size_t> cache;
+    mutable std::shared_mutex cache_mutex;
+
+    /**
+     * Packs the promotion codes of an argument list, two bytes per argument.
+     */
+    [[nodiscard]] static std::string signature_of(const Values& args) {
+        std::string ret(args.size() * 2, '\0');
+        for (size_t i = 0; i < args.size(); i++) {
+            auto code = promotion_code(args.at(i));
+            ret[2 * i] = static_cast<char>(code >> 8);
+            ret[2 * i + 1] = static_cast<char>(code & 0xFF);
+        }
+        return ret;
+    }
+
+    /**
+     * Returns the index of the last overload the given arguments can be promoted to, or no_overload.
+     */
+    [[nodiscard]] size_t find_overload(const Values& args) const {
+        for (size_t index = overloads.size(); index-- > 0;) {
+            const auto& overload = overloads[index];
+            if (overload.num_params() != args.size()) {
+                continue;
+            }
+            bool ok = true;
+            for (size_t i = 0; i < args.size() && ok; i++) {
+                ok = !promote(args.at(i), overload.param_type_at(i)).empty();
+            }
+            if (ok) {
+                return index;
+            }
+        }
+        return no_overload;
+    }
+
+    /**
+     * Same as find_overload, but looking up the cache first, and filling it in on a miss.
+     */
+    [[nodiscard]] size_t find_cached_overload(const Values& args) const {
+        auto signature = signature_of(args);
+        {
+            std::shared_lock lock{ cache_mutex };
+            if (auto entry = cache.find(signature); entry != cache.end()) {
+                return entry->second;
+            }
+        }
+        auto index = find_overload(args);
+        std::unique_lock lock{ cache_mutex };
+        cache.emplace(std::move(signature), index);
+        return index;
+    }
+
 public:
+    OverloadResolver() = default;
+    ~OverloadResolver() = default;
+    OverloadResolver(const OverloadResolver& other)
+    : overloads{ other.overloads } {}
+    OverloadResolver(OverloadResolver&& other) noexcept
+    : overloads{ std::move(other.overloads) } {}
+    OverloadResolver& operator=(const OverloadResolver& other) {
+        if (this != &other) {
+            overloads = other.overloads;
+            clear_cache();
+        }
+        return *this;
+    }
+    OverloadResolver& operator=(OverloadResolver&& other) noexcept {
+        if (this != &other) {
+            overloads = std::move(other.overloads);
+            clear_cache();
+        }
+        return *this;
+    }
+
     /**
      * Adds a possible overload to the resolver.
      * Note that ambiguous overloads are silently resolved by using the last applicable overload,
      * so more specific overloads should always be added last.
      */
-    void add_overload(const T& tag, const Types& param_types) { overloads.emplace_back(tag, param_types); }
+    void add_overload(const T& tag, const Types& param_types) {
+        overloads.emplace_back(tag, param_types);
+        clear_cache();
+    }
+
+    /**
+     * Forgets the resolutions memoized so far.
+     */
+    void clear_cache() {
+        std::unique_lock lock{ cache_mutex };
+        cache.clear();
+    }
+
+    /**
+     * Returns the number of argument lists, by promotion codes, whose resolution is memoized.
+     */
+    [[nodiscard]] size_t cache_size() const {
+        std::shared_lock lock{ cache_mutex };
+        return cache.size();
+    }
+
+    /**
+     * Tries to resolve which overload belongs to the given argument list, if any.
+     * Returns empty if no applicable overload exists,
+     * otherwise the tag corresponding to the first proper overload and
+     * the appropriately promoted vector of value pointers are returned.
+     */
+    [[nodiscard]] std::optional<std::pair<T, Values>> try_resolve(const Values& args) const {
+        auto index = find_cached_overload(args);
+        if (index == no_overload) {
+            return std::nullopt;
+        }
+        const auto& overload = overloads[index];
+        Values promoted_args;
+        for (size_t i = 0; i < args.size(); i++) {
+            promoted_args.add(promote(args.at(i), overload.param_type_at(i)));
+        }
+        return std::pair<T, Values>(overload.get_tag(), promoted_args);
+    }
 
     /**
      * Tries to resolve which overload belongs to the given argument list, if any.
@@ -105,24 +234,9 @@ public:
      * otherwise the tag corresponding to the first proper overload and
      * the appropriately promoted vector of value pointers are returned.
      */
-    [[nodiscard]] std::pair<T, Values> resolve(const Values& args) {
-        for (auto overload = overloads.rbegin(); overload != overloads.rend(); ++overload) {
-            if (overload->num_params() != args.size()) {
-                continue;
-            }
-            Values promoted_args;
-            bool ok = true;
-            for (size_t i = 0; i < args.size(); i++) {
-                auto promoted_arg = promote(args.at(i), overload->param_type_at(i));
-                if (promoted_arg.empty()) {
-                    ok = false;
-                    break;
-                }
-                promoted_args.add(promoted_arg);
-            }
-            if (ok) {
-                return std::pair<T, Values>(overload->get_tag(), promoted_args);
-            }
+    [[nodiscard]] std::pair<T, Values> resolve(const Values& args) const {
+        if (auto resolution = try_resolve(args); resolution.has_value()) {
+            return std::move(*resolution);
         }
         throw OverloadResolutionFailure{};
     }
@@ -166,6 +280,25 @@ public:
         }
     }
 
+    /**
+     * Returns whether a callable with the given case-sensitively matched name exists.
+     */
+    [[nodiscard]] bool contains(const std::string& name) const { return table.find(name) != table.end(); }
+
+    /**
+     * Resolves the particular overload for the callable with the given case-sensitively matched name.
+     * Returns empty if no callable with the requested name is found, or if overload resolution fails,
+     * otherwise returns the tag of the first applicable callable/overload pair and
+     * the appropriately promoted vector of value pointers.
+     * contains can then tell both failures apart.
+     */
+    [[nodiscard]] std::optional<std::pair<T, Values>> try_resolve(const std::string& name, const Values& args) const {
+        if (auto entry = table.find(name); entry != table.end()) {
+            return entry->second.try_resolve(args);
+        }
+        return std::nullopt;
+    }
+
     /**
      * Resolves the particular overload for the callable with the given case-sensitively matched name.
      * Raises NameResolutionFailure if no callable with the requested name is found,
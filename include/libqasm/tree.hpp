@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <memory>  // allocate_shared, make_shared
+
+#include "libqasm/arena.hpp"
 #include "tree-annotatable.hpp"
 #include "tree-base.hpp"
 
@@ -37,9 +40,13 @@ using OptLink = ::tree::base::OptLink<T>;
 
 /**
  * Constructs a One object, analogous to std::make_shared.
+ * The node is allocated from the arena of the current ArenaScope, if any.
  */
 template <class T, typename... Args>
 One<T> make(Args... args) {
+    if (const auto& arena = Arena::current(); arena != nullptr) {
+        return One<T>(std::allocate_shared<T>(ArenaAllocator<T>{ arena }, args...));
+    }
     return One<T>(std::make_shared<T>(args...));
 }
 
@@ -8,15 +8,19 @@
 
 #pragma once
 
+#include <cstddef>  // size_t
 #include <functional>
 #include <list>
+#include <memory>  // shared_ptr
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "analysis_result.hpp"
 #include "libqasm/v3x/core_function.hpp"
 #include "libqasm/v3x/parse_helper.hpp"
 #include "libqasm/v3x/resolver.hpp"
+#include "libqasm/v3x/result_cache.hpp"
 #include "libqasm/v3x/scope.hpp"
 #include "libqasm/v3x/semantic.hpp"
 #include "libqasm/v3x/syntactic.hpp"
@@ -26,6 +30,24 @@
  */
 namespace cqasm::v3x::analyzer {
 
+/**
+ * How the analyze_file and analyze_string methods drive parsing and semantic analysis.
+ */
+enum class PipelineMode {
+    /**
+     * Parse the whole program into a syntactic AST first, and then analyze it.
+     */
+    two_phase,
+
+    /**
+     * Analyze each statement as soon as it has been parsed by a StatementStream,
+     * and drop its syntactic subtree straight away.
+     * The syntactic AST of the whole program is never held in memory.
+     * If the program contains a parse error, it is analyzed again in the two_phase mode, so errors are the same.
+     */
+    fused
+};
+
 /**
  * Main class used for analyzing cQASM files.
  *
@@ -41,6 +63,8 @@ namespace cqasm::v3x::analyzer {
  *
  * Note that the only state maintained by the Analyzer object is its configuration,
  * and the `analyze*()` functions never change this state (hence they are const).
+ * The state of each analysis, such as the variables and statements of the program, is owned by a SemanticAnalyzer,
+ * so many threads may analyze programs with the same Analyzer at the same time.
  */
 class Analyzer {
     friend class SemanticAnalyzer;
@@ -51,17 +75,64 @@ public:
      */
     primitives::Version api_version;
 
+    /**
+     * How the analyze_file and analyze_string methods drive parsing and semantic analysis.
+     */
+    PipelineMode pipeline_mode = PipelineMode::two_phase;
+
+    /**
+     * Which nodes of the syntactic AST are annotated with their source location
+     * by the analyze_file and analyze_string methods.
+     * Semantic nodes are annotated only if the syntactic nodes they are built from are.
+     */
+    parser::SourceLocationMode source_location_mode = parser::SourceLocationMode::all_nodes;
+
+    /**
+     * Optional cache of the results of analyze_string, which may be shared by many analyzers.
+     * Results are cached by program text and file name,
+     * together with the API version, the pipeline and source location modes, and the registered constants, functions,
+     * and instructions.
+     * The cache is not used once consteval core functions other than the default ones have been registered,
+     * as functions are only identified by their name and parameter types.
+     * Results returned from the cache share their semantic tree with it, so they must not be modified.
+     */
+    std::shared_ptr<AnalysisResultCache> result_cache;
+
 protected:
     std::list<Scope> scope_stack_;
 
+    /**
+     * Whether consteval core functions other than the default ones have been registered.
+     */
+    bool has_custom_functions_ = false;
+
+    static void add_to_configuration_hash(Scope& scope, const std::string& description);
+
+    /**
+     * Hash of the API version and of everything registered in the scopes of the scope stack,
+     * used as the configuration of cached results.
+     */
+    [[nodiscard]] size_t configuration_hash() const;
+
     [[nodiscard]] Scope& global_scope();
     [[nodiscard]] Scope& current_scope();
-    [[nodiscard]] tree::One<semantic::Block> current_block();
-    [[nodiscard]] tree::Any<semantic::Variable>& current_variables();
 
     [[nodiscard]] const Scope& global_scope() const;
     [[nodiscard]] const Scope& current_scope() const;
-    [[nodiscard]] const tree::Any<semantic::Variable>& current_variables() const;
+
+    /**
+     * Parses and analyzes the given data one statement at a time, for the fused pipeline mode.
+     * Returns an empty optional if the data contains a parse error.
+     */
+    [[nodiscard]] std::optional<AnalysisResult> analyze_fused(
+        std::string_view data, const std::optional<std::string>& file_name) const;
+
+    /**
+     * Adds a statement to the given block,
+     * expanding the source location annotation of the block to include the one of the statement.
+     */
+    static void add_statement_to_block(
+        const tree::One<semantic::Block>& block, const tree::One<semantic::Statement>& statement);
 
 public:
     /**
@@ -69,6 +140,21 @@ public:
      */
     explicit Analyzer(const primitives::Version& api_version = "3.0");
 
+    /**
+     * Creates a semantic analyzer with the configuration of another one.
+     * Every scope shares the registered constants, functions, and instructions of the same scope of the other analyzer
+     * until either of them registers something else, so copying is cheap.
+     */
+    Analyzer(const Analyzer& other);
+    Analyzer& operator=(const Analyzer& other);
+
+    /**
+     * Moves the configuration of another semantic analyzer, including its scopes.
+     * The other analyzer is left without any scope, so it may only be assigned to or destroyed.
+     */
+    Analyzer(Analyzer&& other) = default;
+    Analyzer& operator=(Analyzer&& other) = default;
+
     /**
      * Destroys a semantic analyzer.
      */
@@ -92,29 +178,31 @@ public:
     /**
      * Analyzes the given program AST node.
      */
-    [[nodiscard]] virtual AnalysisResult analyze(syntactic::Program& program);
+    [[nodiscard]] virtual AnalysisResult analyze(syntactic::Program& program) const;
 
     /**
      * Analyzes the given parse result.
      * If there are parse errors, they are moved into the AnalysisResult error list,
      * and the root node will be empty.
      */
-    [[nodiscard]] virtual AnalysisResult analyze(const parser::ParseResult& parse_result);
+    [[nodiscard]] virtual AnalysisResult analyze(const parser::ParseResult& parse_result) const;
 
     /**
      * Parses and analyzes the given file.
      */
-    [[nodiscard]] virtual AnalysisResult analyze_file(const std::string& file_name);
+    [[nodiscard]] virtual AnalysisResult analyze_file(const std::string& file_name) const;
 
     /**
      * Parses and analyzes the given string.
      * The optional file_name argument will be used only for error messages.
      */
     [[nodiscard]] virtual AnalysisResult analyze_string(
-        const std::string& data, const std::optional<std::string>& file_name);
+        const std::string& data, const std::optional<std::string>& file_name) const;
 
     /**
      * Pushes a new empty scope to the top of the scope stack.
+     * The scopes of an analyzer only hold its configuration, e.g. constants registered for a single use of the analyzer,
+     * which are visible to the analyzed programs until the scope is popped.
      */
     void push_scope();
 
@@ -124,25 +212,23 @@ public:
     void pop_scope();
 
     /**
-     * Adds a statement to the current scope.
-     */
-    virtual void add_statement_to_current_scope(const tree::One<semantic::Statement>& statement);
-
-    /**
-     * Adds a variable to the current scope.
+     * Resolves a variable, looking it up from the innermost to the outermost scope.
+     * Returns empty if no variable by the given name exists.
      */
-    virtual void add_variable_to_current_scope(const tree::One<semantic::Variable>& variable);
+    [[nodiscard]] virtual values::Value try_resolve_variable(const primitives::Symbol& name) const;
 
     /**
      * Resolves a variable.
      * Throws NameResolutionFailure if no variable by the given name exists.
      */
-    [[nodiscard]] virtual values::Value resolve_variable(const std::string& name) const;
+    [[nodiscard]] virtual values::Value resolve_variable(const primitives::Symbol& name) const;
 
     /**
-     * Registers a variable.
+     * Registers a variable in the current scope, e.g. a constant, which is then visible to the analyzed programs.
+     * The variables declared by an analyzed program are registered by the SemanticAnalyzer analyzing it instead,
+     * so they are not registered through this method.
      */
-    virtual void register_variable(const std::string& name, const values::Value& value);
+    virtual void register_variable(const primitives::Symbol& name, const values::Value& value);
 
     /**
      * Resolves a function.
@@ -168,6 +254,22 @@ public:
     virtual void register_consteval_core_function(
         const std::string& name, const std::string& param_types, const resolver::ConstEvalCoreFunction& function);
 
+    /**
+     * Resolves a GateInstruction, looking it up from the innermost to the outermost scope.
+     * Returns empty if no instruction by the given name exists, or if no overload exists for the given arguments,
+     * otherwise returns the resolved instruction node.
+     */
+    [[nodiscard]] tree::One<semantic::Instruction> try_resolve_instruction(
+        const std::string& name, const tree::One<semantic::Gate>& gate, const values::Values& args) const;
+
+    /**
+     * Resolves a NonGateInstruction, looking it up from the innermost to the outermost scope.
+     * Returns empty if no instruction by the given name exists, or if no overload exists for the given arguments,
+     * otherwise returns the resolved instruction node.
+     */
+    [[nodiscard]] virtual tree::One<semantic::Instruction> try_resolve_instruction(
+        const std::string& name, const values::Values& args) const;
+
     /**
      * Resolves a GateInstruction.
      * Throws NameResolutionFailure if no instruction by the given name exists,
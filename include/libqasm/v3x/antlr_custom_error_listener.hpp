@@ -5,6 +5,9 @@
 #include <exception>
 #include <optional>
 #include <string>
+#include <vector>
+
+#include "libqasm/error.hpp"
 
 namespace cqasm::v3x::parser {
 
@@ -17,9 +20,64 @@ class AntlrCustomErrorListener : public antlr4::BaseErrorListener {
     void syntaxError(antlr4::Recognizer* recognizer, antlr4::Token* offending_symbol, size_t line,
         size_t char_position_in_line, const std::string& msg, std::exception_ptr e) override;
 
+protected:
+    /**
+     * Builds the error reported for an offending symbol, spanning the text of the symbol.
+     */
+    [[nodiscard]] error::ParseError make_error(
+        antlr4::Token* offending_symbol, size_t line, size_t char_position_in_line, const std::string& msg) const;
+
 public:
     explicit AntlrCustomErrorListener(const std::optional<std::string>& file_name);
+    void set_file_name(const std::optional<std::string>& file_name);
     void syntaxError(size_t line, size_t char_position_in_line, const std::string& msg);
 };
 
+/**
+ * Error listener used to recover from errors, which collects errors instead of throwing them.
+ * A cancelling collector, as used by a parser or a syntactic analyzer, throws an antlr4::ParseCancellationException
+ * after collecting an error, so that the statement being parsed is abandoned.
+ * A non-cancelling collector, as used by a lexer, lets the lexer skip the offending characters and carry on.
+ */
+class AntlrErrorCollector : public AntlrCustomErrorListener {
+public:
+    /**
+     * Collected error, together with the position it was found at, so that errors can be sorted in source order.
+     */
+    struct CollectedError {
+        size_t line;
+        size_t char_position_in_line;
+        error::ParseError error;
+    };
+
+private:
+    std::vector<CollectedError> errors_;
+    bool cancel_;
+
+    void syntaxError(antlr4::Recognizer* recognizer, antlr4::Token* offending_symbol, size_t line,
+        size_t char_position_in_line, const std::string& msg, std::exception_ptr e) override;
+
+public:
+    /**
+     * Errors are reported for the same file as the ones of the given error listener.
+     */
+    AntlrErrorCollector(const AntlrCustomErrorListener& error_listener, bool cancel);
+
+    /**
+     * Errors collected so far, in the order they were found.
+     */
+    [[nodiscard]] std::vector<CollectedError>& errors();
+};
+
+/**
+ * Error listener used while parsing with SLL prediction, or one statement at a time.
+ * Any error, either from the lexer or the parser, cancels the parse, so that it can be rerun in a slower mode,
+ * which reports the exact diagnostic.
+ */
+class BailErrorListener : public antlr4::BaseErrorListener {
+public:
+    void syntaxError(antlr4::Recognizer* recognizer, antlr4::Token* offending_symbol, size_t line,
+        size_t char_position_in_line, const std::string& msg, std::exception_ptr e) override;
+};
+
 }  // namespace cqasm::v3x::parser
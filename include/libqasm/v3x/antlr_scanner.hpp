@@ -1,20 +1,41 @@
 #pragma once
 
 #include <memory>  // unique_ptr
+#include <optional>
 #include <string>
+#include <string_view>
 
+#include "libqasm/v3x/parse_options.hpp"
 #include "libqasm/v3x/parse_result.hpp"
 #include "libqasm/v3x/syntactic_analyzer_base.hpp"
 
 namespace antlr4 {
-class ANTLRInputStream;
+class ANTLRErrorListener;
+class CharStream;
+class CommonTokenStream;
+class TokenSource;
 }
 namespace cqasm::v3x::parser {
 class AntlrCustomErrorListener;
+class AntlrErrorCollector;
 }
 
 namespace cqasm::v3x::parser {
 
+/**
+ * Creates a lexer of the given type over the input stream, reporting errors to the given listener.
+ */
+std::unique_ptr<antlr4::TokenSource> create_lexer(
+    antlr4::CharStream& is, antlr4::ANTLRErrorListener* error_listener, LexerType lexer_type);
+
+/**
+ * Parses a whole program with parse_statements_with_recovery,
+ * and returns the partial program together with all the errors.
+ */
+cqasm::v3x::parser::ParseResult parse_with_recovery(antlr4::CommonTokenStream& tokens,
+    AntlrErrorCollector& lexer_error_collector, BaseSyntacticAnalyzer& build_visitor,
+    AntlrCustomErrorListener& error_listener, ExpressionParserType expression_parser);
+
 struct ScannerAdaptor {
     virtual ~ScannerAdaptor();
 
@@ -24,39 +45,38 @@ struct ScannerAdaptor {
 class AntlrScanner : public ScannerAdaptor {
     std::unique_ptr<BaseSyntacticAnalyzer> build_visitor_up_;
     std::unique_ptr<AntlrCustomErrorListener> error_listener_up_;
+    ParseOptions options_;
+
+    cqasm::v3x::parser::ParseResult parse_tokens_(antlr4::CharStream& is, bool sll);
+    cqasm::v3x::parser::ParseResult parse_statement_by_statement_(antlr4::CharStream& is);
+    cqasm::v3x::parser::ParseResult parse_with_recovery_(antlr4::CharStream& is);
 
 protected:
-    cqasm::v3x::parser::ParseResult parse_(antlr4::ANTLRInputStream& is);
+    cqasm::v3x::parser::ParseResult parse_(antlr4::CharStream& is);
+    std::optional<cqasm::v3x::parser::ParseResult> parse_chunks_(std::string_view data);
 
 public:
     AntlrScanner(std::unique_ptr<BaseSyntacticAnalyzer> build_visitor_up,
-        std::unique_ptr<AntlrCustomErrorListener> error_listener_up);
+        std::unique_ptr<AntlrCustomErrorListener> error_listener_up, const ParseOptions& options = {});
 
     ~AntlrScanner() override;
 
     cqasm::v3x::parser::ParseResult parse() override = 0;
 };
 
-class FileAntlrScanner : public AntlrScanner {
-    std::string file_path_;
-
-public:
-    FileAntlrScanner(std::unique_ptr<BaseSyntacticAnalyzer> build_visitor_up,
-        std::unique_ptr<AntlrCustomErrorListener> error_listener_up, std::string file_path);
-
-    ~FileAntlrScanner() override;
-
-    cqasm::v3x::parser::ParseResult parse() override;
-};
-
-class StringAntlrScanner : public AntlrScanner {
-    std::string data_;
+/**
+ * Scanner over UTF-8 input owned by the caller, e.g. a string or a memory-mapped file.
+ * The input is read in place, through a Utf8CharStream, so it has to outlive the scanner.
+ */
+class StringViewAntlrScanner : public AntlrScanner {
+    std::string_view data_;
 
 public:
-    StringAntlrScanner(std::unique_ptr<BaseSyntacticAnalyzer> build_visitor_up,
-        std::unique_ptr<AntlrCustomErrorListener> error_listener_up, std::string data);
+    StringViewAntlrScanner(std::unique_ptr<BaseSyntacticAnalyzer> build_visitor_up,
+        std::unique_ptr<AntlrCustomErrorListener> error_listener_up, std::string_view data,
+        const ParseOptions& options = {});
 
-    ~StringAntlrScanner() override;
+    ~StringViewAntlrScanner() override;
 
     cqasm::v3x::parser::ParseResult parse() override;
 };
@@ -0,0 +1,167 @@
+/** \file
+ * Contains the functions used to split a cQASM v3 program into chunks at statement boundaries,
+ * and to parse those chunks concurrently.
+ */
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "libqasm/error.hpp"
+#include "libqasm/v3x/parse_options.hpp"
+#include "libqasm/v3x/syntactic.hpp"
+#include "libqasm/v3x/syntactic_analyzer_base.hpp"
+
+namespace antlr4 {
+class CommonTokenStream;
+}
+namespace cqasm::v3x::parser {
+class AntlrCustomErrorListener;
+class AntlrErrorCollector;
+}
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Minimum size in bytes of a chunk parsed by the parallel_chunks build mode.
+ * Smaller programs are parsed as a single chunk, as the cost of handing a chunk over to another thread
+ * would outweigh the gain.
+ */
+inline constexpr size_t min_chunk_size = 64 * 1024;
+
+/**
+ * Start of a chunk of a cQASM v3 program.
+ */
+struct ChunkStart {
+    /**
+     * Offset of the first byte of the chunk in the program.
+     */
+    size_t offset = 0;
+
+    /**
+     * Line of the first character of the chunk, one-based.
+     */
+    size_t line = 1;
+
+    /**
+     * Character position in line of the first character of the chunk, zero-based, and counted in code points,
+     * as the lexers do.
+     */
+    size_t char_position_in_line = 0;
+
+    bool operator==(const ChunkStart&) const = default;
+};
+
+/**
+ * Pre-scanner finding the new lines of UTF-8 data that are NEW_LINE tokens,
+ * i.e. that are not part of a comment or a raw text string.
+ * The data is scanned byte by byte, without being tokenized.
+ */
+class NewLineScanner {
+    /**
+     * Lexical context of the byte being scanned.
+     */
+    enum class State { code, single_line_comment, multi_line_comment, raw_text_string };
+
+    std::string_view data_;
+    size_t index_;
+    size_t line_;
+    size_t char_position_in_line_;
+    State state_ = State::code;
+
+public:
+    /**
+     * Starts scanning at the given position, which must not be part of a comment or a raw text string,
+     * e.g. the start of a chunk.
+     */
+    NewLineScanner(std::string_view data, const ChunkStart& start);
+
+    /**
+     * Returns the start of the next NEW_LINE token, i.e. of the next '\n' or '\r\n' new line,
+     * or an empty optional at the end of the data.
+     */
+    std::optional<ChunkStart> next();
+};
+
+/**
+ * Version and global block statements parsed from a chunk.
+ * Only the first chunk of a program has a version.
+ */
+struct ParsedChunk {
+    syntactic::One<syntactic::Version> version;
+    syntactic::Any<syntactic::Statement> statements;
+};
+
+/**
+ * Chunk parsed while recovering from errors, together with all its errors, in source order.
+ * The statements containing an error are left out of the parsed chunk.
+ */
+struct RecoveredChunk {
+    ParsedChunk parsed_chunk;
+    error::ParseErrors errors;
+
+    /**
+     * Whether an error was found at the end of the chunk, e.g. in a statement or a version section cut off by it,
+     * which may not be an error in the whole program.
+     */
+    bool has_error_at_end = false;
+};
+
+/**
+ * Splits UTF-8 data into at most max_number_of_chunks chunks of at least min_size bytes each.
+ *
+ * The data is pre-scanned once by a NewLineScanner.
+ * Chunks only start at a new line that is not part of a comment or a raw text string, i.e. at a NEW_LINE token,
+ * so every chunk but the first one consists of statement separators followed by global block statements.
+ * The first chunk always starts at offset 0, and is the only chunk if the data is too small to be split.
+ */
+std::vector<ChunkStart> find_chunk_starts(std::string_view data, size_t max_number_of_chunks, size_t min_size);
+
+/**
+ * Parses a chunk one statement at a time, preceded by the version section if it is the first chunk of a program.
+ * Tokens are positioned from the start of the chunk.
+ * Parsing stops at the first lexer or parser error,
+ * and throws either an antlr4::ParseCancellationException, or a ParseError for a value out of range.
+ */
+ParsedChunk parse_chunk(std::string_view data, const ChunkStart& chunk_start, bool is_first_chunk,
+    BaseSyntacticAnalyzer& builder_visitor, const ParseOptions& options);
+
+/**
+ * Parses a chunk one statement at a time, as parse_chunk does, but recovering from errors,
+ * as the recover_from_errors option does.
+ * A statement containing an error is skipped up to the next statement separator, and left out of the chunk.
+ * Errors are reported for the same file as the ones of the given error listener,
+ * which is the error listener of the builder visitor again on return.
+ */
+RecoveredChunk parse_chunk_with_recovery(std::string_view data, const ChunkStart& chunk_start, bool is_first_chunk,
+    BaseSyntacticAnalyzer& builder_visitor, AntlrCustomErrorListener& error_listener, const ParseOptions& options);
+
+/**
+ * Parses tokens one statement at a time, recovering from errors, as parse_chunk_with_recovery does.
+ * The lexer of the token stream has to report its errors to the given lexer error collector.
+ */
+RecoveredChunk parse_statements_with_recovery(antlr4::CommonTokenStream& tokens,
+    AntlrErrorCollector& lexer_error_collector, bool is_first_chunk, BaseSyntacticAnalyzer& builder_visitor,
+    AntlrCustomErrorListener& error_listener, ExpressionParserType expression_parser);
+
+/**
+ * Parses the chunks of a program concurrently, one statement at a time,
+ * and stitches their statements, in order, into the global block of one program.
+ * The first chunk contains the version section.
+ * Tokens are positioned from the start of their chunk, so source locations are the same as for the whole program.
+ *
+ * Parsing stops at the first lexer or parser error of any chunk,
+ * and throws either an antlr4::ParseCancellationException, or a ParseError for a value out of range.
+ * Errors are not reported in program order, so callers should parse the whole program again to report them.
+ *
+ * The chunks but the first one are parsed by a process-wide pool of threads, started on first use.
+ * The builder visitor is shared by all the chunks, and used by many threads at the same time,
+ * so visiting must be thread-safe, as it is for BaseSyntacticAnalyzer.
+ */
+syntactic::One<syntactic::Program> parse_chunks(std::string_view data, const std::vector<ChunkStart>& chunk_starts,
+    BaseSyntacticAnalyzer& builder_visitor, const ParseOptions& options);
+
+}  // namespace cqasm::v3x::parser
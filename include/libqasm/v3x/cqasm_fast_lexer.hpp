@@ -0,0 +1,133 @@
+/** \file
+ * Contains a hand-written, table-driven lexer for cQASM v3,
+ * to be used as a faster alternative to the ANTLR-generated CqasmLexer.
+ */
+
+#pragma once
+
+#include <antlr4-runtime.h>
+
+#include <cstddef>  // size_t
+#include <memory>  // unique_ptr
+#include <string>
+#include <utility>  // pair
+#include <vector>
+
+namespace cqasm::v3x::parser {
+
+class Utf8CharStream;
+
+/**
+ * Hand-written lexer for cQASM v3.
+ *
+ * It is a drop-in replacement for the ANTLR-generated CqasmLexer:
+ * it emits the same token types (including the ones of the VERSION_STATEMENT mode),
+ * with the same start and stop indices, lines, and columns,
+ * and reports the same token recognition errors.
+ * Instead of simulating the lexer ATN, it dispatches on the first character of each token through a lookup table,
+ * and then matches the rest of the token with a small amount of lookahead.
+ * Raw text strings read from a Utf8CharStream are matched by searching the input bytes for the closing triple quote,
+ * so large asm declaration bodies are not read one code point at a time.
+ */
+class CqasmFastLexer : public antlr4::TokenSource {
+    /**
+     * Input stream being tokenized.
+     */
+    antlr4::CharStream* input_;
+
+    /**
+     * Input stream, if it is a Utf8CharStream, or nullptr otherwise.
+     */
+    Utf8CharStream* utf8_input_;
+
+    /**
+     * Token source and input stream pair, as required by the token factory.
+     */
+    std::pair<antlr4::TokenSource*, antlr4::CharStream*> token_factory_source_pair_;
+
+    /**
+     * Factory used to create the tokens.
+     */
+    antlr4::TokenFactory<antlr4::CommonToken>* factory_;
+
+    /**
+     * Listeners notified of token recognition errors.
+     */
+    std::vector<antlr4::ANTLRErrorListener*> error_listeners_;
+
+    /**
+     * Current line, one-based.
+     */
+    size_t line_ = 1;
+
+    /**
+     * Current character position in line, zero-based.
+     */
+    size_t char_position_in_line_ = 0;
+
+    /**
+     * Whether the lexer is in the VERSION_STATEMENT mode.
+     * The mode stack of CqasmLexer is never deeper than one, so a flag is enough to represent it.
+     */
+    bool version_statement_mode_ = false;
+
+    /**
+     * Start index, line, and character position in line of the token being matched.
+     */
+    size_t token_start_char_index_ = 0;
+    size_t token_start_line_ = 1;
+    size_t token_start_char_position_in_line_ = 0;
+
+    void consume();
+    void consume_digits();
+    void consume_exponent();
+    void restore(size_t index, size_t line, size_t char_position_in_line);
+
+    size_t match_default_mode();
+    size_t match_version_statement_mode();
+    size_t match_carriage_return();
+    size_t match_slash();
+    size_t match_quote();
+    size_t match_raw_text_string(size_t index);
+    size_t match_dot();
+    size_t match_number();
+    size_t match_identifier();
+    size_t recognition_error();
+
+    std::unique_ptr<antlr4::Token> emit(size_t type);
+
+public:
+    explicit CqasmFastLexer(antlr4::CharStream* input);
+    ~CqasmFastLexer() override;
+
+    CqasmFastLexer(const CqasmFastLexer&) = delete;
+    CqasmFastLexer& operator=(const CqasmFastLexer&) = delete;
+
+    /**
+     * Restarts tokenizing from the beginning of the input stream, as antlr4::Lexer::reset does.
+     */
+    void reset();
+
+    /**
+     * Sets the current line and character position in line, as antlr4::Lexer::setLine and setCharPositionInLine do,
+     * e.g. to tokenize a part of a program with the positions it has within the whole program.
+     */
+    void setLine(size_t line);
+    void setCharPositionInLine(size_t char_position_in_line);
+
+    std::unique_ptr<antlr4::Token> nextToken() override;
+    [[nodiscard]] size_t getLine() const override;
+    size_t getCharPositionInLine() override;
+    antlr4::CharStream* getInputStream() override;
+    std::string getSourceName() override;
+    antlr4::TokenFactory<antlr4::CommonToken>* getTokenFactory() override;
+
+    /**
+     * Error listener management, mirroring the one of antlr4::Recognizer.
+     * A new lexer reports to the antlr4::ConsoleErrorListener, as the ANTLR-generated lexer does.
+     */
+    void addErrorListener(antlr4::ANTLRErrorListener* listener);
+    void removeErrorListeners();
+};
+
+}  // namespace cqasm::v3x::parser
@@ -10,6 +10,7 @@
 // We don't want SWIG to generate Python wrappers for the entire world.
 // Those headers are only included in the source file that provides the implementations.
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -18,6 +19,9 @@
 namespace cqasm::v3x::analyzer {
 class Analyzer;
 }
+namespace cqasm::v3x::parser {
+class ParserSession;
+}
 
 /**
  * Main class for parsing and analyzing cQASM v3.0 files.
@@ -74,6 +78,18 @@ class V3xAnalyzer {
      */
     std::unique_ptr<cqasm::v3x::analyzer::Analyzer> analyzer;
 
+    /**
+     * Parser session reused by the analyze_string methods, so that they do not set up a new parser on every call.
+     */
+    std::unique_ptr<cqasm::v3x::parser::ParserSession> parser_session;
+
+    /**
+     * Guards the parser session, which is not thread-safe,
+     * so that the const analyze_string methods can be called by many threads at the same time.
+     * Only parsing is serialized, the analysis itself runs concurrently.
+     */
+    mutable std::mutex parser_session_mutex;
+
 public:
     /**
      * Creates a new cQASM v3.0 semantic analyzer.
@@ -0,0 +1,73 @@
+/** \file
+ * Contains the ExpressionParser class, a hand-written precedence climbing parser for cQASM v3 expressions.
+ */
+
+#pragma once
+
+#include <antlr4-runtime.h>
+
+#include <cstddef>  // size_t
+#include <exception>
+
+#include "libqasm/v3x/syntactic.hpp"
+#include "libqasm/v3x/syntactic_analyzer_base.hpp"
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Thrown by the ExpressionParser when the input does not match what it expects.
+ * The input is not necessarily wrong, it may just have to be parsed by CqasmParser.
+ */
+class ExpressionParserMismatch : public std::exception {
+public:
+    [[nodiscard]] const char* what() const noexcept override;
+};
+
+/**
+ * Hand-written parser for the expression rule of CqasmParser.g4.
+ *
+ * It reads the tokens straight from a token stream,
+ * and builds the same syntactic nodes, with the same annotations, as visiting a CqasmParser parse tree would.
+ * No parse tree is created, and no ATN prediction is needed:
+ * binary operators are parsed by precedence climbing, with the precedences and associativities
+ * ANTLR derives from the order and the assoc options of the alternatives of the left-recursive expression rule.
+ *
+ * Whenever the next token is not the one it expects, the parser throws an ExpressionParserMismatch,
+ * leaving the token stream at an unspecified position.
+ * Callers should then seek back to where they started, and parse the input with CqasmParser,
+ * which will either accept it or report the syntax error.
+ */
+class ExpressionParser {
+    antlr4::TokenStream& tokens_;
+    const BaseSyntacticAnalyzer& builder_visitor_;
+
+    syntactic::One<syntactic::Expression> parse_expression(size_t precedence);
+    syntactic::One<syntactic::Expression> parse_primary_expression();
+    syntactic::One<syntactic::Expression> parse_identifier_expression();
+    syntactic::One<syntactic::IndexList> parse_index_list();
+
+public:
+    /**
+     * Both the token stream and the builder visitor have to outlive the expression parser.
+     * The builder visitor is used to decode the literals and to annotate the nodes.
+     */
+    ExpressionParser(antlr4::TokenStream& tokens, const BaseSyntacticAnalyzer& builder_visitor);
+
+    /**
+     * Consumes the next token if it is of the given type, and returns it.
+     * Throws an ExpressionParserMismatch otherwise.
+     */
+    antlr4::Token* match(size_t token_type);
+
+    /**
+     * expression: ...;
+     */
+    syntactic::One<syntactic::Expression> parse_expression();
+
+    /**
+     * expressionList: expression (COMMA expression)*;
+     */
+    syntactic::One<syntactic::ExpressionList> parse_expression_list();
+};
+
+}  // namespace cqasm::v3x::parser
@@ -0,0 +1,158 @@
+/** \file
+ * Contains the IncrementalParser class, used to parse a cQASM v3 document again after each edit.
+ */
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <memory>  // unique_ptr
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "libqasm/error.hpp"
+#include "libqasm/v3x/chunked_parser.hpp"
+#include "libqasm/v3x/parse_options.hpp"
+#include "libqasm/v3x/parse_result.hpp"
+#include "libqasm/v3x/syntactic.hpp"
+
+namespace cqasm::v3x::parser {
+class AntlrCustomErrorListener;
+class SyntacticAnalyzer;
+}
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Replacement of a range of bytes of a document.
+ */
+struct TextEdit {
+    /**
+     * Offset of the first byte replaced.
+     */
+    size_t offset = 0;
+
+    /**
+     * Number of bytes replaced, zero for an insertion.
+     */
+    size_t length = 0;
+
+    /**
+     * Replacement text, empty for a deletion.
+     */
+    std::string text;
+};
+
+/**
+ * Parser of a document being edited, e.g. in an editor, that only parses again the statements affected by each edit.
+ *
+ * The document is split into segments of about segment_size bytes, at NEW_LINE tokens,
+ * and each segment is parsed on its own, as in the parallel_chunks build mode.
+ * After an edit, the document is only scanned and parsed again from the segment the edit starts in,
+ * up to the first segment after the edit whose start is found again by the scan,
+ * as the rest of the document has not changed.
+ * The statements of the following segments are reused, and only the start of each segment is moved,
+ * so the cost of an edit does not grow with the size of the document, apart from a constant cost per segment.
+ * The program of the result is updated in place, by replacing the statements of the segments parsed again.
+ * The lines of the source locations of the reused statements are shifted lazily, by result(),
+ * so parse results are the same as the ones of parse_string for the whole document.
+ *
+ * Errors are reported as with the recover_from_errors option, whatever the options:
+ * a segment containing an error is parsed again recovering from errors,
+ * so that the result holds all the errors of the document, together with the statements without errors.
+ * The document is only parsed again as a whole by parse_string, with the recover_from_errors option,
+ * if an error is found at the end of a segment, as it may be caused by the following segment,
+ * e.g. for a version section after the end of the first segment.
+ * The segments containing an error are parsed again after the next edit.
+ */
+class IncrementalParser {
+    /**
+     * Part of the document, starting at a NEW_LINE token, or at the start of the document,
+     * together with the global block statements parsed from it.
+     */
+    struct Segment {
+        ChunkStart start;
+
+        /**
+         * Line of the start of the segment for which the source locations of its statements were computed.
+         * It differs from the line of the start after an edit adds or removes lines before the segment,
+         * until the source locations are shifted by result().
+         */
+        size_t annotated_line = 1;
+
+        syntactic::Any<syntactic::Statement> statements;
+        error::ParseErrors errors;
+        bool has_error_at_end = false;
+    };
+
+    std::string data_;
+    std::optional<std::string> file_name_;
+    ParseOptions options_;
+    std::unique_ptr<SyntacticAnalyzer> builder_visitor_up_;
+    std::unique_ptr<AntlrCustomErrorListener> error_listener_up_;
+    syntactic::One<syntactic::Version> version_;
+    std::vector<Segment> segments_;
+    size_t segments_with_errors_ = 0;
+    size_t segments_with_error_at_end_ = 0;
+
+    /**
+     * Whether the program of the result is stitched from the statements of the segments,
+     * rather than parsed again as a whole.
+     */
+    bool result_is_stitched_ = false;
+    ParseResult result_;
+
+    [[nodiscard]] size_t find_segment_(size_t offset) const;
+    [[nodiscard]] size_t find_first_statement_(size_t segment_index) const;
+    void forget_errors_(Segment& segment);
+    void parse_segment_(size_t index);
+    void update_result_(size_t first, size_t number_of_segments, size_t statement_index,
+        size_t number_of_removed_statements);
+
+public:
+    /**
+     * Approximate size in bytes of the segments the document is split into.
+     */
+    static constexpr size_t segment_size = 4 * 1024;
+
+    /**
+     * Parses the whole document.
+     * A file_name may be given in addition for use within error messages.
+     */
+    IncrementalParser(std::string data, const std::optional<std::string>& file_name, const ParseOptions& options = {});
+    ~IncrementalParser();
+
+    IncrementalParser(const IncrementalParser&) = delete;
+    IncrementalParser& operator=(const IncrementalParser&) = delete;
+
+    /**
+     * Current contents of the document.
+     */
+    [[nodiscard]] const std::string& data() const;
+
+    /**
+     * Parse result of the current contents of the document.
+     * Shifts the lines of the source locations of the statements moved by the edits since the last call,
+     * so its cost grows with the number of statements after the edits that added or removed lines.
+     */
+    [[nodiscard]] const ParseResult& result();
+
+    /**
+     * Errors of the current contents of the document, the same as the ones of result(),
+     * without shifting the source locations of the statements.
+     */
+    [[nodiscard]] const error::ParseErrors& errors() const;
+
+    /**
+     * Applies an edit to the document, and parses it again.
+     * Returns the errors of the edited document.
+     * Throws a std::invalid_argument if the edit is out of the range of the document.
+     *
+     * The result is updated in place, and the statements after the edit are shared with the results returned before,
+     * with their source locations shifted in place, so an earlier result is only valid until the next edit.
+     * An earlier result that is still needed after an edit should be cloned beforehand.
+     */
+    const error::ParseErrors& apply_edit(const TextEdit& edit);
+};
+
+}  // namespace cqasm::v3x::parser
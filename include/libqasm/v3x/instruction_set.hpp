@@ -1,10 +1,16 @@
 #pragma once
 
+#include <cstdint>  // uint8_t, uint16_t
+#include <limits>  // numeric_limits
 #include <map>
 #include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>  // pair
+#include <vector>
+
+#include "libqasm/v3x/primitives.hpp"
 
 namespace cqasm::v3x::instruction {
 
@@ -17,6 +23,74 @@ using InstructionMapT = std::multimap<KeyT, ValueT>;
 using InstructionListT = std::set<InstructionNameT>;
 using GateModifierMapT = std::map<KeyT, ParamTypesT>;
 
+/**
+ * Opcode of a named gate, gate composition, non-gate instruction, or gate modifier of the instruction set.
+ * Opcodes are indices into the opcode catalog, assigned when the instruction set is built.
+ */
+enum class Opcode : std::uint16_t { none = std::numeric_limits<std::uint16_t>::max() };
+
+enum class InstructionKind : std::uint8_t {
+    single_qubit_named_gate,
+    two_qubit_named_gate,
+    single_qubit_gate_composition,
+    two_qubit_gate_composition,
+    non_gate,
+    gate_modifier
+};
+
+enum class GateModifierKind : std::uint8_t { none, inv, pow, ctrl };
+
+/**
+ * Metadata of an opcode.
+ * Gate compositions are named after the named gate they are applied to,
+ * with a single-qubit or two-qubit gate composition prefix, e.g. "1q_X" for inv.X, or "2q_X" for ctrl.X.
+ */
+struct OpcodeInfo {
+    std::string name;
+    InstructionKind kind{};
+    GateModifierKind modifier_kind = GateModifierKind::none;
+
+    /**
+     * Number of qubit operands of a gate or gate composition, or 0 for other instructions.
+     */
+    std::uint8_t arity = 0;
+
+    /**
+     * Parameter type codes of every overload, e.g. "f" for Rx.
+     * Gates, gate compositions and gate modifiers have a single one.
+     */
+    std::vector<ParamTypesT> param_types;
+
+    /**
+     * Operand type codes of every overload, in the order in which they are registered.
+     */
+    std::vector<OperandTypesT> operand_types;
+
+    /**
+     * For a single-qubit named gate, the opcodes of its single-qubit and two-qubit gate compositions.
+     */
+    Opcode single_qubit_gate_composition = Opcode::none;
+    Opcode two_qubit_gate_composition = Opcode::none;
+
+    /**
+     * For a gate composition, the opcode of the named gate it is applied to.
+     */
+    Opcode named_gate = Opcode::none;
+
+    [[nodiscard]] bool is_single_qubit_gate() const {
+        return kind == InstructionKind::single_qubit_named_gate ||
+            kind == InstructionKind::single_qubit_gate_composition;
+    }
+    [[nodiscard]] bool is_two_qubit_gate() const {
+        return kind == InstructionKind::two_qubit_named_gate || kind == InstructionKind::two_qubit_gate_composition;
+    }
+    [[nodiscard]] bool is_single_qubit_gate_modifier() const {
+        return modifier_kind == GateModifierKind::inv || modifier_kind == GateModifierKind::pow;
+    }
+};
+
+using OpcodeCatalogT = std::vector<OpcodeInfo>;
+
 class InstructionSet {
     InstructionMapT named_gate_map;
     InstructionMapT non_gate_map;
@@ -26,8 +100,15 @@ class InstructionSet {
     InstructionListT two_qubit_named_gate_list;
     InstructionListT non_gate_list;
 
+    OpcodeCatalogT opcode_catalog;
+    std::unordered_map<primitives::Symbol, Opcode> opcodes;
+    Opcode measure_opcode = Opcode::none;
+
     InstructionSet();
 
+    Opcode add_opcode(OpcodeInfo info);
+    void build_opcode_catalog();
+
 public:
     // The use of '1q' and '2q' as gate prefixes avoids any possible conflict with user defined gates
     // since an identifier cannot start with a number
@@ -86,6 +167,27 @@ public:
     [[nodiscard]] std::optional<std::string> get_instruction_param_types(const std::string& name) const;
     [[nodiscard]] std::optional<std::string> get_non_gate_param_types_with_param_count(
         const std::string& name, size_t param_count) const;
+
+    /**
+     * The opcode catalog, in the order in which the instructions are registered:
+     * named gates, single-qubit gate compositions, two-qubit gate compositions, non-gate instructions,
+     * and finally gate modifiers.
+     */
+    [[nodiscard]] const OpcodeCatalogT& get_opcode_catalog() const;
+
+    /**
+     * Returns the opcode of the given name, or Opcode::none if the name is not part of the instruction set.
+     */
+    [[nodiscard]] Opcode get_opcode(const primitives::Symbol& name) const;
+
+    /**
+     * Returns the metadata of the given opcode, which must not be Opcode::none.
+     */
+    [[nodiscard]] const OpcodeInfo& get_opcode_info(Opcode opcode) const;
+
+    [[nodiscard]] bool is_measure(Opcode opcode) const;
+    [[nodiscard]] std::optional<std::string> get_non_gate_param_types_with_param_count(
+        Opcode opcode, size_t param_count) const;
 };
 
 }  // namespace cqasm::v3x::instruction
@@ -9,10 +9,14 @@
 #include <memory>  // unique_ptr
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "libqasm/annotations.hpp"
+#include "libqasm/memory_mapped_file.hpp"
 #include "libqasm/v3x/antlr_scanner.hpp"
+#include "libqasm/v3x/parse_options.hpp"
 #include "libqasm/v3x/parse_result.hpp"
+#include "libqasm/v3x/result_cache.hpp"
 
 namespace cqasm::v3x::parser {
 
@@ -20,15 +24,38 @@ using SourceLocation = annotations::SourceLocation;
 
 /**
  * Parse using the given file path.
+ * The file is memory-mapped, and parsed in place, as with the MemoryMappedFile overload.
  * Throws a ParseError if this fails.
+ * Parsing can be configured via the options, e.g. to use a different lexer.
  */
-ParseResult parse_file(const std::string& file_path, const std::optional<std::string>& file_name);
+ParseResult parse_file(
+    const std::string& file_path, const std::optional<std::string>& file_name, const ParseOptions& options = {});
+
+/**
+ * Parse the contents of the given memory-mapped file.
+ * The contents are read in place, without being copied or transcoded to UTF-32,
+ * so memory usage does not grow with the size of the file.
+ * A file_name may be given in addition for use within error messages.
+ * Parsing can be configured via the options, e.g. to use a different lexer.
+ */
+ParseResult parse_file(
+    const MemoryMappedFile& file, const std::optional<std::string>& file_name, const ParseOptions& options = {});
 
 /**
  * Parse the given string.
+ * The data is read in place, without being copied or transcoded to UTF-32.
  * A file_name may be given in addition for use within error messages.
+ * Parsing can be configured via the options, e.g. to use a different lexer.
+ */
+ParseResult parse_string(
+    std::string_view data, const std::optional<std::string>& file_name, const ParseOptions& options = {});
+
+/**
+ * Parse the given string, or return the result cached for the same string, file name, and options.
+ * The result is shared with the cache, and with any other caller parsing the same string, so it must not be modified.
  */
-ParseResult parse_string(const std::string& data, const std::optional<std::string>& file_name);
+std::shared_ptr<const ParseResult> parse_string(std::string_view data, const std::optional<std::string>& file_name,
+    ParseResultCache& cache, const ParseOptions& options = {});
 
 /**
  * Internal helper class for parsing cQASM files.
@@ -44,8 +71,14 @@ class ParseHelper {
      */
     std::string file_name_;
 
+    /**
+     * How the nodes of the syntactic AST are allocated.
+     */
+    AllocationMode allocation_mode_;
+
 public:
-    explicit ParseHelper(std::unique_ptr<ScannerAdaptor> scanner_up, const std::optional<std::string>& file_name);
+    explicit ParseHelper(std::unique_ptr<ScannerAdaptor> scanner_up, const std::optional<std::string>& file_name,
+        AllocationMode allocation_mode = AllocationMode::heap);
 
     /**
      * Does the actual parsing.
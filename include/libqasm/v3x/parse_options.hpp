@@ -0,0 +1,177 @@
+/** \file
+ * Contains the ParseOptions struct, used to configure how the v3x scanner tokenizes and parses its input.
+ */
+
+#pragma once
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Lexer used by the scanner to tokenize the input.
+ */
+enum class LexerType {
+    /**
+     * ANTLR-generated lexer, built from CqasmLexer.g4.
+     */
+    antlr,
+
+    /**
+     * Hand-written, table-driven lexer.
+     * It emits exactly the same tokens as the ANTLR-generated lexer, without running an ATN simulation.
+     */
+    hand_written
+};
+
+/**
+ * Prediction strategy used by the parser.
+ */
+enum class PredictionStrategy {
+    /**
+     * Full LL prediction, ANTLR's default.
+     */
+    ll,
+
+    /**
+     * Parse with the faster SLL prediction first, bailing out at the first syntax error,
+     * and only reparse with full LL prediction if that fails.
+     * Syntax errors are always reported by the full LL parse, so they are the same as with ll.
+     */
+    sll_then_ll
+};
+
+/**
+ * How the syntactic AST is built from the input.
+ */
+enum class BuildMode {
+    /**
+     * Build the ANTLR parse tree of the whole program, and then visit it to build the syntactic AST.
+     */
+    parse_tree,
+
+    /**
+     * Parse one statement at a time, building its syntactic node and releasing its parse tree straight away.
+     * The parse tree of the whole program is never held in memory.
+     * If the program contains an error, it is parsed again in the parse_tree mode, so errors are the same.
+     */
+    statement_by_statement,
+
+    /**
+     * Split the program into chunks at statement boundaries, one per hardware thread,
+     * parse the chunks concurrently, statement by statement, and stitch their statements into one global block.
+     * Source locations are the same as in the parse_tree mode.
+     * If the program contains an error, it is parsed again in the parse_tree mode, so errors are the same.
+     * Programs smaller than two chunks of min_chunk_size bytes are parsed as a single chunk.
+     */
+    parallel_chunks
+};
+
+/**
+ * Parser used for the expressions of the instructions.
+ */
+enum class ExpressionParserType {
+    /**
+     * ANTLR-generated parser, as part of the rules that contain the expressions.
+     */
+    antlr,
+
+    /**
+     * Hand-written precedence climbing parser.
+     * It is only used for gate and non-gate instructions,
+     * in the statement_by_statement and parallel_chunks build modes, and by StatementStream.
+     * Other statements, and instructions it cannot parse on its own, are still parsed by the ANTLR-generated parser.
+     */
+    precedence_climbing
+};
+
+/**
+ * How the nodes of the syntactic AST are allocated.
+ */
+enum class AllocationMode {
+    /**
+     * Each node is allocated on its own from the heap, together with its reference count.
+     */
+    heap,
+
+    /**
+     * Nodes are allocated from an arena, which is owned by the parse result, so they are freed all at once.
+     * It is only used by parse_file and parse_string.
+     * In the parallel_chunks build mode, the nodes of every chunk but the first one
+     * are allocated from an arena of their own, as chunks are parsed concurrently.
+     */
+    arena
+};
+
+/**
+ * Which nodes of the syntactic AST are annotated with their source location.
+ */
+enum class SourceLocationMode {
+    /**
+     * Every node built from a token is annotated with its source location.
+     */
+    all_nodes,
+
+    /**
+     * Only statements and gates are annotated with their source location, which saves the time and memory
+     * of annotating every expression, identifier, literal, and type.
+     * Errors are then reported at the location of the statement or gate they are found in.
+     * Meant for programs that have already been validated, and whose errors are not shown to a user.
+     */
+    statements
+};
+
+/**
+ * Options for the scanner.
+ * Default constructed options reproduce the behaviour of the ANTLR-generated lexer and parser.
+ */
+struct ParseOptions {
+    /**
+     * Lexer used to tokenize the input.
+     */
+    LexerType lexer_type = LexerType::antlr;
+
+    /**
+     * Prediction strategy used by the parser.
+     */
+    PredictionStrategy prediction_strategy = PredictionStrategy::ll;
+
+    /**
+     * Whether to profile the parser decisions, and record the number of full-context predictions per rule.
+     * Profiling slows down parsing, so it should only be enabled for diagnostics.
+     */
+    bool profile_prediction = false;
+
+    /**
+     * How the syntactic AST is built from the input.
+     */
+    BuildMode build_mode = BuildMode::parse_tree;
+
+    /**
+     * Parser used for the expressions of the instructions.
+     */
+    ExpressionParserType expression_parser = ExpressionParserType::antlr;
+
+    /**
+     * Whether to recover from errors, so that all the syntax errors of a program are reported at once,
+     * instead of only the first one.
+     * The program is parsed one statement at a time, with full LL prediction.
+     * A statement containing an error is skipped up to the next statement separator,
+     * and parsing carries on with the next statement.
+     * The parse result then contains all the errors, in source order,
+     * together with a partial program, made up of the statements without errors.
+     * A parser error is not reported if a lexer error has been found in the same statement.
+     * The prediction_strategy and build_mode options are ignored in this mode.
+     */
+    bool recover_from_errors = false;
+
+    /**
+     * How the nodes of the syntactic AST are allocated.
+     */
+    AllocationMode allocation_mode = AllocationMode::heap;
+
+    /**
+     * Which nodes of the syntactic AST are annotated with their source location.
+     */
+    SourceLocationMode source_location_mode = SourceLocationMode::all_nodes;
+};
+
+}  // namespace cqasm::v3x::parser
@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include <memory>  // shared_ptr
 #include <string>
 #include <vector>
 
 #include "libqasm/annotations.hpp"
+#include "libqasm/arena.hpp"
 #include "libqasm/error.hpp"
 #include "libqasm/v3x/syntactic.hpp"
 
@@ -36,6 +38,12 @@ public:
      */
     error::ParseErrors errors;
 
+    /**
+     * Arena the nodes of the AST were allocated from, in the arena allocation mode, or nullptr otherwise.
+     * Nodes share the ownership of the arena, so it is only freed once the whole AST has been discarded.
+     */
+    std::shared_ptr<tree::Arena> arena = nullptr;
+
     /**
      * Returns a vector of strings, of which the first is reserved for the CBOR serialization of the v3.x syntactic AST.
      * Any additional strings represent error messages.
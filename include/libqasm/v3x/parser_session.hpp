@@ -0,0 +1,89 @@
+/** \file
+ * Contains the ParserSession class, used to parse many cQASM v3 programs with the same lexer and parser.
+ */
+
+#pragma once
+
+#include <memory>  // unique_ptr
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "libqasm/v3x/parse_options.hpp"
+#include "libqasm/v3x/parse_result.hpp"
+
+class CqasmParser;
+
+namespace antlr4 {
+class ANTLRErrorStrategy;
+class CommonTokenStream;
+class TokenSource;
+}
+namespace cqasm::v3x::parser {
+class AntlrCustomErrorListener;
+class BailErrorListener;
+class SyntacticAnalyzer;
+class Utf8CharStream;
+}
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Reusable parsing state, to amortize the setup cost of parsing many small programs.
+ *
+ * Every call to parse_string or parse_file creates a new syntactic analyzer, error listener, lexer, token stream,
+ * and parser. A parser session creates them once, and resets them between inputs,
+ * so that their buffers, e.g. the token buffer of the token stream, are reused as well.
+ * Inputs are read in place through a Utf8CharStream, and parse results go through a ParseHelper,
+ * so they are the same as the ones of parse_string.
+ *
+ * A session builds the parse tree of the whole input, so the build_mode and expression_parser options,
+ * which are meant for large programs, are ignored.
+ * With the recover_from_errors option, inputs are parsed one statement at a time instead, using the expression_parser,
+ * as parse_string does, and all the errors are reported together with a partial program.
+ * A session is not thread-safe, each thread should use its own session.
+ */
+class ParserSession {
+    /**
+     * Scanner adaptor parsing the current input of the session, as used by ParseHelper.
+     */
+    class Scanner;
+
+    ParseOptions options_;
+    std::unique_ptr<SyntacticAnalyzer> builder_visitor_up_;
+    std::unique_ptr<AntlrCustomErrorListener> error_listener_up_;
+    std::unique_ptr<BailErrorListener> bail_error_listener_up_;
+    std::shared_ptr<antlr4::ANTLRErrorStrategy> default_error_strategy_;
+    std::shared_ptr<antlr4::ANTLRErrorStrategy> bail_error_strategy_;
+    std::unique_ptr<Utf8CharStream> char_stream_up_;
+    std::unique_ptr<antlr4::TokenSource> lexer_up_;
+    std::unique_ptr<antlr4::CommonTokenStream> tokens_up_;
+    std::unique_ptr<CqasmParser> parser_up_;
+
+    ParseResult parse_();
+    ParseResult parse_with_recovery_();
+    ParseResult parse_tokens_(bool sll);
+
+public:
+    explicit ParserSession(const ParseOptions& options = {});
+    ~ParserSession();
+
+    ParserSession(const ParserSession&) = delete;
+    ParserSession& operator=(const ParserSession&) = delete;
+
+    /**
+     * Parse the given string.
+     * The data is read in place, and is not referenced anymore once parsing has finished.
+     * A file_name may be given in addition for use within error messages.
+     */
+    ParseResult parse_string(std::string_view data, const std::optional<std::string>& file_name);
+
+    /**
+     * Parse the file at the given path, through a MemoryMappedFile.
+     * Throws a ParseError if the file cannot be accessed.
+     * A file_name may be given in addition for use within error messages.
+     */
+    ParseResult parse_file(const std::string& file_path, const std::optional<std::string>& file_name);
+};
+
+}  // namespace cqasm::v3x::parser
@@ -0,0 +1,78 @@
+/** \file
+ * Contains counters about the prediction strategy used by the v3x parser.
+ */
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace antlr4 {
+class Parser;
+}
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Snapshot of the prediction counters.
+ */
+struct PredictionStatistics {
+    /**
+     * Number of parses attempted with SLL prediction.
+     */
+    size_t sll_parses = 0;
+
+    /**
+     * Number of SLL parses that failed and were rerun with full LL prediction.
+     */
+    size_t ll_fallbacks = 0;
+
+    /**
+     * Number of predictions, i.e. of decisions made by adaptive prediction, per parser rule name.
+     * Decisions made by a single token of lookahead are not predictions.
+     * Only recorded for parses with profiling enabled.
+     */
+    std::map<std::string, size_t> predictions_per_rule;
+
+    /**
+     * Number of full-context predictions, i.e. decisions where SLL prediction found a conflict,
+     * and full LL prediction had to be run.
+     * Only recorded for parses with profiling enabled.
+     */
+    size_t full_context_predictions = 0;
+
+    /**
+     * Number of full-context predictions, per parser rule name.
+     */
+    std::map<std::string, size_t> full_context_predictions_per_rule;
+};
+
+/**
+ * Process-wide prediction counters, updated by every parse.
+ */
+class PredictionTelemetry {
+    mutable std::mutex mutex_;
+    PredictionStatistics statistics_;
+
+    PredictionTelemetry() = default;
+
+public:
+    [[nodiscard]] static PredictionTelemetry& get_instance();
+
+    void record_sll_parse();
+    void record_ll_fallback();
+    void record_full_context_predictions(const std::string& rule_name, size_t count);
+
+    /**
+     * Records the number of predictions and of full-context predictions of each parser rule,
+     * as gathered by the parser profiler.
+     */
+    void record_predictions(antlr4::Parser& parser);
+
+    [[nodiscard]] PredictionStatistics get_statistics() const;
+    void reset();
+};
+
+}  // namespace cqasm::v3x::parser
@@ -9,8 +9,13 @@
 
 #include <array>
 #include <complex>
+#include <cstddef>  // size_t
 #include <cstdint>
+#include <functional>  // hash
+#include <memory>  // shared_ptr
+#include <ostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "libqasm/tree.hpp"
@@ -53,6 +58,128 @@ void serialize(const Str& obj, ::tree::cbor::MapWriter& map);
 template <>
 Str deserialize(const ::tree::cbor::MapReader& map);
 
+/**
+ * Symbol primitive used within the AST and semantic trees for identifiers and names.
+ *
+ * Symbols are interned: every distinct text in use is stored only once, in a process-wide pool,
+ * together with its hash. A symbol is then just a reference-counted pointer to its pool entry,
+ * so copying a symbol does not copy its text, and comparing or hashing two symbols does not read their texts.
+ * An entry is kept alive by the symbols pointing to it, e.g. by the nodes of the trees holding them,
+ * and is freed together with the last of them, so the pool only holds the texts of the symbols in use.
+ * Views of the text of a symbol are valid as long as the symbol, or a copy of it, is alive.
+ * Interning is thread-safe.
+ * The empty text has a single, immortal entry outside of the pool,
+ * so creating, copying, and moving from empty symbols does not lock the pool nor count references.
+ */
+class Symbol {
+    struct Data;
+    struct Pool;
+    Data* data_;
+
+    static Pool& pool();
+    static Data* empty_data() noexcept;
+    static Data* intern(std::string_view text);
+    static void add_reference(Data* data) noexcept;
+    static bool try_add_reference(Data* data);
+    static void release(Data* data);
+
+public:
+    /**
+     * Creates an empty symbol.
+     */
+    Symbol() noexcept;
+    Symbol(const Symbol& other) noexcept;
+    Symbol(Symbol&& other) noexcept;
+    Symbol& operator=(const Symbol& other);
+    /**
+     * Takes over the entry of the other symbol, which is left empty.
+     */
+    Symbol& operator=(Symbol&& other) noexcept;
+    ~Symbol();
+
+    /**
+     * Creates the symbol for the given text, interning the text if it is not in the pool yet.
+     */
+    Symbol(std::string_view text);  // NOLINT(google-explicit-constructor)
+    Symbol(const std::string& text);  // NOLINT(google-explicit-constructor)
+    Symbol(const char* text);  // NOLINT(google-explicit-constructor)
+
+    /**
+     * Text of the symbol.
+     */
+    [[nodiscard]] const std::string& str() const;
+    operator const std::string&() const;  // NOLINT(google-explicit-constructor)
+
+    /**
+     * Hash of the text, computed only once, when the text was interned.
+     */
+    [[nodiscard]] size_t hash() const;
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool empty() const;
+
+    [[nodiscard]] bool operator==(const Symbol& rhs) const;
+    [[nodiscard]] bool operator==(const std::string& rhs) const;
+    [[nodiscard]] bool operator==(std::string_view rhs) const;
+    [[nodiscard]] bool operator==(const char* rhs) const;
+
+    /**
+     * Number of distinct texts in the pool of symbols, i.e. of the non-empty symbols in use.
+     */
+    [[nodiscard]] static size_t pool_size();
+};
+template <>
+void serialize(const Symbol& obj, ::tree::cbor::MapWriter& map);
+template <>
+Symbol deserialize(const ::tree::cbor::MapReader& map);
+
+/**
+ * Raw text primitive used within the AST and semantic trees, e.g. for the backend code of asm declarations.
+ *
+ * It refers to a span of a shared, immutable buffer, so copying it,
+ * e.g. from a syntactic to a semantic asm declaration, does not copy the text.
+ * A string with the text is only created on demand, by str().
+ */
+class RawText {
+    std::shared_ptr<const std::string> buffer_;
+    size_t offset_ = 0;
+    size_t size_ = 0;
+
+public:
+    RawText() = default;
+
+    /**
+     * Creates a raw text referring to size bytes of the buffer, starting at offset.
+     * Throws a std::out_of_range if the span is out of the range of the buffer.
+     */
+    RawText(std::shared_ptr<const std::string> buffer, size_t offset, size_t size);
+
+    /**
+     * Creates a raw text with a copy of the given text.
+     */
+    explicit RawText(std::string_view text);
+
+    /**
+     * View of the text, valid as long as this raw text, or a copy of it, is alive.
+     */
+    [[nodiscard]] std::string_view view() const;
+
+    /**
+     * Copy of the text.
+     */
+    [[nodiscard]] std::string str() const;
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool empty() const;
+
+    [[nodiscard]] bool operator==(const RawText& rhs) const;
+    [[nodiscard]] bool operator==(std::string_view rhs) const;
+};
+template <>
+void serialize(const RawText& obj, ::tree::cbor::MapWriter& map);
+template <>
+RawText deserialize(const ::tree::cbor::MapReader& map);
+
 /**
  * Axis primitive used within the semantic trees.
  */
@@ -121,6 +248,16 @@ void serialize(const Version& obj, ::tree::cbor::MapWriter& map);
 template <>
 Version deserialize(const ::tree::cbor::MapReader& map);
 
+/**
+ * Stream << overload for symbols.
+ */
+std::ostream& operator<<(std::ostream& os, const Symbol& symbol);
+
+/**
+ * Stream << overload for raw texts.
+ */
+std::ostream& operator<<(std::ostream& os, const RawText& raw_text);
+
 /**
  * Stream << overload for axis nodes.
  */
@@ -128,5 +265,17 @@ std::ostream& operator<<(std::ostream& os, const Axis& axis);
 
 }  // namespace cqasm::v3x::primitives
 
+template <>
+struct fmt::formatter<cqasm::v3x::primitives::Symbol> : fmt::ostream_formatter {};
+template <>
+struct fmt::formatter<cqasm::v3x::primitives::RawText> : fmt::ostream_formatter {};
 template <>
 struct fmt::formatter<cqasm::v3x::primitives::Axis> : fmt::ostream_formatter {};
+
+/**
+ * Hash of a symbol, which does not need to read its text.
+ */
+template <>
+struct std::hash<cqasm::v3x::primitives::Symbol> {
+    size_t operator()(const cqasm::v3x::primitives::Symbol& symbol) const noexcept { return symbol.hash(); }
+};
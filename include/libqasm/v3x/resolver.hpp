@@ -69,14 +69,14 @@ struct OverloadedNameResolver : public BaseOverladedNameResolver<T> {
     }
 
     [[nodiscard]] std::pair<T, Values> resolve(const std::string& name, const Values& args) override {
-        try {
-            return BaseOverladedNameResolver<T>::resolve(name, args);
-        } catch (const cqasm::overload::NameResolutionFailure&) {
+        if (auto resolution = this->try_resolve(name, args); resolution.has_value()) {
+            return std::move(*resolution);
+        }
+        if (!this->contains(name)) {
             throw NameResolutionFailure{ fmt::format("failed to resolve '{}'", name) };
-        } catch (const cqasm::overload::OverloadResolutionFailure&) {
-            throw OverloadResolutionFailure{ fmt::format(
-                "failed to resolve overload for '{}' with argument pack ({})", name, types_of(args)) };
         }
+        throw OverloadResolutionFailure{ fmt::format(
+            "failed to resolve overload for '{}' with argument pack ({})", name, types_of(args)) };
     }
 };
 
@@ -86,21 +86,35 @@ struct OverloadedNameResolver : public BaseOverladedNameResolver<T> {
 
 /**
  * Table of all variables within a certain scope.
+ * Variables are keyed by their interned names, so a lookup does not hash nor compare name texts.
+ * Copies of a table share its variables until one of them adds a variable.
  */
 class VariableTable {
-    std::unordered_map<std::string, Value> table;
+    using table_t = std::unordered_map<primitives::Symbol, Value>;
+
+    std::shared_ptr<table_t> table;
+
+    [[nodiscard]] table_t& mutable_table();
 
 public:
+    VariableTable();
+
     /**
      * Adds a variable.
      */
-    void add(const std::string& name, const Value& value);
+    void add(const primitives::Symbol& name, const Value& value);
+
+    /**
+     * Resolves a variable.
+     * Returns empty if no variable by the given name exists.
+     */
+    [[nodiscard]] Value try_resolve(const primitives::Symbol& name) const;
 
     /**
      * Resolves a variable.
      * Throws NameResolutionFailure if no variable by the given name exists.
      */
-    [[nodiscard]] Value resolve(const std::string& name) const;
+    [[nodiscard]] Value resolve(const primitives::Symbol& name) const;
 };
 
 //----------------------------//
@@ -115,11 +129,14 @@ using ConstEvalCoreFunction = std::function<Value(const Values&)>;
 
 /**
  * Table of overloads of functions supported by the language, and that can be evaluated at compile time.
+ * Copies of a table share its overloads until one of them adds a function.
  */
 class ConstEvalCoreFunctionTable {
     using resolver_t = OverloadedNameResolver<ConstEvalCoreFunction>;
 
-    std::unique_ptr<resolver_t> resolver;
+    std::shared_ptr<resolver_t> resolver;
+
+    [[nodiscard]] resolver_t& mutable_resolver();
 
 public:
     ConstEvalCoreFunctionTable();
@@ -159,11 +176,14 @@ public:
 
 /**
  * Table of overloads of instructions supported by the language.
+ * Copies of a table share its overloads until one of them adds an instruction.
  */
 class InstructionTable {
     using resolver_t = OverloadedNameResolver<instruction::InstructionRef>;
 
-    std::unique_ptr<resolver_t> resolver;
+    std::shared_ptr<resolver_t> resolver;
+
+    [[nodiscard]] resolver_t& mutable_resolver();
 
 public:
     InstructionTable();
@@ -178,6 +198,21 @@ public:
      */
     void add(const instruction::Instruction& type);
 
+    /**
+     * Resolves a GateInstruction type.
+     * Returns empty if no instruction by the given name exists, or if no overload exists for the given arguments,
+     * otherwise returns the resolved instruction node.
+     */
+    [[nodiscard]] tree::One<semantic::Instruction> try_resolve(
+        const std::string& name, const tree::One<semantic::Gate>& gate, const Values& args) const;
+
+    /**
+     * Resolves a NonGateInstruction type.
+     * Returns empty if no instruction by the given name exists, or if no overload exists for the given arguments,
+     * otherwise returns the resolved instruction node.
+     */
+    [[nodiscard]] tree::One<semantic::Instruction> try_resolve(const std::string& name, const Values& args) const;
+
     /**
      * Resolves a GateInstruction type.
      * Throws NameResolutionFailure if no instruction by the given name exists,
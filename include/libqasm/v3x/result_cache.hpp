@@ -0,0 +1,247 @@
+/** \file
+ * Contains the ResultCache class template, an in-memory LRU cache of parse and analysis results.
+ */
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <functional>  // hash
+#include <iterator>  // prev
+#include <list>
+#include <memory>  // make_shared, shared_ptr
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>  // move
+
+namespace cqasm::v3x::parser {
+class ParseResult;
+}
+namespace cqasm::v3x::analyzer {
+class AnalysisResult;
+}
+
+namespace cqasm::v3x {
+
+/**
+ * Combines a hash value into a seed, as boost::hash_combine does.
+ */
+[[nodiscard]] constexpr size_t hash_combine(size_t seed, size_t value) {
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+/**
+ * Estimates the memory used by a parse result, from the number of nodes of its syntactic tree.
+ */
+[[nodiscard]] size_t estimate_memory_usage(const parser::ParseResult& result);
+
+/**
+ * Estimates the memory used by an analysis result, from the number of nodes of its semantic tree.
+ */
+[[nodiscard]] size_t estimate_memory_usage(const analyzer::AnalysisResult& result);
+
+/**
+ * Snapshot of the counters of a result cache.
+ */
+struct CacheStatistics {
+    /**
+     * Number of lookups that found a result.
+     */
+    size_t hits = 0;
+
+    /**
+     * Number of lookups that did not find a result.
+     */
+    size_t misses = 0;
+
+    /**
+     * Number of results evicted to keep the memory usage under the cap.
+     */
+    size_t evictions = 0;
+
+    /**
+     * Number of results currently cached.
+     */
+    size_t entries = 0;
+
+    /**
+     * Estimated memory usage, in bytes, of the results currently cached, together with their inputs.
+     */
+    size_t memory_usage = 0;
+};
+
+/**
+ * Content-addressed, least recently used cache of results, e.g. of parse or analysis results.
+ *
+ * Results are looked up by their input, i.e. the program text and the name of its file,
+ * together with a hash of the configuration that produced them, e.g. the parse options or the analyzer registrations.
+ * Entries are found through a hash of the whole key, but the input is compared in full,
+ * so a hash collision can only cause a miss, never a wrong result.
+ *
+ * Results are shared and immutable: the same result is returned to every caller,
+ * so callers must not modify the trees it refers to.
+ * The memory usage of an entry is estimated as the size of its input plus estimate_memory_usage of its result.
+ * Least recently used entries are evicted once the memory usage goes over the cap given to the constructor.
+ * A result larger than the cap on its own is not cached.
+ *
+ * All the member functions are thread-safe.
+ */
+template <typename Result>
+class ResultCache {
+    struct Entry {
+        size_t hash;
+        size_t configuration_hash;
+        std::optional<std::string> file_name;
+        std::string data;
+        std::shared_ptr<const Result> result;
+        size_t memory_usage;
+    };
+    using Entries = std::list<Entry>;
+
+    mutable std::mutex mutex_;
+    size_t max_memory_usage_;
+    CacheStatistics statistics_;
+
+    /**
+     * Entries, from the most to the least recently used one.
+     */
+    Entries entries_;
+
+    /**
+     * Entries, by hash of their key.
+     */
+    std::unordered_multimap<size_t, typename Entries::iterator> index_;
+
+    [[nodiscard]] static size_t hash(
+        size_t configuration_hash, const std::optional<std::string>& file_name, std::string_view data) {
+        auto ret = hash_combine(configuration_hash, std::hash<std::string_view>{}(data));
+        return file_name.has_value() ? hash_combine(ret, std::hash<std::string>{}(*file_name)) : ret;
+    }
+
+    typename Entries::iterator find_(size_t key_hash, size_t configuration_hash,
+        const std::optional<std::string>& file_name, std::string_view data) {
+        auto [first, last] = index_.equal_range(key_hash);
+        for (auto it = first; it != last; ++it) {
+            const auto& entry = *it->second;
+            if (entry.configuration_hash == configuration_hash && entry.file_name == file_name && entry.data == data) {
+                return it->second;
+            }
+        }
+        return entries_.end();
+    }
+
+    void evict_least_recently_used_() {
+        auto& entry = entries_.back();
+        auto [first, last] = index_.equal_range(entry.hash);
+        for (auto it = first; it != last; ++it) {
+            if (it->second == std::prev(entries_.end())) {
+                index_.erase(it);
+                break;
+            }
+        }
+        statistics_.memory_usage -= entry.memory_usage;
+        entries_.pop_back();
+        ++statistics_.evictions;
+    }
+
+public:
+    /**
+     * Creates an empty cache, whose estimated memory usage is kept under max_memory_usage bytes.
+     */
+    explicit ResultCache(size_t max_memory_usage)
+    : max_memory_usage_{ max_memory_usage } {}
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    /**
+     * Returns the cached result for the given input and configuration, or nullptr if there is none.
+     * A result that is found becomes the most recently used one.
+     */
+    std::shared_ptr<const Result> find(
+        size_t configuration_hash, const std::optional<std::string>& file_name, std::string_view data) {
+        std::lock_guard lock{ mutex_ };
+        auto it = find_(hash(configuration_hash, file_name, data), configuration_hash, file_name, data);
+        if (it == entries_.end()) {
+            ++statistics_.misses;
+            return nullptr;
+        }
+        ++statistics_.hits;
+        entries_.splice(entries_.begin(), entries_, it);
+        return it->result;
+    }
+
+    /**
+     * Caches the result for the given input and configuration, replacing any result cached for them,
+     * and evicting the least recently used results if needed.
+     */
+    void insert(size_t configuration_hash, const std::optional<std::string>& file_name, std::string_view data,
+        std::shared_ptr<const Result> result) {
+        auto memory_usage = data.size() + estimate_memory_usage(*result);
+        if (memory_usage > max_memory_usage_) {
+            return;
+        }
+        std::lock_guard lock{ mutex_ };
+        auto key_hash = hash(configuration_hash, file_name, data);
+        if (auto it = find_(key_hash, configuration_hash, file_name, data); it != entries_.end()) {
+            statistics_.memory_usage -= it->memory_usage;
+            it->result = std::move(result);
+            it->memory_usage = memory_usage;
+            statistics_.memory_usage += memory_usage;
+            entries_.splice(entries_.begin(), entries_, it);
+        } else {
+            entries_.push_front(Entry{
+                key_hash, configuration_hash, file_name, std::string{ data }, std::move(result), memory_usage });
+            index_.emplace(key_hash, entries_.begin());
+            statistics_.memory_usage += memory_usage;
+        }
+        while (statistics_.memory_usage > max_memory_usage_) {
+            evict_least_recently_used_();
+        }
+        statistics_.entries = entries_.size();
+    }
+
+    /**
+     * Returns the cached result for the given input and configuration,
+     * or computes it with the given function, and caches it.
+     * The function is called without holding the lock of the cache,
+     * so the same result may be computed concurrently by more than one thread.
+     */
+    template <typename Compute>
+    std::shared_ptr<const Result> get_or_compute(size_t configuration_hash,
+        const std::optional<std::string>& file_name, std::string_view data, Compute&& compute) {
+        if (auto ret = find(configuration_hash, file_name, data); ret != nullptr) {
+            return ret;
+        }
+        auto ret = std::make_shared<const Result>(compute());
+        insert(configuration_hash, file_name, data, ret);
+        return ret;
+    }
+
+    [[nodiscard]] CacheStatistics get_statistics() const {
+        std::lock_guard lock{ mutex_ };
+        return statistics_;
+    }
+
+    /**
+     * Removes all the cached results, and resets the counters.
+     */
+    void clear() {
+        std::lock_guard lock{ mutex_ };
+        entries_.clear();
+        index_.clear();
+        statistics_ = {};
+    }
+};
+
+namespace parser {
+using ParseResultCache = ResultCache<ParseResult>;
+}  // namespace parser
+
+namespace analyzer {
+using AnalysisResultCache = ResultCache<AnalysisResult>;
+}  // namespace analyzer
+
+}  // namespace cqasm::v3x
@@ -1,13 +1,14 @@
 #pragma once
 
-#include "libqasm/tree.hpp"
+#include <cstddef>  // size_t
+
 #include "libqasm/v3x/resolver.hpp"
-#include "libqasm/v3x/semantic_generated.hpp"
 
 namespace cqasm::v3x::analyzer {
 
 /**
  * Scope information.
+ * The blocks and the variables of an analyzed program are owned by the SemanticAnalyzer analyzing it.
  */
 struct Scope {
     /**
@@ -28,14 +29,9 @@ struct Scope {
     resolver::InstructionTable instruction_table;
 
     /**
-     * The block associated with this scope.
-     */
-    tree::One<semantic::Block> block;
-
-    /**
-     * The list of variables declared in this scope.
+     * Hash of everything registered in this scope, used as part of the configuration of cached results.
      */
-    tree::Any<semantic::Variable> variables;
+    size_t configuration_hash = 0;
 };
 
 }  // namespace cqasm::v3x::analyzer
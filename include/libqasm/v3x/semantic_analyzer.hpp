@@ -16,13 +16,33 @@ using IndexListT = tree::Many<IndexT>;
 
 using GlobalBlockReturnT = std::tuple<tree::One<semantic::Block>, const tree::Any<semantic::Variable>&>;
 
+/**
+ * Visitor analyzing one program with the configuration of an Analyzer.
+ * The state of the analysis is owned by the visitor, and the Analyzer is never changed,
+ * so many visitors may analyze programs with the same Analyzer at the same time.
+ */
 class SemanticAnalyzer : public syntactic::Visitor<std::any> {
 protected:
-    Analyzer& analyzer_;
+    const Analyzer& analyzer_;
     AnalysisResult result_;
 
+    /**
+     * The variables declared by the program, kept apart from the variables registered in the analyzer.
+     */
+    resolver::VariableTable variable_table_;
+
+    /**
+     * The global block of the program.
+     */
+    tree::One<semantic::Block> block_;
+
+    /**
+     * The list of variables declared by the program.
+     */
+    tree::Any<semantic::Variable> variables_;
+
 public:
-    explicit SemanticAnalyzer(Analyzer& analyzer);
+    explicit SemanticAnalyzer(const Analyzer& analyzer);
 
     std::any visit_node(syntactic::Node& node) override;
     std::any visit_program(syntactic::Program& node) override;
@@ -71,7 +91,67 @@ public:
     std::any visit_integer_literal(syntactic::IntegerLiteral& node) override;
     std::any visit_float_literal(syntactic::FloatLiteral& node) override;
 
+    /**
+     * Typed counterparts of the visit_* methods above.
+     * They return the analysis result directly, avoiding the boxing of the result in a std::any.
+     */
+    tree::Any<semantic::AnnotationData> analyze_annotations(syntactic::Annotated& node);
+    tree::One<semantic::AnnotationData> analyze_annotation_data(syntactic::AnnotationData& node);
+    tree::One<semantic::Variable> analyze_variable(syntactic::Variable& node);
+    tree::One<semantic::GateInstruction> analyze_gate_instruction(syntactic::GateInstruction& node);
+    tree::One<semantic::Gate> analyze_gate(syntactic::Gate& node);
+    tree::One<semantic::NonGateInstruction> analyze_non_gate_instruction(syntactic::NonGateInstruction& node);
+    tree::One<semantic::AsmDeclaration> analyze_asm_declaration(syntactic::AsmDeclaration& node);
+    values::Values analyze_expression_list(syntactic::ExpressionList& node);
+    values::Value analyze_expression(syntactic::Expression& node);
+    values::Value analyze_index(syntactic::Index& node);
+    IndexListT analyze_index_list(syntactic::IndexList& index_list_ast);
+    tree::One<IndexT> analyze_index_item(syntactic::IndexItem& index_item_ast);
+    IndexListT analyze_index_range(syntactic::IndexRange& index_range_ast);
+
+    /**
+     * Analyzes a statement according to its kind, adding it to the current scope
+     */
+    void analyze_statement(syntactic::Statement& node);
+
+    /**
+     * Starts the analysis of a program whose global block statements are given one at a time,
+     * e.g. by a StatementStream, instead of as part of a syntactic Program.
+     */
+    void begin_program(syntactic::Version& version);
+
+    /**
+     * Analyzes the next global block statement of the program started by begin_program.
+     */
+    void visit_global_block_statement(syntactic::Statement& statement);
+
+    /**
+     * Finishes the analysis of the program started by begin_program.
+     */
+    AnalysisResult end_program();
+
 private:
+    class ExpressionVisitor;
+    class StatementVisitor;
+
+    /**
+     * Registers a variable declared by the program.
+     * Throws NameResolutionFailure if the program or the analyzer already have a variable by the given name.
+     */
+    void register_variable(const primitives::Symbol& name, const values::Value& value);
+
+    /**
+     * Resolves a variable declared by the program or registered in the analyzer.
+     * Throws NameResolutionFailure if no variable by the given name exists.
+     */
+    [[nodiscard]] values::Value resolve_variable(const primitives::Symbol& name) const;
+
+    /**
+     * Analyzes an expression according to its kind,
+     * without giving errors the context of the expression
+     */
+    values::Value dispatch_expression(syntactic::Expression& node);
+
     /**
      * Build a semantic type
      * It can be a simple type SemanticT, of size 1,
@@ -101,7 +181,7 @@ private:
         if (type_name == types::bit_type_name) {
             return build_semantic_type<types::Bit, types::BitArray>(*type, types::bit_type_name);
         }
-        throw error::AnalysisError("unknown type \"" + type_name + "\"");
+        throw error::AnalysisError("unknown type \"" + type_name.str() + "\"");
     }
 
     /**
@@ -111,7 +191,7 @@ private:
     void visit_block(Block& block) {
         for (const auto& statement_ast : block.statements) {
             try {
-                statement_ast->visit(*this);
+                analyze_statement(*statement_ast);
             } catch (error::AnalysisError& err) {
                 err.context(block);
                 result_.errors.push_back(std::move(err));
@@ -128,12 +208,12 @@ private:
     /**
      * Convenience function for visiting unary operators
      */
-    std::any visit_unary_operator(const std::string& name, const tree::One<syntactic::Expression>& expression);
+    values::Value visit_unary_operator(const std::string& name, const tree::One<syntactic::Expression>& expression);
 
     /**
      * Convenience function for visiting binary operators
      */
-    std::any visit_binary_operator(const std::string& name, const tree::One<syntactic::Expression>& lhs,
+    values::Value visit_binary_operator(const std::string& name, const tree::One<syntactic::Expression>& lhs,
         const tree::One<syntactic::Expression>& rhs);
 
     /**
@@ -143,7 +223,7 @@ private:
      */
     template <class Type, class... TypeArgs>
     values::Value visit_as(syntactic::Expression& expression, TypeArgs... type_args) {
-        return values::promote(std::any_cast<values::Value>(expression.visit(*this)), tree::make<Type>(type_args...));
+        return values::promote(dispatch_expression(expression), tree::make<Type>(type_args...));
     }
 
     /**
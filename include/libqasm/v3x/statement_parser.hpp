@@ -0,0 +1,98 @@
+/** \file
+ * Contains the StatementParser class, used to parse a cQASM v3 program one statement at a time.
+ */
+
+#pragma once
+
+#include <antlr4-runtime.h>
+
+#include <cstddef>  // size_t
+#include <memory>  // unique_ptr
+
+#include "libqasm/v3x/expression_parser.hpp"
+#include "libqasm/v3x/parse_options.hpp"
+#include "libqasm/v3x/syntactic.hpp"
+#include "libqasm/v3x/syntactic_analyzer_base.hpp"
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Parses a cQASM v3 program one global block statement at a time.
+ *
+ * Instead of building the parse tree of the whole program, and then visiting it,
+ * the parse tree of each statement is converted to its syntactic node as soon as the statement has been parsed,
+ * and then released.
+ * So, at any time, only the parse tree of the statement being parsed is kept in memory.
+ *
+ * Parsing stops at the first lexer or parser error, which is reported to the error listener given to the constructor.
+ * The error listener is expected to throw, e.g. an antlr4::ParseCancellationException,
+ * so that callers can reparse the whole program with a regular CqasmParser to get the exact diagnostic.
+ * With SLL prediction, parser errors are not reported, and an antlr4::ParseCancellationException is thrown instead.
+ * Alternatively, with full LL prediction, callers can recover from an error by calling skip_statement,
+ * and then carry on parsing the following statements.
+ *
+ * The tokens of a statement are marked in the token stream while the statement is being parsed,
+ * so the token stream can be an antlr4::UnbufferedTokenStream,
+ * which then only keeps the tokens of the statement being parsed in memory.
+ *
+ * With the precedence_climbing expression parser type,
+ * gate and non-gate instructions are parsed by an ExpressionParser, without building any parse tree.
+ * If the ExpressionParser cannot parse an instruction on its own, the instruction is parsed again by CqasmParser.
+ */
+class StatementParser {
+    /**
+     * CqasmParser that allows releasing the parse trees it has created.
+     */
+    class Parser;
+
+    std::unique_ptr<Parser> parser_up_;
+    BaseSyntacticAnalyzer& builder_visitor_;
+    ExpressionParser expression_parser_;
+    ExpressionParserType expression_parser_type_;
+    bool done_ = false;
+
+    syntactic::Maybe<syntactic::Statement> try_parse_instruction_();
+    syntactic::One<syntactic::Statement> parse_instruction_();
+    syntactic::One<syntactic::Statement> parse_gate_instruction_();
+    syntactic::One<syntactic::Gate> parse_gate_();
+    syntactic::One<syntactic::Statement> parse_measure_instruction_();
+    [[nodiscard]] bool is_measure_instruction_() const;
+
+public:
+    /**
+     * Both the token stream and the builder visitor have to outlive the statement parser.
+     */
+    StatementParser(antlr4::TokenStream& tokens, BaseSyntacticAnalyzer& builder_visitor,
+        antlr4::ANTLRErrorListener* error_listener, bool sll,
+        ExpressionParserType expression_parser_type = ExpressionParserType::antlr);
+    ~StatementParser();
+
+    StatementParser(const StatementParser&) = delete;
+    StatementParser& operator=(const StatementParser&) = delete;
+
+    /**
+     * Parses the version section.
+     * Must be called once, before any call to parse_statement.
+     */
+    syntactic::One<syntactic::Version> parse_version();
+
+    /**
+     * Parses the next global block statement, together with the statement separators that precede it.
+     * Returns an empty Maybe once the end of the program has been reached.
+     */
+    syntactic::Maybe<syntactic::Statement> parse_statement();
+
+    /**
+     * Skips the rest of the statement, or version section, whose parsing has been abandoned because of an error,
+     * up to the next statement separator, so that parsing can carry on with the next statement.
+     */
+    void skip_statement();
+
+    /**
+     * Returns the number of rule contexts and terminal nodes created by CqasmParser and not released yet.
+     * They are released after every statement, so this number does not grow with the length of the program.
+     */
+    [[nodiscard]] size_t tracked_parse_tree_count() const;
+};
+
+}  // namespace cqasm::v3x::parser
@@ -0,0 +1,83 @@
+/** \file
+ * Contains the StatementStream class, used to pull the statements of a cQASM v3 program one at a time.
+ */
+
+#pragma once
+
+#include <memory>  // unique_ptr
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "libqasm/v3x/parse_options.hpp"
+#include "libqasm/v3x/syntactic.hpp"
+
+namespace antlr4 {
+class CharStream;
+class TokenSource;
+class UnbufferedTokenStream;
+}
+namespace cqasm::v3x::parser {
+class AntlrCustomErrorListener;
+class StatementParser;
+class SyntacticAnalyzer;
+}
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Pull-based parser that yields the version of a program, and then its global block statements, one at a time.
+ *
+ * Neither the tokens nor the parse tree of the whole program are ever held in memory:
+ * the input is read in place, tokens are lexed on demand by an antlr4::UnbufferedTokenStream,
+ * and the parse tree of each statement is released once the statement has been built.
+ * So memory usage is bounded by the size of a single statement, not the whole program.
+ * Together with a MemoryMappedFile, this allows parsing programs larger than the available memory, e.g.:
+ *
+ *     MemoryMappedFile file{ "program.cq" };
+ *     StatementStream statement_stream{ file.data(), "program.cq" };
+ *     for (auto statement = statement_stream.next(); !statement.empty(); statement = statement_stream.next()) {
+ *         ...
+ *     }
+ *
+ * A ParseError is thrown at the first lexer or parser error, or value out of range.
+ * Since the program cannot be parsed again, errors are reported as soon as they are found, with full LL prediction,
+ * so the prediction_strategy and build_mode options are ignored.
+ * Errors are the same as the ones of parse_string, except that, when a program contains several errors,
+ * a value out of range may be reported before a syntax error found in a later statement.
+ */
+class StatementStream {
+    std::unique_ptr<SyntacticAnalyzer> builder_visitor_up_;
+    std::unique_ptr<AntlrCustomErrorListener> error_listener_up_;
+    std::unique_ptr<antlr4::CharStream> char_stream_up_;
+    std::unique_ptr<antlr4::TokenSource> lexer_up_;
+    std::unique_ptr<antlr4::UnbufferedTokenStream> tokens_up_;
+    std::unique_ptr<StatementParser> statement_parser_up_;
+    syntactic::One<syntactic::Version> version_;
+
+public:
+    /**
+     * Parses the version section straight away.
+     * The data is read in place, so it has to outlive the statement stream.
+     * A file_name may be given in addition for use within error messages.
+     */
+    StatementStream(
+        std::string_view data, const std::optional<std::string>& file_name, const ParseOptions& options = {});
+    ~StatementStream();
+
+    StatementStream(const StatementStream&) = delete;
+    StatementStream& operator=(const StatementStream&) = delete;
+
+    /**
+     * Version of the program.
+     */
+    [[nodiscard]] const syntactic::One<syntactic::Version>& version() const;
+
+    /**
+     * Parses the next global block statement.
+     * Returns an empty Maybe once the end of the program has been reached.
+     */
+    syntactic::Maybe<syntactic::Statement> next();
+};
+
+}  // namespace cqasm::v3x::parser
@@ -4,10 +4,13 @@
 
 #include <any>
 #include <optional>
+#include <string_view>
 #include <tuple>
 
+#include "libqasm/annotations.hpp"
 #include "libqasm/v3x/CqasmParser.h"
 #include "libqasm/v3x/CqasmParserVisitor.h"
+#include "libqasm/v3x/parse_options.hpp"
 #include "libqasm/v3x/syntactic_analyzer_base.hpp"
 
 namespace cqasm::v3x::parser {
@@ -18,17 +21,22 @@ namespace cqasm::v3x::parser {
 
 class SyntacticAnalyzer : public BaseSyntacticAnalyzer {
     /**
-     * Name of the file being parsed.
+     * Name of the file being parsed, shared by the source locations of all the nodes.
      */
-    std::optional<std::string> file_name_;
+    annotations::FileName file_name_;
+
+    /**
+     * Which nodes are annotated with their source location.
+     */
+    SourceLocationMode source_location_mode_;
 
     /**
      * Error listener.
      */
     AntlrCustomErrorListener* error_listener_p_;
 
-    [[nodiscard]] std::int64_t get_int_value(size_t line, size_t char_position_in_line, const std::string& text) const;
-    [[nodiscard]] double get_float_value(size_t line, size_t char_position_in_line, const std::string& text) const;
+    [[nodiscard]] std::int64_t get_int_value(size_t line, size_t char_position_in_line, std::string_view text) const;
+    [[nodiscard]] double get_float_value(size_t line, size_t char_position_in_line, std::string_view text) const;
 
     bool get_bool_value(antlr4::tree::TerminalNode* node) const;
     std::int64_t get_int_value(antlr4::tree::TerminalNode* node) const;
@@ -107,13 +115,18 @@ public:
     std::any visitIntegerLiteral(CqasmParser::IntegerLiteralContext* context) override;
     std::any visitFloatLiteral(CqasmParser::FloatLiteralContext* context) override;
 
-    explicit SyntacticAnalyzer(const std::optional<std::string>& file_name);
+    explicit SyntacticAnalyzer(const std::optional<std::string>& file_name,
+        SourceLocationMode source_location_mode = SourceLocationMode::all_nodes);
+    void set_file_name(const std::optional<std::string>& file_name);
     void addErrorListener(AntlrCustomErrorListener* error_listener) override;
     void syntaxError(size_t line, size_t char_position_in_line, const std::string& text) const override;
     void setNodeAnnotation(const syntactic::One<syntactic::Node>& node, antlr4::Token* token) const override;
     void expandNodeAnnotation(const syntactic::One<syntactic::Node>& node, antlr4::Token* token) const override;
     void copyNodeAnnotation(
         const syntactic::One<syntactic::Node>& from, const syntactic::One<syntactic::Node>& to) const override;
+    bool getBoolValue(antlr4::Token* token) const override;
+    std::int64_t getIntValue(antlr4::Token* token) const override;
+    double getFloatValue(antlr4::Token* token) const override;
 };
 
 }  // namespace cqasm::v3x::parser
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <any>
+#include <cstdint>  // int64_t
 
 #include "libqasm/v3x/CqasmParser.h"
 #include "libqasm/v3x/CqasmParserVisitor.h"
@@ -15,6 +16,14 @@ class AntlrCustomErrorListener;
 
 namespace cqasm::v3x::parser {
 
+/**
+ * Builder of the syntactic AST from an ANTLR parse tree.
+ *
+ * In the parallel_chunks build mode, one builder visits the parse trees of all the chunks,
+ * from many threads at the same time.
+ * So visiting must not modify the builder: only addErrorListener may, and it is not called while visiting.
+ * In that mode, the error listener throws the errors reported to it, instead of storing them.
+ */
 class BaseSyntacticAnalyzer : public CqasmParserVisitor {
 public:
     virtual void addErrorListener(AntlrCustomErrorListener* error_listener) = 0;
@@ -23,6 +32,9 @@ public:
     virtual void expandNodeAnnotation(const syntactic::One<syntactic::Node>& node, antlr4::Token* token) const = 0;
     virtual void copyNodeAnnotation(
         const syntactic::One<syntactic::Node>& from, const syntactic::One<syntactic::Node>& to) const = 0;
+    virtual bool getBoolValue(antlr4::Token* token) const = 0;
+    virtual std::int64_t getIntValue(antlr4::Token* token) const = 0;
+    virtual double getFloatValue(antlr4::Token* token) const = 0;
 };
 
 }  // namespace cqasm::v3x::parser
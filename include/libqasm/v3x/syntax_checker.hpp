@@ -0,0 +1,39 @@
+/** \file
+ * Contains the entry points for checking the syntax of a cQASM v3 program, without building its syntactic AST.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "libqasm/error.hpp"
+#include "libqasm/v3x/parse_options.hpp"
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Checks the syntax of the given string, e.g. for pre-commit hooks or for validating a large corpus of programs.
+ *
+ * The input is only recognized by the lexer and the parser: no parse tree is built,
+ * the syntactic analyzer does not run, and no syntactic AST nor source location annotations are created.
+ * The values of the integer and float literals are still checked to be in range.
+ * The errors are the same as the ones of parse_string, so an empty result means that parse_string would succeed.
+ *
+ * The data is read in place, without being copied or transcoded to UTF-32.
+ * A file_name may be given in addition for use within error messages.
+ * Only the lexer_type and prediction_strategy options are used.
+ */
+error::ParseErrors check_string(
+    std::string_view data, const std::optional<std::string>& file_name, const ParseOptions& options = {});
+
+/**
+ * Checks the syntax of the file at the given file path, as check_string does.
+ * The file is memory-mapped, and read in place.
+ * Throws a ParseError if the file cannot be opened.
+ */
+error::ParseErrors check_file(
+    const std::string& file_path, const std::optional<std::string>& file_name, const ParseOptions& options = {});
+
+}  // namespace cqasm::v3x::parser
@@ -0,0 +1,74 @@
+/** \file
+ * Contains the Utf8CharStream class, an ANTLR character stream reading UTF-8 input in place.
+ */
+
+#pragma once
+
+#include <antlr4-runtime.h>
+
+#include <cstddef>  // size_t
+#include <string>
+#include <string_view>
+
+namespace cqasm::v3x::parser {
+
+/**
+ * ANTLR character stream over UTF-8 input owned by the caller, e.g. a string or a memory-mapped file.
+ *
+ * Unlike antlr4::ANTLRInputStream, which decodes the whole input into a UTF-32 buffer up front,
+ * code points are decoded on the fly, and the input is neither copied nor transcoded.
+ * Lexers see the same sequence of code points, so tokens, lines, and columns are the same as with ANTLRInputStream.
+ * However, indices, e.g. token start and stop indices, are byte offsets instead of code point offsets.
+ * Each byte of an invalid UTF-8 sequence is read as a U+FFFD replacement character,
+ * although getText returns the original bytes.
+ *
+ * The input has to outlive the stream.
+ */
+class Utf8CharStream : public antlr4::CharStream {
+    std::string_view data_;
+    std::string source_name_;
+
+    /**
+     * Byte offset of the current code point.
+     */
+    size_t index_ = 0;
+
+    [[nodiscard]] size_t code_point_size(size_t index) const;
+    [[nodiscard]] size_t previous_code_point_index(size_t index) const;
+    [[nodiscard]] size_t decode(size_t index) const;
+
+public:
+    explicit Utf8CharStream(std::string_view data, std::string source_name = {});
+
+    void consume() override;
+    size_t LA(ssize_t i) override;
+    ssize_t mark() override;
+    void release(ssize_t marker) override;
+    size_t index() override;
+    void seek(size_t index) override;
+    size_t size() override;
+    [[nodiscard]] std::string getSourceName() const override;
+    std::string getText(const antlr4::misc::Interval& interval) override;
+    [[nodiscard]] std::string toString() const override;
+
+    /**
+     * Same as getText, but returns a view into the input instead of a copy.
+     */
+    [[nodiscard]] std::string_view get_text_view(const antlr4::misc::Interval& interval) const;
+
+    /**
+     * Number of code points from the start index up to the stop index, excluded.
+     * Both indices have to be starts of code points, or the size of the input.
+     */
+    [[nodiscard]] size_t count_code_points(size_t start, size_t stop) const;
+};
+
+/**
+ * Returns the text of a token without copying it, if the token was read from a Utf8CharStream.
+ * The text is then a view into the input.
+ * Otherwise, the text is copied into the given buffer, and the returned view refers to the buffer.
+ * Tokens are expected to take their text from the input, i.e. not to have it set by a lexer action.
+ */
+std::string_view get_token_text(const antlr4::Token& token, std::string& buffer);
+
+}  // namespace cqasm::v3x::parser
@@ -10,6 +10,7 @@
 #include <fmt/ostream.h>
 
 #include <algorithm>  // all_of, for_each
+#include <cstdint>  // uint16_t
 
 #include "libqasm/v3x/syntactic.hpp"
 #include "libqasm/v3x/types.hpp"
@@ -40,6 +41,12 @@ using Values = tree::Any<ValueBase>;
  */
 Value promote(const Value& value, const types::Type& type);
 
+/**
+ * Returns a code made of the node kinds of the given value and of its type.
+ * Whether and how promote promotes a value to a type only depends on this code and on the type.
+ */
+std::uint16_t promotion_code(const Value& value);
+
 /**
  * Checks if a from_type can be promoted to a to_type.
  */
@@ -2,6 +2,8 @@ import cqasm.v3x.instruction
 import cqasm.v3x.types
 
 Str = str
+Symbol = str
+RawText = str
 Bool = bool
 Int = int
 Float = float
@@ -5,12 +5,172 @@
 #include "libqasm/annotations.hpp"
 
 #include <algorithm>  // min, max
+#include <atomic>
 #include <iostream>
+#include <mutex>  // unique_lock
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>  // exchange
 
 #include "libqasm/annotations_constants.hpp"
 
 namespace cqasm::annotations {
 
+/**
+ * Entry of the file table.
+ */
+struct FileName::Data {
+    std::string name;
+    /**
+     * Number of file names pointing to this entry.
+     * Once it has dropped to zero, the entry is being freed, and is not handed out again.
+     */
+    std::atomic<size_t> reference_count;
+};
+
+struct FileName::Table {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string_view, Data*> index;
+};
+
+FileName::Table& FileName::table() {
+    // Leaked on purpose, so that file names held by static objects stay valid during static destruction
+    static auto* table = new Table{};
+    return *table;
+}
+
+/**
+ * Adds a reference to a file table entry, unless it is being freed.
+ */
+bool FileName::try_add_reference(Data* data) {
+    auto reference_count = data->reference_count.load();
+    while (reference_count != 0) {
+        if (data->reference_count.compare_exchange_weak(reference_count, reference_count + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+FileName::Data* FileName::intern(std::string_view file_name) {
+    if (file_name.empty()) {
+        return nullptr;
+    }
+    auto& table = FileName::table();
+    {
+        std::shared_lock lock{ table.mutex };
+        if (auto it = table.index.find(file_name); it != table.index.end() && try_add_reference(it->second)) {
+            return it->second;
+        }
+    }
+    std::unique_lock lock{ table.mutex };
+    // Another thread may have added the file name in the meantime, or released its last reference
+    if (auto it = table.index.find(file_name); it != table.index.end()) {
+        if (try_add_reference(it->second)) {
+            return it->second;
+        }
+        // The entry is being freed, so it is replaced, and left to the thread freeing it
+        table.index.erase(it);
+    }
+    auto* data = new Data{ std::string{ file_name }, 1 };
+    table.index.emplace(data->name, data);
+    return data;
+}
+
+void FileName::release(Data* data) {
+    if (data == nullptr || data->reference_count.fetch_sub(1) != 1) {
+        return;
+    }
+    {
+        auto& table = FileName::table();
+        std::unique_lock lock{ table.mutex };
+        if (auto it = table.index.find(data->name); it != table.index.end() && it->second == data) {
+            table.index.erase(it);
+        }
+    }
+    delete data;
+}
+
+FileName::FileName(const FileName& other)
+: data_{ other.data_ } {
+    if (data_ != nullptr) {
+        data_->reference_count.fetch_add(1);
+    }
+}
+
+FileName::FileName(FileName&& other) noexcept
+: data_{ std::exchange(other.data_, nullptr) } {}
+
+FileName& FileName::operator=(const FileName& other) {
+    if (data_ != other.data_) {
+        if (other.data_ != nullptr) {
+            other.data_->reference_count.fetch_add(1);
+        }
+        release(data_);
+        data_ = other.data_;
+    }
+    return *this;
+}
+
+FileName& FileName::operator=(FileName&& other) noexcept {
+    if (this != &other) {
+        release(data_);
+        data_ = std::exchange(other.data_, nullptr);
+    }
+    return *this;
+}
+
+FileName::~FileName() {
+    release(data_);
+}
+
+FileName::FileName(std::nullopt_t) {}
+
+FileName::FileName(const std::optional<std::string>& file_name)
+: data_{ file_name.has_value() ? intern(file_name.value()) : nullptr } {}
+
+FileName::FileName(const std::string& file_name)
+: data_{ intern(file_name) } {}
+
+FileName::FileName(const char* file_name)
+: data_{ intern(file_name) } {}
+
+bool FileName::has_value() const {
+    return data_ != nullptr;
+}
+
+const std::string& FileName::value() const {
+    if (data_ == nullptr) {
+        throw std::bad_optional_access{};
+    }
+    return data_->name;
+}
+
+std::string_view FileName::value_or(std::string_view default_value) const {
+    return has_value() ? std::string_view{ value() } : default_value;
+}
+
+bool FileName::operator==(const std::string& other) const {
+    return value_or({}) == other;
+}
+
+bool FileName::operator==(const char* other) const {
+    return value_or({}) == other;
+}
+
+size_t FileName::table_size() {
+    auto& table = FileName::table();
+    std::shared_lock lock{ table.mutex };
+    return table.index.size();
+}
+
+/**
+ * Stream << overload for file names.
+ */
+std::ostream& operator<<(std::ostream& os, const FileName& object) {
+    return os << object.value_or(unknown_file_name);
+}
+
 SourceLocation::Range::Range(const Index& f, const Index& l)
 : first{ f }
 , last{ l } {
@@ -20,13 +180,9 @@ SourceLocation::Range::Range(const Index& f, const Index& l)
 /**
  * Constructs a source location object.
  */
-SourceLocation::SourceLocation(const std::optional<std::string>& file_name_, const Range& range_)
+SourceLocation::SourceLocation(const FileName& file_name_, const Range& range_)
 : file_name{ file_name_ }
-, range{ range_ } {
-    if (file_name.has_value() && file_name.value().empty()) {
-        file_name = std::nullopt;
-    }
-}
+, range{ range_ } {}
 
 /**
  * Expands the location range to contain the given location in the source file.
@@ -41,7 +197,7 @@ void SourceLocation::expand_to_include(const Index& index) {
  */
 std::ostream& operator<<(std::ostream& os, const SourceLocation& object) {
     // Print file name.
-    os << object.file_name.value_or(unknown_file_name);
+    os << object.file_name;
 
     // Special case for when only the source file name is known.
     if (!object.range.first.line) {
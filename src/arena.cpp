@@ -0,0 +1,66 @@
+/** \file
+ * Implementation for \ref include/libqasm/arena.hpp "libqasm/arena.hpp".
+ */
+
+#include "libqasm/arena.hpp"
+
+#include <algorithm>  // max, min
+#include <cstdint>  // uintptr_t
+
+namespace cqasm::tree {
+
+namespace {
+
+/**
+ * Arena tree::make allocates from in the current thread.
+ */
+thread_local std::shared_ptr<Arena> current_arena;
+
+}  // namespace
+
+void* Arena::allocate(size_t size, size_t alignment) {
+    auto padding = (alignment - reinterpret_cast<std::uintptr_t>(next_) % alignment) % alignment;
+    if (next_ == nullptr || padding + size > available_) {
+        // An allocation larger than the next chunk size gets a chunk of its own size
+        auto chunk_size = std::max(next_chunk_size_, size + alignment);
+        // The chunk is left uninitialized, as every node is constructed in place anyway
+        chunks_.emplace_back(new std::byte[chunk_size]);
+        next_ = chunks_.back().get();
+        available_ = chunk_size;
+        memory_usage_ += chunk_size;
+        next_chunk_size_ = std::min(next_chunk_size_ * 2, max_chunk_size);
+        padding = (alignment - reinterpret_cast<std::uintptr_t>(next_) % alignment) % alignment;
+    }
+    auto* ret = next_ + padding;
+    next_ += padding + size;
+    available_ -= padding + size;
+    ++number_of_allocations_;
+    return ret;
+}
+
+size_t Arena::number_of_allocations() const {
+    return number_of_allocations_;
+}
+
+size_t Arena::number_of_chunks() const {
+    return chunks_.size();
+}
+
+size_t Arena::memory_usage() const {
+    return memory_usage_;
+}
+
+const std::shared_ptr<Arena>& Arena::current() {
+    return current_arena;
+}
+
+ArenaScope::ArenaScope(std::shared_ptr<Arena> arena)
+: previous_{ std::move(current_arena) } {
+    current_arena = std::move(arena);
+}
+
+ArenaScope::~ArenaScope() {
+    current_arena = std::move(previous_);
+}
+
+}  // namespace cqasm::tree
@@ -0,0 +1,100 @@
+/** \file
+ * Implementation for \ref include/libqasm/memory_mapped_file.hpp "libqasm/memory_mapped_file.hpp".
+ */
+
+#include "libqasm/memory_mapped_file.hpp"
+
+#include <fmt/format.h>
+
+#include "libqasm/error.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>  // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>  // close
+#endif
+
+namespace cqasm {
+
+#ifdef _WIN32
+
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& file_path) {
+    auto file = CreateFileW(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw error::ParseError{ fmt::format("MemoryMappedFile couldn't access file '{}'.", file_path.string()) };
+    }
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        throw error::ParseError{ fmt::format("MemoryMappedFile couldn't access file '{}'.", file_path.string()) };
+    }
+    size_ = static_cast<size_t>(file_size.QuadPart);
+    if (size_ > 0) {
+        // The view keeps a reference to the mapping, and the mapping to the file
+        auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+    if (size_ > 0 && !data_) {
+        throw error::ParseError{ fmt::format("MemoryMappedFile couldn't map file '{}'.", file_path.string()) };
+    }
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& file_path) {
+    auto fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw error::ParseError{ fmt::format("MemoryMappedFile couldn't access file '{}'.", file_path.string()) };
+    }
+    struct stat file_status {};
+    if (::fstat(fd, &file_status) == -1 || !S_ISREG(file_status.st_mode)) {
+        ::close(fd);
+        throw error::ParseError{ fmt::format("MemoryMappedFile couldn't access file '{}'.", file_path.string()) };
+    }
+    size_ = static_cast<size_t>(file_status.st_size);
+    if (size_ > 0) {
+        // The mapping remains valid after the file descriptor is closed
+        auto* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            data_ = static_cast<const char*>(addr);
+        }
+    }
+    ::close(fd);
+    if (size_ > 0 && !data_) {
+        throw error::ParseError{ fmt::format("MemoryMappedFile couldn't map file '{}'.", file_path.string()) };
+    }
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (data_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+#endif
+
+std::string_view MemoryMappedFile::data() const noexcept {
+    return { data_, size_ };
+}
+
+}  // namespace cqasm
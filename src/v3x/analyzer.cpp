@@ -6,16 +6,22 @@
 
 #include <fmt/format.h>
 
+#include <cassert>  // assert
+#include <functional>  // hash
 #include <memory>  // make_unique
 #include <numbers>
+#include <optional>
 #include <stdexcept>  // runtime_error
+#include <utility>  // move
 
 #include "libqasm/error.hpp"
+#include "libqasm/memory_mapped_file.hpp"
 #include "libqasm/v3x/core_function.hpp"
 #include "libqasm/v3x/parse_helper.hpp"
 #include "libqasm/v3x/register_consteval_core_functions.hpp"
 #include "libqasm/v3x/register_instructions.hpp"
 #include "libqasm/v3x/semantic_analyzer.hpp"
+#include "libqasm/v3x/statement_stream.hpp"
 
 namespace cqasm::v3x::analyzer {
 
@@ -29,31 +35,61 @@ Analyzer::Analyzer(const primitives::Version& api_version)
     if (api_version != "3.0") {
         throw std::invalid_argument{ "this analyzer only supports cQASM 3.0" };
     }
-    global_scope().block = tree::make<semantic::Block>();
+    add_to_configuration_hash(global_scope(), fmt::format("api_version {}", api_version));
+}
+
+/**
+ * Creates a semantic analyzer with the configuration of another one.
+ * The tables of every scope are copied, and they share their contents with the other analyzer.
+ */
+Analyzer::Analyzer(const Analyzer& other)
+: api_version{ other.api_version }
+, pipeline_mode{ other.pipeline_mode }
+, source_location_mode{ other.source_location_mode }
+, result_cache{ other.result_cache }
+, has_custom_functions_{ other.has_custom_functions_ } {
+    for (const auto& scope : other.scope_stack_) {
+        scope_stack_.push_back(Scope{ scope.variable_table, scope.consteval_core_function_table,
+            scope.instruction_table, scope.configuration_hash });
+    }
+}
+
+Analyzer& Analyzer::operator=(const Analyzer& other) {
+    if (this != &other) {
+        *this = Analyzer{ other };
+    }
+    return *this;
+}
+
+void Analyzer::add_to_configuration_hash(Scope& scope, const std::string& description) {
+    scope.configuration_hash = hash_combine(scope.configuration_hash, std::hash<std::string>{}(description));
+}
+
+size_t Analyzer::configuration_hash() const {
+    size_t ret = 0;
+    for (const auto& scope : scope_stack_) {
+        ret = hash_combine(ret, scope.configuration_hash);
+    }
+    return ret;
 }
 
 [[nodiscard]] Scope& Analyzer::global_scope() {
+    assert(!scope_stack_.empty());
     return scope_stack_.back();
 }
 [[nodiscard]] Scope& Analyzer::current_scope() {
+    assert(!scope_stack_.empty());
     return scope_stack_.front();
 }
-[[nodiscard]] tree::One<semantic::Block> Analyzer::current_block() {
-    return current_scope().block;
-}
-[[nodiscard]] tree::Any<semantic::Variable>& Analyzer::current_variables() {
-    return current_scope().variables;
-}
 
 [[nodiscard]] const Scope& Analyzer::global_scope() const {
+    assert(!scope_stack_.empty());
     return scope_stack_.back();
 }
 [[nodiscard]] const Scope& Analyzer::current_scope() const {
+    assert(!scope_stack_.empty());
     return scope_stack_.front();
 }
-[[nodiscard]] const tree::Any<semantic::Variable>& Analyzer::current_variables() const {
-    return current_scope().variables;
-}
 
 /**
  * Registers constants for pi, eu (aka e, 2.718...), tau and im (imaginary unit).
@@ -71,7 +107,10 @@ void Analyzer::register_default_constants() {
  * Registers a number of default functions, such as the operator functions, and the usual trigonometric functions.
  */
 void Analyzer::register_default_functions() {
+    auto has_custom_functions = has_custom_functions_;
     function::register_consteval_core_functions(this);
+    // The default functions are fully identified by their name and parameter types
+    has_custom_functions_ = has_custom_functions;
 }
 
 /**
@@ -81,12 +120,12 @@ void Analyzer::register_default_instructions() {
     instruction::register_instructions(this);
 }
 
+namespace {
+
 /**
- * Analyzes the given AST.
+ * Checks that the semantic tree of an analysis without errors is complete.
  */
-AnalysisResult Analyzer::analyze(syntactic::Program& ast) {
-    auto analyze_visitor_up = std::make_unique<SemanticAnalyzer>(*this);
-    auto result = std::any_cast<AnalysisResult>(analyze_visitor_up->visit_program(ast));
+void check_well_formed(const AnalysisResult& result) {
     if (result.errors.empty()) {
         try {
             result.root.check_well_formed();
@@ -97,6 +136,17 @@ AnalysisResult Analyzer::analyze(syntactic::Program& ast) {
             throw std::runtime_error{ "no semantic errors returned, but semantic tree is incomplete." };
         }
     }
+}
+
+}  // namespace
+
+/**
+ * Analyzes the given AST.
+ */
+AnalysisResult Analyzer::analyze(syntactic::Program& ast) const {
+    auto analyze_visitor_up = std::make_unique<SemanticAnalyzer>(*this);
+    auto result = std::any_cast<AnalysisResult>(analyze_visitor_up->visit_program(ast));
+    check_well_formed(result);
     return result;
 }
 
@@ -105,7 +155,7 @@ AnalysisResult Analyzer::analyze(syntactic::Program& ast) {
  * If there are parse errors, they are moved into the AnalysisResult error list,
  * and the root node will be empty.
  */
-AnalysisResult Analyzer::analyze(const parser::ParseResult& parse_result) {
+AnalysisResult Analyzer::analyze(const parser::ParseResult& parse_result) const {
     if (!parse_result.errors.empty()) {
         return AnalysisResult{ {}, parse_result.errors };
     }
@@ -115,16 +165,79 @@ AnalysisResult Analyzer::analyze(const parser::ParseResult& parse_result) {
 /**
  * Parses and analyzes the given file.
  */
-AnalysisResult Analyzer::analyze_file(const std::string& file_name) {
-    return analyze(parser::parse_file(file_name, file_name));
+AnalysisResult Analyzer::analyze_file(const std::string& file_name) const {
+    if (pipeline_mode == PipelineMode::fused) {
+        std::optional<MemoryMappedFile> file{};
+        try {
+            file.emplace(file_name);
+        } catch (const error::ParseError&) {
+            // Let the two-phase pipeline report that the file cannot be accessed
+        }
+        if (file.has_value()) {
+            if (auto result = analyze_fused(file->data(), file_name); result.has_value()) {
+                return std::move(*result);
+            }
+        }
+    }
+    return analyze(parser::parse_file(file_name, file_name, { .source_location_mode = source_location_mode }));
 }
 
 /**
  * Parses and analyzes the given string.
  * The optional file_name argument will be used only for error messages.
  */
-AnalysisResult Analyzer::analyze_string(const std::string& data, const std::optional<std::string>& file_name) {
-    return analyze(parser::parse_string(data, file_name));
+AnalysisResult Analyzer::analyze_string(
+    const std::string& data, const std::optional<std::string>& file_name) const {
+    auto parse_and_analyze = [this, &data, &file_name]() {
+        if (pipeline_mode == PipelineMode::fused) {
+            if (auto result = analyze_fused(data, file_name); result.has_value()) {
+                return std::move(*result);
+            }
+        }
+        return analyze(parser::parse_string(data, file_name, { .source_location_mode = source_location_mode }));
+    };
+    if (result_cache != nullptr && !has_custom_functions_) {
+        auto hash = hash_combine(hash_combine(configuration_hash(), static_cast<size_t>(pipeline_mode)),
+            static_cast<size_t>(source_location_mode));
+        return *result_cache->get_or_compute(hash, file_name, data, parse_and_analyze);
+    }
+    return parse_and_analyze();
+}
+
+/**
+ * Parses and analyzes the given data one statement at a time, for the fused pipeline mode.
+ * Each statement is analyzed as soon as it has been parsed, and its syntactic subtree is then dropped.
+ * Returns an empty optional if the data contains a parse error,
+ * in which case the semantic errors found so far are discarded,
+ * as the two-phase pipeline only reports the parse errors.
+ */
+std::optional<AnalysisResult> Analyzer::analyze_fused(
+    std::string_view data, const std::optional<std::string>& file_name) const {
+    // Only the statement stream is guarded, as the ParseErrors it throws are the only errors handled here.
+    // Semantic errors are caught by the semantic analyzer, and any other exception is propagated
+    std::optional<parser::StatementStream> statement_stream{};
+    try {
+        statement_stream.emplace(data, file_name, parser::ParseOptions{ .source_location_mode = source_location_mode });
+    } catch (const error::ParseError&) {
+        return std::nullopt;
+    }
+    auto analyze_visitor_up = std::make_unique<SemanticAnalyzer>(*this);
+    analyze_visitor_up->begin_program(*statement_stream->version());
+    while (true) {
+        syntactic::Maybe<syntactic::Statement> statement{};
+        try {
+            statement = statement_stream->next();
+        } catch (const error::ParseError&) {
+            return std::nullopt;
+        }
+        if (statement.empty()) {
+            break;
+        }
+        analyze_visitor_up->visit_global_block_statement(*statement);
+    }
+    auto result = analyze_visitor_up->end_program();
+    check_well_formed(result);
+    return result;
 }
 
 /**
@@ -132,7 +245,6 @@ AnalysisResult Analyzer::analyze_string(const std::string& data, const std::opti
  */
 void Analyzer::push_scope() {
     scope_stack_.emplace_front();
-    current_scope().block = tree::make<semantic::Block>();
 }
 
 /**
@@ -143,45 +255,49 @@ void Analyzer::pop_scope() {
 }
 
 /**
- * Adds a statement to the current scope.
+ * Adds a statement to the given block,
+ * expanding the source location annotation of the block to include the one of the statement.
  */
-void Analyzer::add_statement_to_current_scope(const tree::One<semantic::Statement>& statement) {
-    if (current_block().empty()) {
+void Analyzer::add_statement_to_block(
+    const tree::One<semantic::Block>& block, const tree::One<semantic::Statement>& statement) {
+    if (block.empty()) {
         throw error::AnalysisError{ "trying to add a statement but current block is empty" };
     }
 
-    // Add the statement to the current block
-    current_block()->statements.add(statement);
+    // Add the statement to the block
+    block->statements.add(statement);
 
     // Expand the source location annotation of the block to include the statement
     if (auto statement_sl = statement->get_annotation_ptr<parser::SourceLocation>()) {
-        if (auto block_sl = current_block()->get_annotation_ptr<parser::SourceLocation>()) {
+        if (auto block_sl = block->get_annotation_ptr<parser::SourceLocation>()) {
             block_sl->expand_to_include(statement_sl->range.first);
             block_sl->expand_to_include(statement_sl->range.last);
         } else {
-            current_block()->set_annotation<parser::SourceLocation>(*statement_sl);
+            block->set_annotation<parser::SourceLocation>(*statement_sl);
         }
     }
 }
 
 /**
- * Adds a variable to the current scope.
+ * Resolves a variable, looking it up from the innermost to the outermost scope.
+ * Returns empty if no variable by the given name exists.
  */
-void Analyzer::add_variable_to_current_scope(const tree::One<semantic::Variable>& variable) {
-    current_variables().add(variable);
+values::Value Analyzer::try_resolve_variable(const primitives::Symbol& name) const {
+    for (const auto& scope : scope_stack_) {
+        if (auto value = scope.variable_table.try_resolve(name); !value.empty()) {
+            return value;
+        }
+    }
+    return values::Value{};
 }
 
 /**
  * Resolves a variable.
  * Throws NameResolutionFailure if no variable by the given name exists.
  */
-values::Value Analyzer::resolve_variable(const std::string& name) const {
-    for (const auto& scope : scope_stack_) {
-        try {
-            return scope.variable_table.resolve(name);
-        } catch (const error::AnalysisError&) {
-            continue;
-        }
+values::Value Analyzer::resolve_variable(const primitives::Symbol& name) const {
+    if (auto value = try_resolve_variable(name); !value.empty()) {
+        return value;
     }
     throw resolver::NameResolutionFailure{ fmt::format("failed to resolve variable '{}'", name) };
 }
@@ -189,8 +305,9 @@ values::Value Analyzer::resolve_variable(const std::string& name) const {
 /**
  * Registers a variable.
  */
-void Analyzer::register_variable(const std::string& name, const values::Value& value) {
+void Analyzer::register_variable(const primitives::Symbol& name, const values::Value& value) {
     current_scope().variable_table.add(name, value);
+    add_to_configuration_hash(current_scope(), fmt::format("variable {} {}", name, value));
 }
 
 /**
@@ -211,6 +328,8 @@ values::Value Analyzer::resolve_function(const std::string& name, const values::
 void Analyzer::register_consteval_core_function(
     const std::string& name, const types::Types& param_types, const resolver::ConstEvalCoreFunction& function) {
     global_scope().consteval_core_function_table.add(name, param_types, function);
+    has_custom_functions_ = true;
+    add_to_configuration_hash(global_scope(), fmt::format("function {}({})", name, param_types));
 }
 
 /**
@@ -220,7 +339,40 @@ void Analyzer::register_consteval_core_function(
  */
 void Analyzer::register_consteval_core_function(
     const std::string& name, const std::string& param_types, const resolver::ConstEvalCoreFunction& function) {
-    global_scope().consteval_core_function_table.add(name, types::from_spec(param_types), function);
+    auto parsed_param_types = types::from_spec(param_types);
+    global_scope().consteval_core_function_table.add(name, parsed_param_types, function);
+    has_custom_functions_ = true;
+    add_to_configuration_hash(global_scope(), fmt::format("function {}({})", name, parsed_param_types));
+}
+
+/**
+ * Resolves a GateInstruction, looking it up from the innermost to the outermost scope.
+ * Returns empty if no instruction by the given name exists, or if no overload exists for the given arguments,
+ * otherwise returns the resolved instruction node.
+ */
+[[nodiscard]] tree::One<semantic::Instruction> Analyzer::try_resolve_instruction(
+    const std::string& name, const tree::One<semantic::Gate>& gate, const values::Values& args) const {
+    for (const auto& scope : scope_stack_) {
+        if (auto instruction = scope.instruction_table.try_resolve(name, gate, args); !instruction.empty()) {
+            return instruction;
+        }
+    }
+    return {};
+}
+
+/**
+ * Resolves a NonGateInstruction, looking it up from the innermost to the outermost scope.
+ * Returns empty if no instruction by the given name exists, or if no overload exists for the given arguments,
+ * otherwise returns the resolved instruction node.
+ */
+[[nodiscard]] tree::One<semantic::Instruction> Analyzer::try_resolve_instruction(
+    const std::string& name, const values::Values& args) const {
+    for (const auto& scope : scope_stack_) {
+        if (auto instruction = scope.instruction_table.try_resolve(name, args); !instruction.empty()) {
+            return instruction;
+        }
+    }
+    return {};
 }
 
 /**
@@ -232,12 +384,8 @@ void Analyzer::register_consteval_core_function(
  */
 [[nodiscard]] tree::One<semantic::Instruction> Analyzer::resolve_instruction(
     const std::string& name, const tree::One<semantic::Gate>& gate, const values::Values& args) const {
-    for (const auto& scope : scope_stack_) {
-        try {
-            return scope.instruction_table.resolve(name, gate, args);
-        } catch (const error::AnalysisError&) {
-            continue;
-        }
+    if (auto instruction = try_resolve_instruction(name, gate, args); !instruction.empty()) {
+        return instruction;
     }
     throw resolver::ResolutionFailure{ fmt::format(
         "failed to resolve instruction '{}' with argument pack ({})", name, values::types_of(args)) };
@@ -252,12 +400,8 @@ void Analyzer::register_consteval_core_function(
  */
 [[nodiscard]] tree::One<semantic::Instruction> Analyzer::resolve_instruction(
     const std::string& name, const values::Values& args) const {
-    for (const auto& scope : scope_stack_) {
-        try {
-            return scope.instruction_table.resolve(name, args);
-        } catch (const error::AnalysisError&) {
-            continue;
-        }
+    if (auto instruction = try_resolve_instruction(name, args); !instruction.empty()) {
+        return instruction;
     }
     throw resolver::ResolutionFailure{ fmt::format(
         "failed to resolve instruction '{}' with argument pack ({})", name, values::types_of(args)) };
@@ -268,6 +412,7 @@ void Analyzer::register_consteval_core_function(
  */
 void Analyzer::register_instruction(const instruction::Instruction& instruction) {
     current_scope().instruction_table.add(instruction);
+    add_to_configuration_hash(current_scope(), fmt::format("instruction {}", instruction));
 }
 
 /**
@@ -8,8 +8,12 @@
 
 namespace cqasm::v3x::parser {
 
-AntlrCustomErrorListener::AntlrCustomErrorListener(const std::optional<std::string>& file_name)
-: file_name_{ file_name } {
+AntlrCustomErrorListener::AntlrCustomErrorListener(const std::optional<std::string>& file_name) {
+    set_file_name(file_name);
+}
+
+void AntlrCustomErrorListener::set_file_name(const std::optional<std::string>& file_name) {
+    file_name_ = file_name;
     if (file_name_.has_value() && file_name_.value().empty()) {
         file_name_ = std::nullopt;
     }
@@ -17,6 +21,11 @@ AntlrCustomErrorListener::AntlrCustomErrorListener(const std::optional<std::stri
 
 void AntlrCustomErrorListener::syntaxError(antlr4::Recognizer* /* recognizer */, antlr4::Token* offending_symbol,
     size_t line, size_t char_position_in_line, const std::string& msg, std::exception_ptr /* e */) {
+    throw make_error(offending_symbol, line, char_position_in_line, msg);
+}
+
+error::ParseError AntlrCustomErrorListener::make_error(
+    antlr4::Token* offending_symbol, size_t line, size_t char_position_in_line, const std::string& msg) const {
     // ANTLR provides a zero-based character position in line
     // We change it here to a one-based index, which is the more human-readable,
     // and the common option in text editors
@@ -30,7 +39,7 @@ void AntlrCustomErrorListener::syntaxError(antlr4::Recognizer* /* recognizer */,
         : 0;
     auto end_column = start_column + token_size;
 
-    throw error::ParseError{
+    return error::ParseError{
         msg,
         file_name_,
         { { static_cast<std::uint32_t>(line), static_cast<std::uint32_t>(start_column) },
@@ -42,4 +51,26 @@ void AntlrCustomErrorListener::syntaxError(size_t line, size_t char_position_in_
     syntaxError(nullptr, nullptr, line, char_position_in_line, msg, nullptr);
 }
 
+AntlrErrorCollector::AntlrErrorCollector(const AntlrCustomErrorListener& error_listener, bool cancel)
+: AntlrCustomErrorListener{ error_listener }
+, cancel_{ cancel } {}
+
+void AntlrErrorCollector::syntaxError(antlr4::Recognizer* /* recognizer */, antlr4::Token* offending_symbol,
+    size_t line, size_t char_position_in_line, const std::string& msg, std::exception_ptr /* e */) {
+    errors_.push_back(
+        CollectedError{ line, char_position_in_line, make_error(offending_symbol, line, char_position_in_line, msg) });
+    if (cancel_) {
+        throw antlr4::ParseCancellationException{};
+    }
+}
+
+std::vector<AntlrErrorCollector::CollectedError>& AntlrErrorCollector::errors() {
+    return errors_;
+}
+
+void BailErrorListener::syntaxError(antlr4::Recognizer* /* recognizer */, antlr4::Token* /* offending_symbol */,
+    size_t /* line */, size_t /* char_position_in_line */, const std::string& /* msg */, std::exception_ptr /* e */) {
+    throw antlr4::ParseCancellationException{};
+}
+
 }  // namespace cqasm::v3x::parser
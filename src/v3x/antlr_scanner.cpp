@@ -3,38 +3,142 @@
 #include <antlr4-runtime.h>
 #include <fmt/format.h>
 
-#include <filesystem>
+#include <algorithm>  // max
+#include <thread>
 
 #include "libqasm/v3x/CqasmLexer.h"
 #include "libqasm/v3x/CqasmParser.h"
 #include "libqasm/v3x/antlr_custom_error_listener.hpp"
+#include "libqasm/v3x/chunked_parser.hpp"
+#include "libqasm/v3x/cqasm_fast_lexer.hpp"
 #include "libqasm/v3x/parse_result.hpp"
+#include "libqasm/v3x/prediction_telemetry.hpp"
+#include "libqasm/v3x/statement_parser.hpp"
 #include "libqasm/v3x/syntactic.hpp"
 #include "libqasm/v3x/syntactic_analyzer.hpp"
-
-namespace fs = std::filesystem;
+#include "libqasm/v3x/utf8_char_stream.hpp"
 
 namespace cqasm::v3x::parser {
 
 ScannerAdaptor::~ScannerAdaptor() = default;
 
 AntlrScanner::AntlrScanner(std::unique_ptr<BaseSyntacticAnalyzer> build_visitor_up,
-    std::unique_ptr<AntlrCustomErrorListener> error_listener_up)
+    std::unique_ptr<AntlrCustomErrorListener> error_listener_up, const ParseOptions& options)
 : build_visitor_up_{ std::move(build_visitor_up) }
-, error_listener_up_{ std::move(error_listener_up) } {}
+, error_listener_up_{ std::move(error_listener_up) }
+, options_{ options } {}
 
 AntlrScanner::~AntlrScanner() = default;
 
-cqasm::v3x::parser::ParseResult AntlrScanner::parse_(antlr4::ANTLRInputStream& is) {
-    CqasmLexer lexer{ &is };
-    lexer.removeErrorListeners();
-    lexer.addErrorListener(error_listener_up_.get());
-    antlr4::CommonTokenStream tokens{ &lexer };
+std::unique_ptr<antlr4::TokenSource> create_lexer(
+    antlr4::CharStream& is, antlr4::ANTLRErrorListener* error_listener, LexerType lexer_type) {
+    if (lexer_type == LexerType::hand_written) {
+        auto lexer_up = std::make_unique<CqasmFastLexer>(&is);
+        lexer_up->removeErrorListeners();
+        lexer_up->addErrorListener(error_listener);
+        return lexer_up;
+    }
+    auto lexer_up = std::make_unique<CqasmLexer>(&is);
+    lexer_up->removeErrorListeners();
+    lexer_up->addErrorListener(error_listener);
+    return lexer_up;
+}
+
+cqasm::v3x::parser::ParseResult parse_with_recovery(antlr4::CommonTokenStream& tokens,
+    AntlrErrorCollector& lexer_error_collector, BaseSyntacticAnalyzer& build_visitor,
+    AntlrCustomErrorListener& error_listener, ExpressionParserType expression_parser) {
+    auto recovered_chunk = parse_statements_with_recovery(
+        tokens, lexer_error_collector, true, build_visitor, error_listener, expression_parser);
+    auto program = tree::make<syntactic::Program>();
+    program->version = recovered_chunk.parsed_chunk.version;
+    program->block = tree::make<syntactic::GlobalBlock>();
+    program->block->statements = std::move(recovered_chunk.parsed_chunk.statements);
+    return cqasm::v3x::parser::ParseResult{
+        program,  // root
+        std::move(recovered_chunk.errors)  // errors
+    };
+}
+
+cqasm::v3x::parser::ParseResult AntlrScanner::parse_(antlr4::CharStream& is) {
+    if (options_.recover_from_errors) {
+        return parse_with_recovery_(is);
+    }
+    if (options_.build_mode == BuildMode::statement_by_statement) {
+        try {
+            return parse_statement_by_statement_(is);
+        } catch (const antlr4::ParseCancellationException&) {
+            is.seek(0);
+        } catch (const cqasm::error::ParseError&) {
+            // Values out of range are reported while building the syntactic AST
+            // In the parse_tree mode, they are only reported if there are no syntax errors in the whole program
+            is.seek(0);
+        }
+    }
+    if (options_.prediction_strategy == PredictionStrategy::sll_then_ll) {
+        auto& telemetry = PredictionTelemetry::get_instance();
+        telemetry.record_sll_parse();
+        try {
+            return parse_tokens_(is, true);
+        } catch (const antlr4::ParseCancellationException&) {
+            telemetry.record_ll_fallback();
+            is.seek(0);
+        }
+    }
+    return parse_tokens_(is, false);
+}
+
+/**
+ * In the parallel_chunks build mode,
+ * parses UTF-8 input split into as many chunks as there are hardware threads, concurrently.
+ * Returns an empty optional in other build modes,
+ * or if the input contains an error, so that it can be parsed again to report it.
+ */
+std::optional<cqasm::v3x::parser::ParseResult> AntlrScanner::parse_chunks_(std::string_view data) {
+    if (options_.build_mode != BuildMode::parallel_chunks) {
+        return std::nullopt;
+    }
+    auto chunk_starts =
+        find_chunk_starts(data, std::max<size_t>(std::thread::hardware_concurrency(), 1), min_chunk_size);
+    build_visitor_up_->addErrorListener(error_listener_up_.get());
+    try {
+        return cqasm::v3x::parser::ParseResult{
+            parse_chunks(data, chunk_starts, *build_visitor_up_, options_),  // root
+            {}  // error
+        };
+    } catch (const antlr4::ParseCancellationException&) {
+    } catch (const cqasm::error::ParseError&) {
+        // Values out of range are reported while building the syntactic AST
+        // In the parse_tree mode, they are only reported if there are no syntax errors in the whole program
+    }
+    return std::nullopt;
+}
+
+/**
+ * Parses the input stream with either SLL or full LL prediction.
+ * SLL parsing throws a ParseCancellationException at the first lexer or parser error, without reporting it.
+ */
+cqasm::v3x::parser::ParseResult AntlrScanner::parse_tokens_(antlr4::CharStream& is, bool sll) {
+    BailErrorListener bail_error_listener{};
+    auto* error_listener = sll ? static_cast<antlr4::ANTLRErrorListener*>(&bail_error_listener)
+                               : static_cast<antlr4::ANTLRErrorListener*>(error_listener_up_.get());
+    auto lexer_up = create_lexer(is, error_listener, options_.lexer_type);
+    antlr4::CommonTokenStream tokens{ lexer_up.get() };
 
     CqasmParser parser{ &tokens };
     parser.removeErrorListeners();
-    parser.addErrorListener(error_listener_up_.get());
+    parser.addErrorListener(error_listener);
+    if (options_.profile_prediction) {
+        parser.setProfile(true);
+    }
+    if (sll) {
+        parser.setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+        parser.getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(
+            antlr4::atn::PredictionMode::SLL);
+    }
     auto ast = parser.program();
+    if (options_.profile_prediction) {
+        PredictionTelemetry::get_instance().record_predictions(parser);
+    }
 
     build_visitor_up_->addErrorListener(error_listener_up_.get());
     auto custom_ast = build_visitor_up_->visitProgram(ast);
@@ -44,32 +148,54 @@ cqasm::v3x::parser::ParseResult AntlrScanner::parse_(antlr4::ANTLRInputStream& i
     };
 }
 
-FileAntlrScanner::FileAntlrScanner(std::unique_ptr<BaseSyntacticAnalyzer> build_visitor_up,
-    std::unique_ptr<AntlrCustomErrorListener> error_listener_up, std::string file_path)
-: AntlrScanner{ std::move(build_visitor_up), std::move(error_listener_up) }
-, file_path_{ std::move(file_path) } {
-    if (!fs::exists(file_path_) || !fs::is_regular_file(file_path_)) {
-        throw cqasm::error::ParseError{ fmt::format("FileAntlrScanner couldn't access file '{}'.", file_path_) };
+/**
+ * Parses the input stream one statement at a time, using a StatementParser.
+ * Throws a ParseCancellationException at the first lexer or parser error, without reporting it.
+ */
+cqasm::v3x::parser::ParseResult AntlrScanner::parse_statement_by_statement_(antlr4::CharStream& is) {
+    BailErrorListener bail_error_listener{};
+    auto lexer_up = create_lexer(is, &bail_error_listener, options_.lexer_type);
+    antlr4::CommonTokenStream tokens{ lexer_up.get() };
+
+    build_visitor_up_->addErrorListener(error_listener_up_.get());
+    StatementParser statement_parser{ tokens, *build_visitor_up_, &bail_error_listener,
+        options_.prediction_strategy == PredictionStrategy::sll_then_ll, options_.expression_parser };
+    auto program = tree::make<syntactic::Program>();
+    program->version = statement_parser.parse_version();
+    program->block = tree::make<syntactic::GlobalBlock>();
+    for (auto statement = statement_parser.parse_statement(); !statement.empty();
+         statement = statement_parser.parse_statement()) {
+        program->block->statements.add(statement);
     }
+    return cqasm::v3x::parser::ParseResult{
+        program,  // root
+        {}  // error
+    };
 }
 
-FileAntlrScanner::~FileAntlrScanner() = default;
-
-cqasm::v3x::parser::ParseResult FileAntlrScanner::parse() {
-    antlr4::ANTLRFileStream ifs{};
-    ifs.loadFromFile(file_path_);
-    return parse_(ifs);
+/**
+ * Parses the input stream one statement at a time, collecting all the errors.
+ */
+cqasm::v3x::parser::ParseResult AntlrScanner::parse_with_recovery_(antlr4::CharStream& is) {
+    AntlrErrorCollector lexer_error_collector{ *error_listener_up_, false };
+    auto lexer_up = create_lexer(is, &lexer_error_collector, options_.lexer_type);
+    antlr4::CommonTokenStream tokens{ lexer_up.get() };
+    return parse_with_recovery(
+        tokens, lexer_error_collector, *build_visitor_up_, *error_listener_up_, options_.expression_parser);
 }
 
-StringAntlrScanner::StringAntlrScanner(std::unique_ptr<BaseSyntacticAnalyzer> build_visitor_up,
-    std::unique_ptr<AntlrCustomErrorListener> error_listener_up, std::string data)
-: AntlrScanner{ std::move(build_visitor_up), std::move(error_listener_up) }
-, data_{ std::move(data) } {}
+StringViewAntlrScanner::StringViewAntlrScanner(std::unique_ptr<BaseSyntacticAnalyzer> build_visitor_up,
+    std::unique_ptr<AntlrCustomErrorListener> error_listener_up, std::string_view data, const ParseOptions& options)
+: AntlrScanner{ std::move(build_visitor_up), std::move(error_listener_up), options }
+, data_{ data } {}
 
-StringAntlrScanner::~StringAntlrScanner() = default;
+StringViewAntlrScanner::~StringViewAntlrScanner() = default;
 
-cqasm::v3x::parser::ParseResult StringAntlrScanner::parse() {
-    antlr4::ANTLRInputStream is{ data_ };
+cqasm::v3x::parser::ParseResult StringViewAntlrScanner::parse() {
+    if (auto result = parse_chunks_(data_); result.has_value()) {
+        return std::move(*result);
+    }
+    Utf8CharStream is{ data_ };
     return parse_(is);
 }
 
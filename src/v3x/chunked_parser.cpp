@@ -0,0 +1,349 @@
+/** \file
+ * Implementation for \ref include/libqasm/v3x/chunked_parser.hpp "libqasm/v3x/chunked_parser.hpp".
+ */
+
+#include "libqasm/v3x/chunked_parser.hpp"
+
+#include <antlr4-runtime.h>
+
+#include <algorithm>  // any_of, max, stable_sort
+#include <condition_variable>
+#include <deque>
+#include <functional>  // function
+#include <future>  // future, packaged_task
+#include <memory>  // make_shared, unique_ptr
+#include <mutex>  // scoped_lock, unique_lock
+#include <thread>
+#include <tuple>  // tie
+#include <utility>  // make_pair, move, pair
+#include <vector>
+
+#include "libqasm/arena.hpp"
+#include "libqasm/v3x/CqasmLexer.h"
+#include "libqasm/v3x/antlr_custom_error_listener.hpp"
+#include "libqasm/v3x/antlr_scanner.hpp"
+#include "libqasm/v3x/cqasm_fast_lexer.hpp"
+#include "libqasm/v3x/statement_parser.hpp"
+#include "libqasm/v3x/utf8_char_stream.hpp"
+
+namespace cqasm::v3x::parser {
+
+namespace {
+
+/**
+ * Process-wide pool of the threads parsing the chunks of the parallel_chunks build mode.
+ * The threads are started on first use, and reused by every parse, so a parse does not start any thread.
+ * Without threads, e.g. in WebAssembly builds, tasks are run by the thread submitting them.
+ */
+class ChunkWorkerPool {
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> threads_;
+
+    void run() {
+        while (true) {
+            std::function<void()> task{};
+            {
+                std::unique_lock lock{ mutex_ };
+                condition_.wait(lock, [this]() { return !tasks_.empty(); });
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+public:
+    explicit ChunkWorkerPool(size_t number_of_threads) {
+        for (size_t i = 0; i < number_of_threads; ++i) {
+            threads_.emplace_back([this]() { run(); });
+        }
+    }
+
+    /**
+     * Parses a chunk on one of the threads of the pool.
+     * The returned future does not wait for the chunk to be parsed when destroyed.
+     */
+    std::future<ParsedChunk> submit(std::function<ParsedChunk()> function) {
+        auto task = std::make_shared<std::packaged_task<ParsedChunk()>>(std::move(function));
+        auto ret = task->get_future();
+        if (threads_.empty()) {
+            (*task)();
+            return ret;
+        }
+        {
+            std::scoped_lock lock{ mutex_ };
+            tasks_.emplace_back([task]() { (*task)(); });
+        }
+        condition_.notify_one();
+        return ret;
+    }
+};
+
+ChunkWorkerPool& chunk_worker_pool() {
+#ifdef __EMSCRIPTEN__
+    // WebAssembly builds do not use threads, so the other chunks are parsed before the first one
+    static constexpr size_t number_of_threads = 0;
+#else
+    static const size_t number_of_threads = std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1;
+#endif
+    // Leaked on purpose, as its threads never finish
+    static auto* pool = new ChunkWorkerPool{ number_of_threads };
+    return *pool;
+}
+
+/**
+ * Makes a lexer start tokenizing at the position of the start of a chunk.
+ */
+template <typename Lexer>
+void set_start_position(Lexer& lexer, const ChunkStart& chunk_start) {
+    lexer.setLine(chunk_start.line);
+    lexer.setCharPositionInLine(chunk_start.char_position_in_line);
+}
+
+/**
+ * Creates a lexer of the given type over a chunk, reporting errors to the given listener.
+ */
+std::unique_ptr<antlr4::TokenSource> create_chunk_lexer(antlr4::CharStream& is, const ChunkStart& chunk_start,
+    antlr4::ANTLRErrorListener* error_listener, LexerType lexer_type) {
+    auto lexer_up = create_lexer(is, error_listener, lexer_type);
+    if (lexer_type == LexerType::hand_written) {
+        set_start_position(static_cast<CqasmFastLexer&>(*lexer_up), chunk_start);
+    } else {
+        set_start_position(static_cast<CqasmLexer&>(*lexer_up), chunk_start);
+    }
+    return lexer_up;
+}
+
+}  // namespace
+
+NewLineScanner::NewLineScanner(std::string_view data, const ChunkStart& start)
+: data_{ data }
+, index_{ start.offset }
+, line_{ start.line }
+, char_position_in_line_{ start.char_position_in_line } {}
+
+std::optional<ChunkStart> NewLineScanner::next() {
+    while (index_ < data_.size()) {
+        auto i = index_++;
+        auto c = data_[i];
+        if (c == '\n') {
+            if (state_ == State::single_line_comment) {
+                state_ = State::code;
+            }
+            std::optional<ChunkStart> ret{};
+            if (state_ == State::code) {
+                // A '\r\n' new line is a single NEW_LINE token, which starts at the '\r'
+                ret = (i > 0 && data_[i - 1] == '\r') ? ChunkStart{ i - 1, line_, char_position_in_line_ - 1 }
+                                                      : ChunkStart{ i, line_, char_position_in_line_ };
+            }
+            ++line_;
+            char_position_in_line_ = 0;
+            if (ret.has_value()) {
+                return ret;
+            }
+            continue;
+        }
+        // Character positions are counted in code points, so UTF-8 continuation bytes are not counted
+        if ((static_cast<unsigned char>(c) & 0xC0) != 0x80) {
+            ++char_position_in_line_;
+        }
+        // Comment and raw text string delimiters are ASCII, so they can be skipped byte by byte
+        auto lookahead = data_.substr(i, 3);
+        auto skip = [this](size_t count) {
+            index_ += count;
+            char_position_in_line_ += count;
+        };
+        switch (state_) {
+            case State::code:
+                if (lookahead.starts_with("//")) {
+                    state_ = State::single_line_comment;
+                } else if (lookahead.starts_with("/*")) {
+                    state_ = State::multi_line_comment;
+                    skip(1);
+                } else if (lookahead == "'''") {
+                    state_ = State::raw_text_string;
+                    skip(2);
+                }
+                break;
+            case State::multi_line_comment:
+                if (lookahead.starts_with("*/")) {
+                    state_ = State::code;
+                    skip(1);
+                }
+                break;
+            case State::raw_text_string:
+                if (lookahead == "'''") {
+                    state_ = State::code;
+                    skip(2);
+                }
+                break;
+            case State::single_line_comment:
+                break;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<ChunkStart> find_chunk_starts(std::string_view data, size_t max_number_of_chunks, size_t min_size) {
+    std::vector<ChunkStart> ret{ ChunkStart{} };
+    auto chunk_size = std::max(min_size, data.size() / std::max(max_number_of_chunks, size_t{ 1 }));
+    NewLineScanner scanner{ data, ret.back() };
+    while (ret.size() < max_number_of_chunks) {
+        auto new_line = scanner.next();
+        if (!new_line.has_value()) {
+            break;
+        }
+        if (new_line->offset >= ret.back().offset + chunk_size && data.size() - new_line->offset >= min_size) {
+            ret.push_back(*new_line);
+        }
+    }
+    return ret;
+}
+
+ParsedChunk parse_chunk(std::string_view data, const ChunkStart& chunk_start, bool is_first_chunk,
+    BaseSyntacticAnalyzer& builder_visitor, const ParseOptions& options) {
+    BailErrorListener bail_error_listener{};
+    Utf8CharStream is{ data };
+    auto lexer_up = create_chunk_lexer(is, chunk_start, &bail_error_listener, options.lexer_type);
+    antlr4::CommonTokenStream tokens{ lexer_up.get() };
+
+    StatementParser statement_parser{ tokens, builder_visitor, &bail_error_listener,
+        options.prediction_strategy == PredictionStrategy::sll_then_ll, options.expression_parser };
+    ParsedChunk ret{};
+    if (is_first_chunk) {
+        ret.version = statement_parser.parse_version();
+    }
+    for (auto statement = statement_parser.parse_statement(); !statement.empty();
+         statement = statement_parser.parse_statement()) {
+        ret.statements.add(statement);
+    }
+    return ret;
+}
+
+/**
+ * Parser errors are dropped when a lexer error has been found within the same statement,
+ * as they are most likely caused by the lexer error.
+ */
+RecoveredChunk parse_statements_with_recovery(antlr4::CommonTokenStream& tokens,
+    AntlrErrorCollector& lexer_error_collector, bool is_first_chunk, BaseSyntacticAnalyzer& builder_visitor,
+    AntlrCustomErrorListener& error_listener, ExpressionParserType expression_parser) {
+    AntlrErrorCollector parser_error_collector{ error_listener, true };
+    auto& lexer_errors = lexer_error_collector.errors();
+    auto& parser_errors = parser_error_collector.errors();
+
+    builder_visitor.addErrorListener(&parser_error_collector);
+    StatementParser statement_parser{ tokens, builder_visitor, &parser_error_collector, false, expression_parser };
+    auto next_token_position = [&tokens]() {
+        const auto* token = tokens.LT(1);
+        return std::make_pair(token->getLine(), token->getCharPositionInLine());
+    };
+    // A lexer error only causes the parser error of the statement whose token range contains it
+    auto recover = [&](const std::pair<size_t, size_t>& statement_start) {
+        statement_parser.skip_statement();
+        auto statement_end = next_token_position();
+        if (std::any_of(lexer_errors.begin(), lexer_errors.end(), [&](const auto& lexer_error) {
+                auto position = std::make_pair(lexer_error.line, lexer_error.char_position_in_line);
+                return statement_start <= position && position < statement_end;
+            })) {
+            parser_errors.pop_back();
+        }
+    };
+    ParsedChunk parsed_chunk{};
+    auto statement_start = next_token_position();
+    if (is_first_chunk) {
+        try {
+            parsed_chunk.version = statement_parser.parse_version();
+        } catch (const antlr4::ParseCancellationException&) {
+            recover(statement_start);
+        }
+    }
+    while (true) {
+        statement_start = next_token_position();
+        try {
+            auto statement = statement_parser.parse_statement();
+            if (statement.empty()) {
+                break;
+            }
+            parsed_chunk.statements.add(statement);
+        } catch (const antlr4::ParseCancellationException&) {
+            recover(statement_start);
+        }
+    }
+    builder_visitor.addErrorListener(&error_listener);
+    auto chunk_end = next_token_position();
+
+    // The lexer runs ahead of the parser, so errors are sorted in source order
+    auto errors = std::move(lexer_errors);
+    errors.insert(errors.end(), parser_errors.begin(), parser_errors.end());
+    std::stable_sort(errors.begin(), errors.end(), [](const auto& lhs, const auto& rhs) {
+        return std::tie(lhs.line, lhs.char_position_in_line) < std::tie(rhs.line, rhs.char_position_in_line);
+    });
+    RecoveredChunk ret{};
+    ret.parsed_chunk = std::move(parsed_chunk);
+    for (auto& error : errors) {
+        if (std::make_pair(error.line, error.char_position_in_line) >= chunk_end) {
+            ret.has_error_at_end = true;
+        }
+        ret.errors.push_back(std::move(error.error));
+    }
+    return ret;
+}
+
+RecoveredChunk parse_chunk_with_recovery(std::string_view data, const ChunkStart& chunk_start, bool is_first_chunk,
+    BaseSyntacticAnalyzer& builder_visitor, AntlrCustomErrorListener& error_listener, const ParseOptions& options) {
+    AntlrErrorCollector lexer_error_collector{ error_listener, false };
+    Utf8CharStream is{ data };
+    auto lexer_up = create_chunk_lexer(is, chunk_start, &lexer_error_collector, options.lexer_type);
+    antlr4::CommonTokenStream tokens{ lexer_up.get() };
+    return parse_statements_with_recovery(
+        tokens, lexer_error_collector, is_first_chunk, builder_visitor, error_listener, options.expression_parser);
+}
+
+syntactic::One<syntactic::Program> parse_chunks(std::string_view data, const std::vector<ChunkStart>& chunk_starts,
+    BaseSyntacticAnalyzer& builder_visitor, const ParseOptions& options) {
+    auto get_chunk_data = [&data, &chunk_starts](size_t index) {
+        auto offset = chunk_starts[index].offset;
+        auto end = index + 1 < chunk_starts.size() ? chunk_starts[index + 1].offset : data.size();
+        return data.substr(offset, end - offset);
+    };
+    // An arena can only be allocated from by one thread at a time,
+    // so the other chunks are allocated from an arena of their own, if the first one is allocated from an arena
+    auto use_arena = tree::Arena::current() != nullptr;
+    std::vector<std::future<ParsedChunk>> futures;
+    // The other chunks refer to the data, the chunk starts, and the builder visitor,
+    // so they are waited for before returning, also if parsing the first chunk throws
+    struct FuturesWaiter {
+        std::vector<std::future<ParsedChunk>>& futures;
+        ~FuturesWaiter() {
+            for (const auto& future : futures) {
+                if (future.valid()) {
+                    future.wait();
+                }
+            }
+        }
+    } futures_waiter{ futures };
+    for (size_t i = 1; i < chunk_starts.size(); ++i) {
+        futures.push_back(chunk_worker_pool().submit(
+            [use_arena, chunk_data = get_chunk_data(i), &chunk_start = chunk_starts[i], &builder_visitor, &options]() {
+                tree::ArenaScope arena_scope{ use_arena ? std::make_shared<tree::Arena>() : nullptr };
+                return parse_chunk(chunk_data, chunk_start, false, builder_visitor, options);
+            }));
+    }
+    auto first_chunk = parse_chunk(get_chunk_data(0), chunk_starts[0], true, builder_visitor, options);
+
+    auto program = tree::make<syntactic::Program>();
+    program->version = first_chunk.version;
+    program->block = tree::make<syntactic::GlobalBlock>();
+    program->block->statements = std::move(first_chunk.statements);
+    for (auto& future : futures) {
+        auto chunk = future.get();
+        for (const auto& statement : chunk.statements) {
+            program->block->statements.add(statement);
+        }
+    }
+    return program;
+}
+
+}  // namespace cqasm::v3x::parser
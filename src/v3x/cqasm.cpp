@@ -36,10 +36,12 @@ tree::One<cqasm::v3x::semantic::Program> analyze_string(
     return analysis_result.unwrap();
 }
 
+namespace {
+
 /**
- * Constructs an Analyzer object with the defaults for cQASM 3.0 already loaded into it.
+ * Constructs an Analyzer object and registers the defaults for cQASM 3.0 into it.
  */
-analyzer::Analyzer default_analyzer(const std::string& api_version) {
+analyzer::Analyzer make_default_analyzer(const std::string& api_version) {
     analyzer::Analyzer analyzer{ api_version };
 
     analyzer.register_default_constants();
@@ -49,4 +51,27 @@ analyzer::Analyzer default_analyzer(const std::string& api_version) {
     return analyzer;
 }
 
+/**
+ * Returns an Analyzer object with the defaults for cQASM 3.0 loaded into it.
+ * It is built the first time it is needed, and never modified afterwards.
+ */
+const analyzer::Analyzer& default_analyzer_prototype() {
+    static const analyzer::Analyzer prototype = make_default_analyzer("3.0");
+    return prototype;
+}
+
+}  // namespace
+
+/**
+ * Constructs an Analyzer object with the defaults for cQASM 3.0 already loaded into it.
+ * The defaults are shared with a prototype analyzer, and only copied if the returned analyzer registers something else.
+ */
+analyzer::Analyzer default_analyzer(const std::string& api_version) {
+    const auto& prototype = default_analyzer_prototype();
+    if (prototype.api_version == api_version) {
+        return analyzer::Analyzer{ prototype };
+    }
+    return make_default_analyzer(api_version);
+}
+
 }  // namespace cqasm::v3x
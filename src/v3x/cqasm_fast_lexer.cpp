@@ -0,0 +1,559 @@
+/** \file
+ * Implementation for \ref include/libqasm/v3x/cqasm_fast_lexer.hpp "libqasm/v3x/cqasm_fast_lexer.hpp".
+ */
+
+#include "libqasm/v3x/cqasm_fast_lexer.hpp"
+
+#include <algorithm>  // count
+#include <array>
+#include <cstdint>  // uint8_t
+#include <string_view>
+
+#include "libqasm/v3x/CqasmLexer.h"
+#include "libqasm/v3x/utf8_char_stream.hpp"
+
+namespace cqasm::v3x::parser {
+
+namespace {
+
+/**
+ * Token type returned by the match functions when no token has to be emitted,
+ * i.e. for skipped input (white spaces and comments) and after a token recognition error.
+ */
+constexpr size_t no_token = antlr4::Token::INVALID_TYPE;
+
+/**
+ * What to do when a given character is found at the start of a token.
+ */
+enum class Action : std::uint8_t {
+    error,  // not the start of any token
+    white_space,  // [ \t]+
+    new_line,  // '\n'
+    carriage_return,  // '\r' '\n'
+    single_char,  // single character token, maybe followed by a second character (e.g. '<' and '<=')
+    slash,  // '/', '//' comment, or '/*' comment
+    quote,  // ''', or raw text string
+    dot,  // '.', or float literal
+    digit,  // integer or float literal
+    letter  // identifier or keyword
+};
+
+struct CharInfo {
+    Action action = Action::error;
+    size_t token_type = antlr4::Token::INVALID_TYPE;
+};
+
+constexpr std::array<CharInfo, 128> make_char_table() {
+    std::array<CharInfo, 128> ret{};
+    ret[' '] = { Action::white_space };
+    ret['\t'] = { Action::white_space };
+    ret['\n'] = { Action::new_line };
+    ret['\r'] = { Action::carriage_return };
+    ret['/'] = { Action::slash };
+    ret['\''] = { Action::quote };
+    ret['.'] = { Action::dot };
+    for (auto c = '0'; c <= '9'; ++c) {
+        ret[c] = { Action::digit };
+    }
+    for (auto c = 'a'; c <= 'z'; ++c) {
+        ret[c] = { Action::letter };
+    }
+    for (auto c = 'A'; c <= 'Z'; ++c) {
+        ret[c] = { Action::letter };
+    }
+    ret['_'] = { Action::letter };
+    ret[';'] = { Action::single_char, CqasmLexer::SEMICOLON };
+    ret[':'] = { Action::single_char, CqasmLexer::COLON };
+    ret[','] = { Action::single_char, CqasmLexer::COMMA };
+    ret['='] = { Action::single_char, CqasmLexer::EQUALS };
+    ret['['] = { Action::single_char, CqasmLexer::OPEN_BRACKET };
+    ret[']'] = { Action::single_char, CqasmLexer::CLOSE_BRACKET };
+    ret['('] = { Action::single_char, CqasmLexer::OPEN_PARENS };
+    ret[')'] = { Action::single_char, CqasmLexer::CLOSE_PARENS };
+    ret['+'] = { Action::single_char, CqasmLexer::PLUS };
+    ret['-'] = { Action::single_char, CqasmLexer::MINUS };
+    ret['~'] = { Action::single_char, CqasmLexer::BITWISE_NOT_OP };
+    ret['!'] = { Action::single_char, CqasmLexer::LOGICAL_NOT_OP };
+    ret['*'] = { Action::single_char, CqasmLexer::PRODUCT_OP };
+    ret['%'] = { Action::single_char, CqasmLexer::MODULO_OP };
+    ret['<'] = { Action::single_char, CqasmLexer::CMP_LT_OP };
+    ret['>'] = { Action::single_char, CqasmLexer::CMP_GT_OP };
+    ret['&'] = { Action::single_char, CqasmLexer::BITWISE_AND_OP };
+    ret['^'] = { Action::single_char, CqasmLexer::BITWISE_XOR_OP };
+    ret['|'] = { Action::single_char, CqasmLexer::BITWISE_OR_OP };
+    ret['?'] = { Action::single_char, CqasmLexer::TERNARY_CONDITIONAL_OP };
+    return ret;
+}
+
+constexpr std::array<CharInfo, 128> char_table = make_char_table();
+
+[[nodiscard]] constexpr Action get_action(size_t c) {
+    return c < char_table.size() ? char_table[c].action : Action::error;
+}
+
+[[nodiscard]] constexpr bool is_digit(size_t c) {
+    return c >= '0' && c <= '9';
+}
+
+[[nodiscard]] constexpr bool is_letter_or_digit(size_t c) {
+    auto action = get_action(c);
+    return action == Action::letter || action == Action::digit;
+}
+
+[[nodiscard]] constexpr bool is_white_space(size_t c) {
+    return c == ' ' || c == '\t';
+}
+
+/**
+ * Returns the token type of a two character operator, or INVALID_TYPE if the two characters do not form one.
+ */
+[[nodiscard]] constexpr size_t get_two_char_token_type(size_t first, size_t second) {
+    struct TwoCharToken {
+        char first;
+        char second;
+        size_t token_type;
+    };
+    constexpr std::array<TwoCharToken, 10> two_char_tokens{ {
+        { '*', '*', CqasmLexer::POWER_OP },
+        { '<', '<', CqasmLexer::SHL_OP },
+        { '>', '>', CqasmLexer::SHR_OP },
+        { '>', '=', CqasmLexer::CMP_GE_OP },
+        { '<', '=', CqasmLexer::CMP_LE_OP },
+        { '=', '=', CqasmLexer::CMP_EQ_OP },
+        { '!', '=', CqasmLexer::CMP_NE_OP },
+        { '&', '&', CqasmLexer::LOGICAL_AND_OP },
+        { '^', '^', CqasmLexer::LOGICAL_XOR_OP },
+        { '|', '|', CqasmLexer::LOGICAL_OR_OP },
+    } };
+    for (const auto& token : two_char_tokens) {
+        if (static_cast<size_t>(token.first) == first && static_cast<size_t>(token.second) == second) {
+            return token.token_type;
+        }
+    }
+    return no_token;
+}
+
+struct Keyword {
+    std::string_view text;
+    size_t token_type;
+};
+
+constexpr std::array<Keyword, 14> keywords{ {
+    { "version", CqasmLexer::VERSION },
+    { "measure", CqasmLexer::MEASURE },
+    { "reset", CqasmLexer::RESET },
+    { "init", CqasmLexer::INIT },
+    { "barrier", CqasmLexer::BARRIER },
+    { "wait", CqasmLexer::WAIT },
+    { "inv", CqasmLexer::INV },
+    { "pow", CqasmLexer::POW },
+    { "ctrl", CqasmLexer::CTRL },
+    { "qubit", CqasmLexer::QUBIT_TYPE },
+    { "bit", CqasmLexer::BIT_TYPE },
+    { "asm", CqasmLexer::ASM },
+    { "true", CqasmLexer::BOOLEAN_LITERAL },
+    { "false", CqasmLexer::BOOLEAN_LITERAL },
+} };
+
+constexpr size_t max_keyword_size = 7;
+
+/**
+ * Returns the token type of a keyword, or IDENTIFIER if text is not a keyword.
+ */
+[[nodiscard]] size_t get_identifier_token_type(std::string_view text) {
+    for (const auto& keyword : keywords) {
+        if (keyword.text == text) {
+            return keyword.token_type;
+        }
+    }
+    return CqasmLexer::IDENTIFIER;
+}
+
+/**
+ * Same as antlr4::Lexer::getErrorDisplay.
+ */
+[[nodiscard]] std::string get_error_display(const std::string& text) {
+    std::string ret{};
+    ret.reserve(text.size());
+    for (auto c : text) {
+        switch (c) {
+            case '\n': ret += "\\n"; break;
+            case '\t': ret += "\\t"; break;
+            case '\r': ret += "\\r"; break;
+            default: ret += c; break;
+        }
+    }
+    return ret;
+}
+
+/**
+ * Keeps the characters of the token being matched available for unbuffered input streams.
+ */
+class MarkGuard {
+    antlr4::CharStream* input_;
+    ssize_t marker_;
+
+public:
+    explicit MarkGuard(antlr4::CharStream* input)
+    : input_{ input }
+    , marker_{ input->mark() } {}
+    ~MarkGuard() { input_->release(marker_); }
+    MarkGuard(const MarkGuard&) = delete;
+    MarkGuard& operator=(const MarkGuard&) = delete;
+};
+
+}  // namespace
+
+CqasmFastLexer::CqasmFastLexer(antlr4::CharStream* input)
+: input_{ input }
+, utf8_input_{ dynamic_cast<Utf8CharStream*>(input) }
+, token_factory_source_pair_{ this, input }
+, factory_{ antlr4::CommonTokenFactory::DEFAULT.get() }
+, error_listeners_{ &antlr4::ConsoleErrorListener::INSTANCE } {}
+
+CqasmFastLexer::~CqasmFastLexer() = default;
+
+void CqasmFastLexer::reset() {
+    input_->seek(0);
+    line_ = 1;
+    char_position_in_line_ = 0;
+    version_statement_mode_ = false;
+}
+
+void CqasmFastLexer::setLine(size_t line) {
+    line_ = line;
+}
+
+void CqasmFastLexer::setCharPositionInLine(size_t char_position_in_line) {
+    char_position_in_line_ = char_position_in_line;
+}
+
+std::unique_ptr<antlr4::Token> CqasmFastLexer::nextToken() {
+    MarkGuard mark_guard{ input_ };
+    while (true) {
+        token_start_char_index_ = input_->index();
+        token_start_line_ = line_;
+        token_start_char_position_in_line_ = char_position_in_line_;
+        if (input_->LA(1) == antlr4::Token::EOF) {
+            return emit(antlr4::Token::EOF);
+        }
+        auto type = version_statement_mode_ ? match_version_statement_mode() : match_default_mode();
+        if (type != no_token) {
+            return emit(type);
+        }
+    }
+}
+
+size_t CqasmFastLexer::getLine() const {
+    return line_;
+}
+
+size_t CqasmFastLexer::getCharPositionInLine() {
+    return char_position_in_line_;
+}
+
+antlr4::CharStream* CqasmFastLexer::getInputStream() {
+    return input_;
+}
+
+std::string CqasmFastLexer::getSourceName() {
+    return input_->getSourceName();
+}
+
+antlr4::TokenFactory<antlr4::CommonToken>* CqasmFastLexer::getTokenFactory() {
+    return factory_;
+}
+
+void CqasmFastLexer::addErrorListener(antlr4::ANTLRErrorListener* listener) {
+    error_listeners_.push_back(listener);
+}
+
+void CqasmFastLexer::removeErrorListeners() {
+    error_listeners_.clear();
+}
+
+/**
+ * Consumes one character, updating the line and character position in line the same way the lexer ATN simulator does.
+ */
+void CqasmFastLexer::consume() {
+    if (input_->LA(1) == '\n') {
+        ++line_;
+        char_position_in_line_ = 0;
+    } else {
+        ++char_position_in_line_;
+    }
+    input_->consume();
+}
+
+void CqasmFastLexer::consume_digits() {
+    while (is_digit(input_->LA(1))) {
+        consume();
+    }
+}
+
+/**
+ * Exponent: [eE][-+]?Digit+
+ * Only consumed if complete, otherwise the float literal ends before the 'e'.
+ */
+void CqasmFastLexer::consume_exponent() {
+    if (auto c = input_->LA(1); c != 'e' && c != 'E') {
+        return;
+    }
+    auto sign = input_->LA(2);
+    auto has_sign = sign == '+' || sign == '-';
+    if (!is_digit(input_->LA(has_sign ? 3 : 2))) {
+        return;
+    }
+    consume();
+    if (has_sign) {
+        consume();
+    }
+    consume_digits();
+}
+
+/**
+ * Goes back to a previous position of the input, e.g. when falling back to a shorter token.
+ */
+void CqasmFastLexer::restore(size_t index, size_t line, size_t char_position_in_line) {
+    input_->seek(index);
+    line_ = line;
+    char_position_in_line_ = char_position_in_line;
+}
+
+size_t CqasmFastLexer::match_default_mode() {
+    auto c = input_->LA(1);
+    switch (get_action(c)) {
+        case Action::white_space:
+            while (is_white_space(input_->LA(1))) {
+                consume();
+            }
+            return no_token;
+        case Action::new_line: consume(); return CqasmLexer::NEW_LINE;
+        case Action::carriage_return: return match_carriage_return();
+        case Action::single_char: {
+            consume();
+            if (auto type = get_two_char_token_type(c, input_->LA(1)); type != no_token) {
+                consume();
+                return type;
+            }
+            return char_table[c].token_type;
+        }
+        case Action::slash: return match_slash();
+        case Action::quote: return match_quote();
+        case Action::dot: return match_dot();
+        case Action::digit: return match_number();
+        case Action::letter: return match_identifier();
+        case Action::error: break;
+    }
+    return recognition_error();
+}
+
+/**
+ * VERSION_WHITE_SPACE: [ \t]+ -> skip;
+ * VERSION_NUMBER: Digit+ ('.' Digit+)? -> popMode;
+ */
+size_t CqasmFastLexer::match_version_statement_mode() {
+    auto c = input_->LA(1);
+    if (is_white_space(c)) {
+        while (is_white_space(input_->LA(1))) {
+            consume();
+        }
+        return no_token;
+    }
+    if (is_digit(c)) {
+        consume_digits();
+        if (input_->LA(1) == '.' && is_digit(input_->LA(2))) {
+            consume();
+            consume_digits();
+        }
+        version_statement_mode_ = false;
+        return CqasmLexer::VERSION_NUMBER;
+    }
+    return recognition_error();
+}
+
+/**
+ * NEW_LINE: '\r'?'\n';
+ * A carriage return not followed by a line feed is a token recognition error.
+ */
+size_t CqasmFastLexer::match_carriage_return() {
+    consume();
+    if (input_->LA(1) != '\n') {
+        return recognition_error();
+    }
+    consume();
+    return CqasmLexer::NEW_LINE;
+}
+
+/**
+ * Matches a single-line comment, a multi-line comment, or a DIVISION_OP.
+ * As with the non-greedy MULTI_LINE_COMMENT rule, a multi-line comment ends at the first star-slash sequence.
+ * An unterminated multi-line comment falls back to a DIVISION_OP.
+ */
+size_t CqasmFastLexer::match_slash() {
+    consume();
+    auto c = input_->LA(1);
+    if (c == '/') {
+        for (c = input_->LA(1); c != '\r' && c != '\n' && c != antlr4::Token::EOF; c = input_->LA(1)) {
+            consume();
+        }
+        return no_token;
+    }
+    if (c == '*') {
+        auto index = input_->index();
+        auto line = line_;
+        auto char_position_in_line = char_position_in_line_;
+        consume();
+        for (c = input_->LA(1); c != antlr4::Token::EOF; c = input_->LA(1)) {
+            consume();
+            if (c == '*' && input_->LA(1) == '/') {
+                consume();
+                return no_token;
+            }
+        }
+        restore(index, line, char_position_in_line);
+    }
+    return CqasmLexer::DIVISION_OP;
+}
+
+/**
+ * TRIPLE_QUOTE: '\'\'\'';
+ * RAW_TEXT_STRING: TRIPLE_QUOTE (.)*? TRIPLE_QUOTE;
+ * An unterminated raw text string falls back to a triple quote.
+ */
+size_t CqasmFastLexer::match_quote() {
+    for (auto i = 0; i < 3; ++i) {
+        if (input_->LA(1) != '\'') {
+            return recognition_error();
+        }
+        consume();
+    }
+    auto index = input_->index();
+    if (utf8_input_ != nullptr) {
+        return match_raw_text_string(index);
+    }
+    auto line = line_;
+    auto char_position_in_line = char_position_in_line_;
+    while (input_->LA(1) != antlr4::Token::EOF) {
+        if (input_->LA(1) == '\'' && input_->LA(2) == '\'' && input_->LA(3) == '\'') {
+            consume();
+            consume();
+            consume();
+            return CqasmLexer::RAW_TEXT_STRING;
+        }
+        consume();
+    }
+    restore(index, line, char_position_in_line);
+    return CqasmLexer::TRIPLE_QUOTE;
+}
+
+/**
+ * Matches the rest of a raw text string, after its opening triple quote, from a Utf8CharStream.
+ * The closing triple quote is searched for in the input bytes, and only the newlines of the raw text string,
+ * and the code points of its last line, are counted to update the line and character position in line.
+ * A quote byte is never part of a multibyte UTF-8 sequence, so the match is the same as the one of match_quote.
+ */
+size_t CqasmFastLexer::match_raw_text_string(size_t index) {
+    if (index >= utf8_input_->size()) {
+        return CqasmLexer::TRIPLE_QUOTE;
+    }
+    auto text = utf8_input_->get_text_view(antlr4::misc::Interval{ index, utf8_input_->size() - 1 });
+    auto stop = text.find("'''");
+    if (stop == std::string_view::npos) {
+        return CqasmLexer::TRIPLE_QUOTE;
+    }
+    auto body = text.substr(0, stop);
+    if (auto last_new_line = body.rfind('\n'); last_new_line != std::string_view::npos) {
+        line_ += static_cast<size_t>(std::count(body.begin(), body.end(), '\n'));
+        char_position_in_line_ = utf8_input_->count_code_points(index + last_new_line + 1, index + stop);
+    } else {
+        char_position_in_line_ += utf8_input_->count_code_points(index, index + stop);
+    }
+    char_position_in_line_ += 3;
+    utf8_input_->seek(index + stop + 3);
+    return CqasmLexer::RAW_TEXT_STRING;
+}
+
+/**
+ * DOT: '.';
+ * FLOAT_LITERAL: DOT Digit+ Exponent?;
+ */
+size_t CqasmFastLexer::match_dot() {
+    consume();
+    if (!is_digit(input_->LA(1))) {
+        return CqasmLexer::DOT;
+    }
+    consume_digits();
+    consume_exponent();
+    return CqasmLexer::FLOAT_LITERAL;
+}
+
+/**
+ * INTEGER_LITERAL: Digit+;
+ * FLOAT_LITERAL: Digit+ DOT Digit+ Exponent? | Digit+ DOT Exponent?;
+ * Note an exponent is only allowed after a dot, i.e. '1e5' is an integer literal followed by an identifier.
+ */
+size_t CqasmFastLexer::match_number() {
+    consume_digits();
+    if (input_->LA(1) != '.') {
+        return CqasmLexer::INTEGER_LITERAL;
+    }
+    consume();
+    consume_digits();
+    consume_exponent();
+    return CqasmLexer::FLOAT_LITERAL;
+}
+
+/**
+ * IDENTIFIER: Letter (Letter | Digit)*;
+ * Keywords take precedence over identifiers of the same length.
+ * Matching the 'version' keyword pushes the VERSION_STATEMENT mode.
+ */
+size_t CqasmFastLexer::match_identifier() {
+    std::array<char, max_keyword_size> buffer{};
+    size_t size = 0;
+    for (auto c = input_->LA(1); is_letter_or_digit(c); c = input_->LA(1)) {
+        if (size < buffer.size()) {
+            buffer[size] = static_cast<char>(c);
+        }
+        ++size;
+        consume();
+    }
+    if (size > buffer.size()) {
+        return CqasmLexer::IDENTIFIER;
+    }
+    auto type = get_identifier_token_type({ buffer.data(), size });
+    if (type == CqasmLexer::VERSION) {
+        version_statement_mode_ = true;
+    }
+    return type;
+}
+
+/**
+ * Reports a token recognition error, using the same text, message, and position as antlr4::Lexer::notifyListeners.
+ * The offending text goes from the start of the token up to, and including, the character that could not be matched.
+ * Then recovers the same way as antlr4::Lexer::recover, i.e. by consuming that character.
+ */
+size_t CqasmFastLexer::recognition_error() {
+    auto text = input_->getText(antlr4::misc::Interval{ token_start_char_index_, input_->index() });
+    auto msg = "token recognition error at: '" + get_error_display(text) + "'";
+    for (auto* listener : error_listeners_) {
+        listener->syntaxError(
+            nullptr, nullptr, token_start_line_, token_start_char_position_in_line_, msg, std::exception_ptr{});
+    }
+    if (input_->LA(1) != antlr4::Token::EOF) {
+        consume();
+    }
+    return no_token;
+}
+
+/**
+ * Creates a token spanning from the token start to the current index.
+ * Token text is not copied; as with the ANTLR-generated lexer, it is read from the input stream on demand.
+ */
+std::unique_ptr<antlr4::Token> CqasmFastLexer::emit(size_t type) {
+    return factory_->create(token_factory_source_pair_, type, "", antlr4::Token::DEFAULT_CHANNEL,
+        token_start_char_index_, input_->index() - 1, token_start_line_, token_start_char_position_in_line_);
+}
+
+}  // namespace cqasm::v3x::parser
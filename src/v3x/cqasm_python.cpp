@@ -5,11 +5,13 @@
 #include "libqasm/v3x/cqasm_python.hpp"
 
 #include <memory>
+#include <mutex>  // lock_guard
 #include <optional>
 
 #include "libqasm/v3x/analyzer.hpp"
 #include "libqasm/v3x/cqasm.hpp"
 #include "libqasm/v3x/parse_helper.hpp"
+#include "libqasm/v3x/parser_session.hpp"
 #include "libqasm/version.hpp"
 
 namespace v3x = cqasm::v3x;
@@ -23,7 +25,8 @@ namespace v3x = cqasm::v3x;
  * the initial mappings and functions are not configurable at all.
  * The defaults for these are always used.
  */
-V3xAnalyzer::V3xAnalyzer(const std::string& max_version, bool without_defaults) {
+V3xAnalyzer::V3xAnalyzer(const std::string& max_version, bool without_defaults)
+: parser_session{ std::make_unique<v3x::parser::ParserSession>() } {
     if (without_defaults) {
         analyzer = std::make_unique<v3x::analyzer::Analyzer>(max_version);
         analyzer->register_default_constants();
@@ -35,7 +38,7 @@ V3xAnalyzer::V3xAnalyzer(const std::string& max_version, bool without_defaults)
 
 /**
  * std::unique_ptr<T> requires T to be a complete class for the ~T operation.
- * Since we are using a forward declaration for Analyzer, we need to declare ~T in the header file,
+ * Since we are using forward declarations for Analyzer and ParserSession, we need to declare ~T in the header file,
  * and implement it in the source file.
  */
 V3xAnalyzer::~V3xAnalyzer() = default;
@@ -140,7 +143,10 @@ std::vector<std::string> V3xAnalyzer::analyze_file(const std::string& file_name)
  */
 std::vector<std::string> V3xAnalyzer::analyze_string(const std::string& data, const std::string& file_name) const {
     auto file_name_op = !file_name.empty() ? std::optional<std::string>{ file_name } : std::nullopt;
-    const auto& parse_result = v3x::parser::parse_string(data, file_name_op);
+    const auto& parse_result = [this, &data, &file_name_op]() {
+        std::lock_guard lock{ parser_session_mutex };
+        return parser_session->parse_string(data, file_name_op);
+    }();
     const auto& analysis_result = analyzer->analyze(parse_result);
     return analysis_result.to_strings();
 }
@@ -159,7 +165,10 @@ std::vector<std::string> V3xAnalyzer::analyze_string(const std::string& data, co
 [[nodiscard]] std::string V3xAnalyzer::analyze_string_to_json(
     const std::string& data, const std::string& file_name) const {
     auto file_name_op = !file_name.empty() ? std::optional<std::string>{ file_name } : std::nullopt;
-    const auto& parse_result = v3x::parser::parse_string(data, file_name_op);
+    const auto& parse_result = [this, &data, &file_name_op]() {
+        std::lock_guard lock{ parser_session_mutex };
+        return parser_session->parse_string(data, file_name_op);
+    }();
     const auto& analysis_result = analyzer->analyze(parse_result);
     return analysis_result.to_json();
 }
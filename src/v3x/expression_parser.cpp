@@ -0,0 +1,250 @@
+/** \file
+ * Implementation for \ref include/libqasm/v3x/expression_parser.hpp "libqasm/v3x/expression_parser.hpp".
+ */
+
+#include "libqasm/v3x/expression_parser.hpp"
+
+#include <algorithm>  // find_if
+#include <array>
+
+#include "libqasm/v3x/CqasmParser.h"
+
+namespace cqasm::v3x::parser {
+
+using namespace cqasm::v3x::syntactic;
+
+namespace {
+
+/**
+ * Precedences of the expression alternatives, as ANTLR computes them for a left-recursive rule:
+ * the n-th of the 23 alternatives has precedence 24 - n.
+ * A prefix operator parses its operand with its own precedence.
+ * A binary operator can only extend an expression being parsed with an equal or lower precedence,
+ * and parses its right operand with its own precedence, plus one if it is left associative.
+ */
+constexpr size_t unary_plus_minus_precedence = 22;
+constexpr size_t bitwise_not_precedence = 21;
+constexpr size_t logical_not_precedence = 20;
+constexpr size_t ternary_conditional_precedence = 7;
+
+template <typename BinaryExpressionType>
+One<Expression> make_binary_expression(const One<Expression>& lhs, const One<Expression>& rhs) {
+    return One<Expression>{ tree::make<BinaryExpressionType>(lhs, rhs) };
+}
+
+struct BinaryOperator {
+    size_t token_type;
+    size_t precedence;
+    bool right_associative;
+    One<Expression> (*make)(const One<Expression>& lhs, const One<Expression>& rhs);
+};
+
+const std::array binary_operators = {
+    BinaryOperator{ CqasmParser::POWER_OP, 19, true, make_binary_expression<PowerExpression> },
+    BinaryOperator{ CqasmParser::PRODUCT_OP, 18, false, make_binary_expression<ProductExpression> },
+    BinaryOperator{ CqasmParser::DIVISION_OP, 18, false, make_binary_expression<DivisionExpression> },
+    BinaryOperator{ CqasmParser::MODULO_OP, 18, false, make_binary_expression<ModuloExpression> },
+    BinaryOperator{ CqasmParser::PLUS, 17, false, make_binary_expression<AdditionExpression> },
+    BinaryOperator{ CqasmParser::MINUS, 17, false, make_binary_expression<SubtractionExpression> },
+    BinaryOperator{ CqasmParser::SHL_OP, 16, false, make_binary_expression<ShiftLeftExpression> },
+    BinaryOperator{ CqasmParser::SHR_OP, 16, false, make_binary_expression<ShiftRightExpression> },
+    BinaryOperator{ CqasmParser::CMP_GT_OP, 15, false, make_binary_expression<CmpGtExpression> },
+    BinaryOperator{ CqasmParser::CMP_LT_OP, 15, false, make_binary_expression<CmpLtExpression> },
+    BinaryOperator{ CqasmParser::CMP_GE_OP, 15, false, make_binary_expression<CmpGeExpression> },
+    BinaryOperator{ CqasmParser::CMP_LE_OP, 15, false, make_binary_expression<CmpLeExpression> },
+    BinaryOperator{ CqasmParser::CMP_EQ_OP, 14, false, make_binary_expression<CmpEqExpression> },
+    BinaryOperator{ CqasmParser::CMP_NE_OP, 14, false, make_binary_expression<CmpNeExpression> },
+    BinaryOperator{ CqasmParser::BITWISE_AND_OP, 13, false, make_binary_expression<BitwiseAndExpression> },
+    BinaryOperator{ CqasmParser::BITWISE_XOR_OP, 12, false, make_binary_expression<BitwiseXorExpression> },
+    BinaryOperator{ CqasmParser::BITWISE_OR_OP, 11, false, make_binary_expression<BitwiseOrExpression> },
+    BinaryOperator{ CqasmParser::LOGICAL_AND_OP, 10, false, make_binary_expression<LogicalAndExpression> },
+    BinaryOperator{ CqasmParser::LOGICAL_XOR_OP, 9, false, make_binary_expression<LogicalXorExpression> },
+    BinaryOperator{ CqasmParser::LOGICAL_OR_OP, 8, false, make_binary_expression<LogicalOrExpression> },
+};
+
+const BinaryOperator* find_binary_operator(size_t token_type) {
+    auto it = std::find_if(binary_operators.begin(), binary_operators.end(),
+        [token_type](const BinaryOperator& binary_operator) { return binary_operator.token_type == token_type; });
+    return (it != binary_operators.end()) ? &*it : nullptr;
+}
+
+}  // namespace
+
+const char* ExpressionParserMismatch::what() const noexcept {
+    return "input does not match the grammar of the expression parser";
+}
+
+ExpressionParser::ExpressionParser(antlr4::TokenStream& tokens, const BaseSyntacticAnalyzer& builder_visitor)
+: tokens_{ tokens }
+, builder_visitor_{ builder_visitor } {}
+
+antlr4::Token* ExpressionParser::match(size_t token_type) {
+    auto* token = tokens_.LT(1);
+    if (token->getType() != token_type) {
+        throw ExpressionParserMismatch{};
+    }
+    tokens_.consume();
+    return token;
+}
+
+One<Expression> ExpressionParser::parse_expression() {
+    return parse_expression(0);
+}
+
+/**
+ * Parses an expression, extending it with binary operators of, at least, the given precedence.
+ */
+One<Expression> ExpressionParser::parse_expression(size_t precedence) {
+    auto ret = parse_primary_expression();
+    while (true) {
+        auto* token = tokens_.LT(1);
+        if (token->getType() == CqasmParser::TERNARY_CONDITIONAL_OP) {
+            if (ternary_conditional_precedence < precedence) {
+                break;
+            }
+            tokens_.consume();
+            auto if_true = parse_expression();
+            match(CqasmParser::COLON);
+            auto if_false = parse_expression(ternary_conditional_precedence);
+            auto ternary_conditional_expression = tree::make<TernaryConditionalExpression>(ret, if_true, if_false);
+            builder_visitor_.setNodeAnnotation(ternary_conditional_expression, token);
+            ret = One<Expression>{ ternary_conditional_expression };
+            continue;
+        }
+        const auto* binary_operator = find_binary_operator(token->getType());
+        if (!binary_operator || binary_operator->precedence < precedence) {
+            break;
+        }
+        tokens_.consume();
+        auto rhs = parse_expression(binary_operator->precedence + (binary_operator->right_associative ? 0 : 1));
+        ret = binary_operator->make(ret, rhs);
+        builder_visitor_.setNodeAnnotation(ret, token);
+    }
+    return ret;
+}
+
+/**
+ * Parses a parenthesized expression, a prefix operator expression, or a primary expression.
+ */
+One<Expression> ExpressionParser::parse_primary_expression() {
+    auto* token = tokens_.LT(1);
+    switch (token->getType()) {
+        case CqasmParser::OPEN_PARENS: {
+            tokens_.consume();
+            auto ret = parse_expression();
+            match(CqasmParser::CLOSE_PARENS);
+            return ret;
+        }
+        case CqasmParser::PLUS:
+            tokens_.consume();
+            return parse_expression(unary_plus_minus_precedence);
+        case CqasmParser::MINUS: {
+            tokens_.consume();
+            auto ret = tree::make<UnaryMinusExpression>(parse_expression(unary_plus_minus_precedence));
+            builder_visitor_.setNodeAnnotation(ret, token);
+            return One<Expression>{ ret };
+        }
+        case CqasmParser::BITWISE_NOT_OP: {
+            tokens_.consume();
+            auto ret = tree::make<BitwiseNotExpression>(parse_expression(bitwise_not_precedence));
+            builder_visitor_.setNodeAnnotation(ret, token);
+            return One<Expression>{ ret };
+        }
+        case CqasmParser::LOGICAL_NOT_OP: {
+            tokens_.consume();
+            auto ret = tree::make<LogicalNotExpression>(parse_expression(logical_not_precedence));
+            builder_visitor_.setNodeAnnotation(ret, token);
+            return One<Expression>{ ret };
+        }
+        case CqasmParser::IDENTIFIER:
+            return parse_identifier_expression();
+        case CqasmParser::BOOLEAN_LITERAL: {
+            tokens_.consume();
+            auto ret = tree::make<BooleanLiteral>(builder_visitor_.getBoolValue(token));
+            builder_visitor_.setNodeAnnotation(ret, token);
+            return One<Expression>{ ret };
+        }
+        case CqasmParser::INTEGER_LITERAL: {
+            tokens_.consume();
+            auto ret = tree::make<IntegerLiteral>(builder_visitor_.getIntValue(token));
+            builder_visitor_.setNodeAnnotation(ret, token);
+            return One<Expression>{ ret };
+        }
+        case CqasmParser::FLOAT_LITERAL: {
+            tokens_.consume();
+            auto ret = tree::make<FloatLiteral>(builder_visitor_.getFloatValue(token));
+            builder_visitor_.setNodeAnnotation(ret, token);
+            return One<Expression>{ ret };
+        }
+        default:
+            throw ExpressionParserMismatch{};
+    }
+}
+
+/**
+ * Parses a function call, an index, or an identifier.
+ */
+One<Expression> ExpressionParser::parse_identifier_expression() {
+    auto* identifier = match(CqasmParser::IDENTIFIER);
+    switch (tokens_.LA(1)) {
+        case CqasmParser::OPEN_PARENS: {
+            tokens_.consume();
+            auto ret = tree::make<FunctionCall>();
+            ret->name = tree::make<Identifier>(identifier->getText());
+            if (tokens_.LA(1) != CqasmParser::CLOSE_PARENS) {
+                ret->arguments = Maybe<ExpressionList>{ parse_expression_list().get_ptr() };
+            }
+            match(CqasmParser::CLOSE_PARENS);
+            builder_visitor_.setNodeAnnotation(ret, identifier);
+            return One<Expression>{ ret };
+        }
+        case CqasmParser::OPEN_BRACKET: {
+            tokens_.consume();
+            auto ret = tree::make<Index>();
+            ret->expr = tree::make<Identifier>(identifier->getText());
+            ret->indices = parse_index_list();
+            match(CqasmParser::CLOSE_BRACKET);
+            builder_visitor_.setNodeAnnotation(ret, identifier);
+            return One<Expression>{ ret };
+        }
+        default: {
+            auto ret = tree::make<Identifier>(identifier->getText());
+            builder_visitor_.setNodeAnnotation(ret, identifier);
+            return One<Expression>{ ret };
+        }
+    }
+}
+
+/**
+ * indexList: indexEntry (COMMA indexEntry)*;
+ * indexEntry: expression | expression COLON expression;
+ */
+One<IndexList> ExpressionParser::parse_index_list() {
+    auto ret = tree::make<IndexList>();
+    auto parse_index_entry = [this]() {
+        auto first = parse_expression();
+        if (tokens_.LA(1) != CqasmParser::COLON) {
+            return One<IndexEntry>{ tree::make<IndexItem>(first) };
+        }
+        tokens_.consume();
+        return One<IndexEntry>{ tree::make<IndexRange>(first, parse_expression()) };
+    };
+    ret->items.add(parse_index_entry());
+    while (tokens_.LA(1) == CqasmParser::COMMA) {
+        tokens_.consume();
+        ret->items.add(parse_index_entry());
+    }
+    return ret;
+}
+
+One<ExpressionList> ExpressionParser::parse_expression_list() {
+    auto ret = tree::make<ExpressionList>();
+    ret->items.add(parse_expression());
+    while (tokens_.LA(1) == CqasmParser::COMMA) {
+        tokens_.consume();
+        ret->items.add(parse_expression());
+    }
+    return ret;
+}
+
+}  // namespace cqasm::v3x::parser
@@ -0,0 +1,291 @@
+/** \file
+ * Implementation for \ref include/libqasm/v3x/incremental_parser.hpp "libqasm/v3x/incremental_parser.hpp".
+ */
+
+#include "libqasm/v3x/incremental_parser.hpp"
+
+#include <antlr4-runtime.h>
+
+#include <algorithm>  // count, max, min, upper_bound
+#include <cstddef>  // ptrdiff_t
+#include <cstdint>  // uint32_t
+#include <stdexcept>  // invalid_argument
+#include <string_view>
+
+#include "libqasm/annotations.hpp"
+#include "libqasm/error.hpp"
+#include "libqasm/v3x/antlr_custom_error_listener.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "libqasm/v3x/syntactic_analyzer.hpp"
+
+namespace cqasm::v3x::parser {
+
+namespace {
+
+/**
+ * Shifts the lines of the source locations of a syntactic tree.
+ */
+class SourceLocationShifter : public syntactic::RecursiveVisitor {
+    std::ptrdiff_t line_delta_;
+
+    [[nodiscard]] std::uint32_t shift(std::uint32_t line) const {
+        return static_cast<std::uint32_t>(static_cast<std::ptrdiff_t>(line) + line_delta_);
+    }
+
+public:
+    explicit SourceLocationShifter(std::ptrdiff_t line_delta)
+    : line_delta_{ line_delta } {}
+
+    void visit_node(syntactic::Node& node) override {
+        if (const auto* source_location = node.get_annotation_ptr<annotations::SourceLocation>()) {
+            auto shifted = *source_location;
+            shifted.range.first.line = shift(shifted.range.first.line);
+            shifted.range.last.line = shift(shifted.range.last.line);
+            // Annotations can be shared between nodes, e.g. by an instruction and its gate,
+            // so they are replaced instead of modified
+            node.set_annotation(shifted);
+        }
+    }
+};
+
+}  // namespace
+
+IncrementalParser::IncrementalParser(
+    std::string data, const std::optional<std::string>& file_name, const ParseOptions& options)
+: data_{ std::move(data) }
+, file_name_{ file_name }
+, options_{ options }
+, builder_visitor_up_{ std::make_unique<SyntacticAnalyzer>(file_name, options.source_location_mode) }
+, error_listener_up_{ std::make_unique<AntlrCustomErrorListener>(file_name) } {
+    builder_visitor_up_->addErrorListener(error_listener_up_.get());
+    segments_.push_back(Segment{ ChunkStart{} });
+    NewLineScanner scanner{ data_, segments_.back().start };
+    for (auto new_line = scanner.next(); new_line.has_value(); new_line = scanner.next()) {
+        if (new_line->offset >= segments_.back().start.offset + segment_size) {
+            segments_.push_back(Segment{ *new_line });
+        }
+    }
+    for (size_t i = 0; i < segments_.size(); ++i) {
+        parse_segment_(i);
+    }
+    update_result_(0, segments_.size(), 0, 0);
+}
+
+IncrementalParser::~IncrementalParser() = default;
+
+const std::string& IncrementalParser::data() const {
+    return data_;
+}
+
+const ParseResult& IncrementalParser::result() {
+    if (result_is_stitched_) {
+        for (auto& segment : segments_) {
+            if (segment.annotated_line != segment.start.line) {
+                SourceLocationShifter source_location_shifter{ static_cast<std::ptrdiff_t>(segment.start.line) -
+                    static_cast<std::ptrdiff_t>(segment.annotated_line) };
+                for (const auto& statement : segment.statements) {
+                    statement->visit(source_location_shifter);
+                }
+                segment.annotated_line = segment.start.line;
+            }
+        }
+    }
+    return result_;
+}
+
+const error::ParseErrors& IncrementalParser::errors() const {
+    return result_.errors;
+}
+
+const error::ParseErrors& IncrementalParser::apply_edit(const TextEdit& edit) {
+    if (edit.offset > data_.size() || edit.length > data_.size() - edit.offset) {
+        throw std::invalid_argument{ "text edit is out of the range of the document" };
+    }
+    auto edit_end = edit.offset + edit.length;
+    auto byte_delta = static_cast<std::ptrdiff_t>(edit.text.size()) - static_cast<std::ptrdiff_t>(edit.length);
+    auto line_delta = std::count(edit.text.begin(), edit.text.end(), '\n') -
+        std::count(data_.begin() + static_cast<std::ptrdiff_t>(edit.offset),
+            data_.begin() + static_cast<std::ptrdiff_t>(edit_end), '\n');
+
+    // The segment ending right before the edit is parsed again, as the edit may extend its last line.
+    // Segments containing an error after the previous edit are parsed again as well
+    auto first = find_segment_(edit.offset == 0 ? 0 : edit.offset - 1);
+    auto next = std::max(find_segment_(edit_end) + 1, first + 1);
+    if (segments_with_errors_ != 0) {
+        for (size_t i = 0; i < segments_.size(); ++i) {
+            if (!segments_[i].errors.empty()) {
+                first = std::min(first, i);
+                next = std::max(next, i + 1);
+            }
+        }
+    }
+    auto shift_offset = [byte_delta](size_t offset) {
+        return static_cast<size_t>(static_cast<std::ptrdiff_t>(offset) + byte_delta);
+    };
+
+    // Scan the edited document from the first segment,
+    // until finding the start of a following segment, from which on the document has not changed
+    data_.replace(edit.offset, edit.length, edit.text);
+    std::vector<Segment> new_segments{ Segment{ segments_[first].start } };
+    NewLineScanner scanner{ data_, segments_[first].start };
+    auto sync = segments_.size();
+    for (auto new_line = scanner.next(); new_line.has_value(); new_line = scanner.next()) {
+        while (next < segments_.size() && shift_offset(segments_[next].start.offset) < new_line->offset) {
+            ++next;
+        }
+        if (next < segments_.size() && shift_offset(segments_[next].start.offset) == new_line->offset) {
+            sync = next;
+            segments_[sync].start = *new_line;
+            break;
+        }
+        if (new_line->offset >= new_segments.back().start.offset + segment_size) {
+            new_segments.push_back(Segment{ *new_line });
+        }
+    }
+
+    // Reuse the statements of the following segments, only moving their start.
+    // The source locations of their statements are shifted by result()
+    for (auto i = sync + 1; i < segments_.size(); ++i) {
+        auto& segment = segments_[i];
+        segment.start.offset = shift_offset(segment.start.offset);
+        segment.start.line = static_cast<size_t>(static_cast<std::ptrdiff_t>(segment.start.line) + line_delta);
+    }
+    auto statement_index = find_first_statement_(first);
+    size_t number_of_removed_statements = 0;
+    for (auto i = first; i < sync; ++i) {
+        number_of_removed_statements += segments_[i].statements.size();
+        forget_errors_(segments_[i]);
+    }
+    segments_.erase(segments_.begin() + static_cast<std::ptrdiff_t>(first),
+        segments_.begin() + static_cast<std::ptrdiff_t>(sync));
+    segments_.insert(segments_.begin() + static_cast<std::ptrdiff_t>(first), new_segments.begin(), new_segments.end());
+    for (auto i = first; i < first + new_segments.size(); ++i) {
+        parse_segment_(i);
+    }
+    update_result_(first, new_segments.size(), statement_index, number_of_removed_statements);
+    return result_.errors;
+}
+
+/**
+ * Returns the index of the segment containing the byte at the given offset.
+ */
+size_t IncrementalParser::find_segment_(size_t offset) const {
+    auto it = std::upper_bound(segments_.begin(), segments_.end(), offset,
+        [](size_t value, const Segment& segment) { return value < segment.start.offset; });
+    return static_cast<size_t>(it - segments_.begin()) - 1;
+}
+
+/**
+ * Returns the index in the program of the first statement of the given segment.
+ */
+size_t IncrementalParser::find_first_statement_(size_t segment_index) const {
+    size_t ret = 0;
+    for (size_t i = 0; i < segment_index; ++i) {
+        ret += segments_[i].statements.size();
+    }
+    return ret;
+}
+
+/**
+ * Clears the errors of a segment, and removes it from the counts of segments with errors.
+ */
+void IncrementalParser::forget_errors_(Segment& segment) {
+    if (!segment.errors.empty()) {
+        --segments_with_errors_;
+        segment.errors.clear();
+    }
+    if (segment.has_error_at_end) {
+        --segments_with_error_at_end_;
+        segment.has_error_at_end = false;
+    }
+}
+
+/**
+ * Parses a segment on its own, as a chunk.
+ * A segment containing an error is parsed again recovering from errors, to collect all its errors.
+ */
+void IncrementalParser::parse_segment_(size_t index) {
+    auto& segment = segments_[index];
+    auto end = index + 1 < segments_.size() ? segments_[index + 1].start.offset : data_.size();
+    auto segment_data = std::string_view{ data_ }.substr(segment.start.offset, end - segment.start.offset);
+    forget_errors_(segment);
+    segment.annotated_line = segment.start.line;
+    try {
+        auto chunk = parse_chunk(segment_data, segment.start, index == 0, *builder_visitor_up_, options_);
+        if (index == 0) {
+            version_ = chunk.version;
+        }
+        segment.statements = std::move(chunk.statements);
+        return;
+    } catch (const antlr4::ParseCancellationException&) {
+    } catch (const error::ParseError&) {
+    }
+    auto recovered_chunk = parse_chunk_with_recovery(
+        segment_data, segment.start, index == 0, *builder_visitor_up_, *error_listener_up_, options_);
+    if (index == 0) {
+        version_ = recovered_chunk.parsed_chunk.version;
+    }
+    segment.statements = std::move(recovered_chunk.parsed_chunk.statements);
+    segment.errors = std::move(recovered_chunk.errors);
+    // The end of the document is the end of the last segment, so errors found there are errors of the document
+    segment.has_error_at_end = recovered_chunk.has_error_at_end && index + 1 < segments_.size();
+    if (!segment.errors.empty()) {
+        ++segments_with_errors_;
+    }
+    if (segment.has_error_at_end) {
+        ++segments_with_error_at_end_;
+    }
+}
+
+/**
+ * Replaces the statements removed from the program by the ones of the segments parsed again,
+ * and collects the errors of all the segments,
+ * or parses the whole document again if an error is found at the end of a segment.
+ */
+void IncrementalParser::update_result_(
+    size_t first, size_t number_of_segments, size_t statement_index, size_t number_of_removed_statements) {
+    if (segments_with_error_at_end_ != 0) {
+        auto options = options_;
+        options.recover_from_errors = true;
+        result_ = parse_string(data_, file_name_, options);
+        result_is_stitched_ = false;
+        return;
+    }
+    if (!result_is_stitched_) {
+        // The program is stitched from the statements of all the segments
+        auto program = tree::make<syntactic::Program>();
+        program->block = tree::make<syntactic::GlobalBlock>();
+        result_ = ParseResult{
+            program,  // root
+            {}  // errors
+        };
+        result_is_stitched_ = true;
+        first = 0;
+        number_of_segments = segments_.size();
+        statement_index = 0;
+        number_of_removed_statements = 0;
+    }
+    auto* program = result_.root->as_program();
+    if (first == 0) {
+        program->version = version_;
+    }
+    auto& statements = program->block->statements.get_vec();
+    auto removed_begin = statements.begin() + static_cast<std::ptrdiff_t>(statement_index);
+    statements.erase(removed_begin, removed_begin + static_cast<std::ptrdiff_t>(number_of_removed_statements));
+    std::vector<syntactic::One<syntactic::Statement>> added_statements{};
+    for (auto i = first; i < first + number_of_segments; ++i) {
+        const auto& segment_statements = segments_[i].statements;
+        added_statements.insert(added_statements.end(), segment_statements.begin(), segment_statements.end());
+    }
+    statements.insert(statements.begin() + static_cast<std::ptrdiff_t>(statement_index), added_statements.begin(),
+        added_statements.end());
+
+    if (segments_with_errors_ != 0 || !result_.errors.empty()) {
+        result_.errors.clear();
+        for (const auto& segment : segments_) {
+            result_.errors.insert(result_.errors.end(), segment.errors.begin(), segment.errors.end());
+        }
+    }
+}
+
+}  // namespace cqasm::v3x::parser
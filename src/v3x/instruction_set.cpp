@@ -2,6 +2,8 @@
 
 #include <fmt/format.h>
 
+#include <utility>  // move
+
 #include "libqasm/error.hpp"
 
 namespace cqasm::v3x::instruction {
@@ -102,9 +104,105 @@ InstructionSet::InstructionSet()
 , non_gate_list{
     "measure", "reset", "init", "barrier", "wait"
 }
-{}
+{
+    build_opcode_catalog();
+}
 // NOLINTEND
 
+Opcode InstructionSet::add_opcode(OpcodeInfo info) {
+    auto opcode = static_cast<Opcode>(opcode_catalog.size());
+    opcodes.emplace(primitives::Symbol{ info.name }, opcode);
+    opcode_catalog.push_back(std::move(info));
+    return opcode;
+}
+
+/**
+ * Builds the opcode catalog from the instruction maps, once, when the instruction set is constructed.
+ * Overloads keep the order of the maps, as the last applicable overload of an instruction wins.
+ */
+void InstructionSet::build_opcode_catalog() {
+    // Named gates
+    for (const auto& [name, pair_param_types_operand_types] : named_gate_map) {
+        auto opcode = get_opcode(name);
+        if (opcode == Opcode::none) {
+            OpcodeInfo info{};
+            info.name = name;
+            info.kind = is_single_qubit_named_gate(name) ? InstructionKind::single_qubit_named_gate
+                                                         : InstructionKind::two_qubit_named_gate;
+            info.arity = is_single_qubit_named_gate(name) ? 1 : 2;
+            opcode = add_opcode(std::move(info));
+        }
+        auto& info = opcode_catalog[static_cast<size_t>(opcode)];
+        info.param_types.push_back(pair_param_types_operand_types.first);
+        info.operand_types.push_back(pair_param_types_operand_types.second);
+    }
+
+    // Single-qubit and two-qubit gate compositions of single-qubit named gates, e.g., inv.X, or ctrl.X
+    // A two-qubit gate composition takes a control qubit operand, of type Q or V, before each operand of the named gate
+    auto number_of_named_gates = opcode_catalog.size();
+    for (size_t i = 0; i < number_of_named_gates; ++i) {
+        if (opcode_catalog[i].kind == InstructionKind::single_qubit_named_gate) {
+            OpcodeInfo info{};
+            info.name = fmt::format("{}_{}", single_qubit_gate_composition_prefix, opcode_catalog[i].name);
+            info.kind = InstructionKind::single_qubit_gate_composition;
+            info.arity = 1;
+            info.param_types = opcode_catalog[i].param_types;
+            info.operand_types = opcode_catalog[i].operand_types;
+            info.named_gate = static_cast<Opcode>(i);
+            auto composition = add_opcode(std::move(info));
+            opcode_catalog[i].single_qubit_gate_composition = composition;
+        }
+    }
+    for (size_t i = 0; i < number_of_named_gates; ++i) {
+        if (opcode_catalog[i].kind == InstructionKind::single_qubit_named_gate) {
+            OpcodeInfo info{};
+            info.name = fmt::format("{}_{}", two_qubit_gate_composition_prefix, opcode_catalog[i].name);
+            info.kind = InstructionKind::two_qubit_gate_composition;
+            info.arity = 2;
+            info.named_gate = static_cast<Opcode>(i);
+            for (size_t j = 0; j < opcode_catalog[i].operand_types.size(); ++j) {
+                const auto& operand_types = opcode_catalog[i].operand_types[j].value_or("");
+                for (const auto* control_operand_type : { "Q", "V" }) {
+                    info.param_types.push_back(opcode_catalog[i].param_types[j]);
+                    info.operand_types.emplace_back(fmt::format("{}{}", control_operand_type, operand_types));
+                }
+            }
+            auto composition = add_opcode(std::move(info));
+            opcode_catalog[i].two_qubit_gate_composition = composition;
+        }
+    }
+
+    // Non-gate instructions
+    for (const auto& [name, pair_param_types_operand_types] : non_gate_map) {
+        auto opcode = get_opcode(name);
+        if (opcode == Opcode::none) {
+            OpcodeInfo info{};
+            info.name = name;
+            info.kind = InstructionKind::non_gate;
+            opcode = add_opcode(std::move(info));
+        }
+        auto& info = opcode_catalog[static_cast<size_t>(opcode)];
+        info.param_types.push_back(pair_param_types_operand_types.first);
+        info.operand_types.push_back(pair_param_types_operand_types.second);
+    }
+    measure_opcode = get_opcode(measure_name);
+
+    // Gate modifiers
+    for (const auto& [name, param_types] : gate_modifier_map) {
+        OpcodeInfo info{};
+        info.name = name;
+        info.kind = InstructionKind::gate_modifier;
+        info.modifier_kind = GateModifierKind::ctrl;
+        if (is_inv_gate_modifier(name)) {
+            info.modifier_kind = GateModifierKind::inv;
+        } else if (is_pow_gate_modifier(name)) {
+            info.modifier_kind = GateModifierKind::pow;
+        }
+        info.param_types.push_back(param_types);
+        add_opcode(std::move(info));
+    }
+}
+
 [[nodiscard]] /* static */ InstructionSet& InstructionSet::get_instance() {
     static InstructionSet instance;
     return instance;
@@ -270,4 +368,42 @@ InstructionSet::InstructionSet()
     return std::nullopt;
 }
 
+[[nodiscard]] const OpcodeCatalogT& InstructionSet::get_opcode_catalog() const {
+    return opcode_catalog;
+}
+
+[[nodiscard]] Opcode InstructionSet::get_opcode(const primitives::Symbol& name) const {
+    if (const auto& it = opcodes.find(name); it != opcodes.end()) {
+        return it->second;
+    }
+    return Opcode::none;
+}
+
+[[nodiscard]] const OpcodeInfo& InstructionSet::get_opcode_info(Opcode opcode) const {
+    return opcode_catalog[static_cast<size_t>(opcode)];
+}
+
+[[nodiscard]] bool InstructionSet::is_measure(Opcode opcode) const {
+    return opcode != Opcode::none && opcode == measure_opcode;
+}
+
+[[nodiscard]] std::optional<std::string> InstructionSet::get_non_gate_param_types_with_param_count(
+    Opcode opcode, size_t param_count) const {
+    if (opcode == Opcode::none) {
+        return std::nullopt;
+    }
+    for (const auto& param_types : get_opcode_info(opcode).param_types) {
+        if (!param_types.has_value()) {
+            if (param_count == 0) {
+                return param_types;
+            }
+        } else {
+            if (param_types->size() == param_count) {
+                return param_types;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
 }  // namespace cqasm::v3x::instruction
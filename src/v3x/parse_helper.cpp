@@ -5,6 +5,7 @@
 #include "libqasm/v3x/parse_helper.hpp"
 
 #include "libqasm/annotations_constants.hpp"
+#include "libqasm/arena.hpp"
 #include "libqasm/v3x/antlr_custom_error_listener.hpp"
 #include "libqasm/v3x/antlr_scanner.hpp"
 #include "libqasm/v3x/parse_result.hpp"
@@ -14,32 +15,73 @@ namespace cqasm::v3x::parser {
 
 /**
  * Parse using the given file path.
- * Throws a ParseError if the file does not exist.
+ * The file is memory-mapped, and parsed in place.
+ * Throws a ParseError if the file cannot be accessed.
  * A file_name may be given in addition for use within error messages.
+ * Parsing can be configured via the options, e.g. to use a different lexer.
  */
-ParseResult parse_file(const std::string& file_path, const std::optional<std::string>& file_name) {
-    auto builder_visitor_up = std::make_unique<SyntacticAnalyzer>(file_name);
-    auto error_listener_up = std::make_unique<AntlrCustomErrorListener>(file_name);
-    auto scanner_up =
-        std::make_unique<FileAntlrScanner>(std::move(builder_visitor_up), std::move(error_listener_up), file_path);
-    return ParseHelper(std::move(scanner_up), file_name).parse();
+ParseResult parse_file(
+    const std::string& file_path, const std::optional<std::string>& file_name, const ParseOptions& options) {
+    MemoryMappedFile file{ file_path };
+    return parse_file(file, file_name, options);
+}
+
+/**
+ * Parse the contents of the given memory-mapped file.
+ * A file_name may be given in addition for use within error messages.
+ * Parsing can be configured via the options, e.g. to use a different lexer.
+ */
+ParseResult parse_file(
+    const MemoryMappedFile& file, const std::optional<std::string>& file_name, const ParseOptions& options) {
+    return parse_string(file.data(), file_name, options);
 }
 
 /**
  * Parse the given string.
  * A file_name may be given in addition for use within error messages.
+ * Parsing can be configured via the options, e.g. to use a different lexer.
  */
-ParseResult parse_string(const std::string& data, const std::optional<std::string>& file_name) {
-    auto builder_visitor_up = std::make_unique<SyntacticAnalyzer>(file_name);
+ParseResult parse_string(
+    std::string_view data, const std::optional<std::string>& file_name, const ParseOptions& options) {
+    auto builder_visitor_up = std::make_unique<SyntacticAnalyzer>(file_name, options.source_location_mode);
     auto error_listener_up = std::make_unique<AntlrCustomErrorListener>(file_name);
-    auto scanner_up =
-        std::make_unique<StringAntlrScanner>(std::move(builder_visitor_up), std::move(error_listener_up), data);
-    return ParseHelper(std::move(scanner_up), file_name).parse();
+    auto scanner_up = std::make_unique<StringViewAntlrScanner>(
+        std::move(builder_visitor_up), std::move(error_listener_up), data, options);
+    return ParseHelper(std::move(scanner_up), file_name, options.allocation_mode).parse();
+}
+
+namespace {
+
+/**
+ * Hash of the parse options, used as the configuration of the cached parse results.
+ */
+size_t get_configuration_hash(const ParseOptions& options) {
+    size_t ret = 0;
+    for (auto option : { static_cast<size_t>(options.lexer_type), static_cast<size_t>(options.prediction_strategy),
+             static_cast<size_t>(options.profile_prediction), static_cast<size_t>(options.build_mode),
+             static_cast<size_t>(options.expression_parser), static_cast<size_t>(options.recover_from_errors),
+             static_cast<size_t>(options.allocation_mode), static_cast<size_t>(options.source_location_mode) }) {
+        ret = hash_combine(ret, option);
+    }
+    return ret;
+}
+
+}  // namespace
+
+/**
+ * Parse the given string, or return the result cached for the same string, file name, and options.
+ */
+std::shared_ptr<const ParseResult> parse_string(std::string_view data, const std::optional<std::string>& file_name,
+    ParseResultCache& cache, const ParseOptions& options) {
+    return cache.get_or_compute(get_configuration_hash(options), file_name, data,
+        [&data, &file_name, &options]() { return parse_string(data, file_name, options); });
 }
 
-ParseHelper::ParseHelper(std::unique_ptr<ScannerAdaptor> scanner_up, const std::optional<std::string>& file_name)
+ParseHelper::ParseHelper(std::unique_ptr<ScannerAdaptor> scanner_up, const std::optional<std::string>& file_name,
+    AllocationMode allocation_mode)
 : scanner_up_{ std::move(scanner_up) }
-, file_name_{ file_name.value_or(annotations::unknown_file_name) } {
+, file_name_{ file_name.value_or(annotations::unknown_file_name) }
+, allocation_mode_{ allocation_mode } {
     if (file_name_.empty()) {
         file_name_ = annotations::unknown_file_name;
     }
@@ -50,13 +92,16 @@ ParseHelper::ParseHelper(std::unique_ptr<ScannerAdaptor> scanner_up, const std::
  */
 ParseResult ParseHelper::parse() {
     ParseResult result;
+    auto arena = allocation_mode_ == AllocationMode::arena ? std::make_shared<tree::Arena>() : nullptr;
     try {
+        tree::ArenaScope arena_scope{ arena };
         result = scanner_up_->parse();
     } catch (error::AnalysisError& err) {
         result.errors.push_back(std::move(err));
     } catch (const std::runtime_error& err) {
         result.errors.emplace_back(err.what());
     }
+    result.arena = std::move(arena);
 
     if (result.errors.empty() && !result.root.is_well_formed()) {
         std::cerr << *result.root;
@@ -0,0 +1,152 @@
+/** \file
+ * Implementation for \ref include/libqasm/v3x/parser_session.hpp "libqasm/v3x/parser_session.hpp".
+ */
+
+#include "libqasm/v3x/parser_session.hpp"
+
+#include <antlr4-runtime.h>
+
+#include "libqasm/memory_mapped_file.hpp"
+#include "libqasm/v3x/CqasmLexer.h"
+#include "libqasm/v3x/CqasmParser.h"
+#include "libqasm/v3x/antlr_custom_error_listener.hpp"
+#include "libqasm/v3x/antlr_scanner.hpp"
+#include "libqasm/v3x/cqasm_fast_lexer.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "libqasm/v3x/prediction_telemetry.hpp"
+#include "libqasm/v3x/syntactic.hpp"
+#include "libqasm/v3x/syntactic_analyzer.hpp"
+#include "libqasm/v3x/utf8_char_stream.hpp"
+
+namespace cqasm::v3x::parser {
+
+namespace {
+
+/**
+ * Restarts a lexer from the beginning of its input stream, reporting errors to the given listener.
+ */
+template <typename Lexer>
+void reset_lexer(Lexer& lexer, antlr4::ANTLRErrorListener* error_listener) {
+    lexer.reset();
+    lexer.removeErrorListeners();
+    lexer.addErrorListener(error_listener);
+}
+
+}  // namespace
+
+class ParserSession::Scanner : public ScannerAdaptor {
+    ParserSession& session_;
+
+public:
+    explicit Scanner(ParserSession& session)
+    : session_{ session } {}
+
+    ParseResult parse() override { return session_.parse_(); }
+};
+
+ParserSession::ParserSession(const ParseOptions& options)
+: options_{ options }
+, builder_visitor_up_{ std::make_unique<SyntacticAnalyzer>(std::nullopt, options.source_location_mode) }
+, error_listener_up_{ std::make_unique<AntlrCustomErrorListener>(std::nullopt) }
+, bail_error_listener_up_{ std::make_unique<BailErrorListener>() }
+, default_error_strategy_{ std::make_shared<antlr4::DefaultErrorStrategy>() }
+, bail_error_strategy_{ std::make_shared<antlr4::BailErrorStrategy>() }
+, char_stream_up_{ std::make_unique<Utf8CharStream>(std::string_view{}) }
+, lexer_up_{ create_lexer(*char_stream_up_, error_listener_up_.get(), options_.lexer_type) }
+, tokens_up_{ std::make_unique<antlr4::CommonTokenStream>(lexer_up_.get()) }
+, parser_up_{ std::make_unique<CqasmParser>(tokens_up_.get()) } {
+    builder_visitor_up_->addErrorListener(error_listener_up_.get());
+}
+
+ParserSession::~ParserSession() = default;
+
+ParseResult ParserSession::parse_string(std::string_view data, const std::optional<std::string>& file_name) {
+    builder_visitor_up_->set_file_name(file_name);
+    error_listener_up_->set_file_name(file_name);
+    *char_stream_up_ = Utf8CharStream{ data };
+    auto ret = ParseHelper{ std::make_unique<Scanner>(*this), file_name, options_.allocation_mode }.parse();
+    *char_stream_up_ = Utf8CharStream{ std::string_view{} };
+    return ret;
+}
+
+ParseResult ParserSession::parse_file(const std::string& file_path, const std::optional<std::string>& file_name) {
+    MemoryMappedFile file{ file_path };
+    return parse_string(file.data(), file_name);
+}
+
+/**
+ * Parses the current input, as AntlrScanner does in the parse_tree build mode,
+ * or one statement at a time, collecting all the errors, when recovering from errors.
+ */
+ParseResult ParserSession::parse_() {
+    if (options_.recover_from_errors) {
+        return parse_with_recovery_();
+    }
+    if (options_.prediction_strategy == PredictionStrategy::sll_then_ll) {
+        auto& telemetry = PredictionTelemetry::get_instance();
+        telemetry.record_sll_parse();
+        try {
+            return parse_tokens_(true);
+        } catch (const antlr4::ParseCancellationException&) {
+            telemetry.record_ll_fallback();
+        }
+    }
+    return parse_tokens_(false);
+}
+
+/**
+ * Parses the current input one statement at a time, after resetting the lexer and the token stream.
+ */
+ParseResult ParserSession::parse_with_recovery_() {
+    AntlrErrorCollector lexer_error_collector{ *error_listener_up_, false };
+    if (options_.lexer_type == LexerType::hand_written) {
+        reset_lexer(static_cast<CqasmFastLexer&>(*lexer_up_), &lexer_error_collector);
+    } else {
+        reset_lexer(static_cast<CqasmLexer&>(*lexer_up_), &lexer_error_collector);
+    }
+    tokens_up_->setTokenSource(lexer_up_.get());
+    // The lexer reports to the collector until it is reset for the next input
+    return parse_with_recovery(
+        *tokens_up_, lexer_error_collector, *builder_visitor_up_, *error_listener_up_, options_.expression_parser);
+}
+
+/**
+ * Parses the current input with either SLL or full LL prediction, after resetting the lexer and the parser.
+ * SLL parsing throws a ParseCancellationException at the first lexer or parser error, without reporting it.
+ */
+ParseResult ParserSession::parse_tokens_(bool sll) {
+    auto* error_listener = sll ? static_cast<antlr4::ANTLRErrorListener*>(bail_error_listener_up_.get())
+                               : static_cast<antlr4::ANTLRErrorListener*>(error_listener_up_.get());
+    if (options_.lexer_type == LexerType::hand_written) {
+        reset_lexer(static_cast<CqasmFastLexer&>(*lexer_up_), error_listener);
+    } else {
+        reset_lexer(static_cast<CqasmLexer&>(*lexer_up_), error_listener);
+    }
+    parser_up_->removeErrorListeners();
+    parser_up_->addErrorListener(error_listener);
+    parser_up_->setErrorHandler(sll ? bail_error_strategy_ : default_error_strategy_);
+    // Setting the token source clears the token buffer, and setting the token stream resets the parser,
+    // including its error handler, which may have been left in error recovery mode by the previous input,
+    // and deletes the parse tree of the previous input
+    tokens_up_->setTokenSource(lexer_up_.get());
+    parser_up_->setTokenStream(tokens_up_.get());
+    if (options_.profile_prediction) {
+        // Start from a new profiling simulator, so that the profile only covers this parse
+        parser_up_->setProfile(false);
+        parser_up_->setProfile(true);
+    }
+    parser_up_->getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(
+        sll ? antlr4::atn::PredictionMode::SLL : antlr4::atn::PredictionMode::LL);
+    auto ast = parser_up_->program();
+    if (options_.profile_prediction) {
+        PredictionTelemetry::get_instance().record_predictions(*parser_up_);
+    }
+
+    auto custom_ast = builder_visitor_up_->visitProgram(ast);
+    return ParseResult{
+        std::any_cast<syntactic::One<syntactic::Program>>(custom_ast),  // root
+        {}  // error
+    };
+}
+
+}  // namespace cqasm::v3x::parser
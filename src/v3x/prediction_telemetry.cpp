@@ -0,0 +1,59 @@
+/** \file
+ * Implementation for \ref include/libqasm/v3x/prediction_telemetry.hpp "libqasm/v3x/prediction_telemetry.hpp".
+ */
+
+#include "libqasm/v3x/prediction_telemetry.hpp"
+
+#include <antlr4-runtime.h>
+
+namespace cqasm::v3x::parser {
+
+[[nodiscard]] /* static */ PredictionTelemetry& PredictionTelemetry::get_instance() {
+    static PredictionTelemetry instance;
+    return instance;
+}
+
+void PredictionTelemetry::record_sll_parse() {
+    std::scoped_lock lock{ mutex_ };
+    ++statistics_.sll_parses;
+}
+
+void PredictionTelemetry::record_ll_fallback() {
+    std::scoped_lock lock{ mutex_ };
+    ++statistics_.ll_fallbacks;
+}
+
+void PredictionTelemetry::record_full_context_predictions(const std::string& rule_name, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    std::scoped_lock lock{ mutex_ };
+    statistics_.full_context_predictions += count;
+    statistics_.full_context_predictions_per_rule[rule_name] += count;
+}
+
+void PredictionTelemetry::record_predictions(antlr4::Parser& parser) {
+    const auto& atn = parser.getATN();
+    const auto& rule_names = parser.getRuleNames();
+    for (const auto& decision_info : parser.getParseInfo().getDecisionInfo()) {
+        const auto* decision_state = atn.decisionToState[decision_info.decision];
+        const auto& rule_name = rule_names[decision_state->ruleIndex];
+        if (decision_info.invocations != 0) {
+            std::scoped_lock lock{ mutex_ };
+            statistics_.predictions_per_rule[rule_name] += static_cast<size_t>(decision_info.invocations);
+        }
+        record_full_context_predictions(rule_name, static_cast<size_t>(decision_info.LL_Fallback));
+    }
+}
+
+[[nodiscard]] PredictionStatistics PredictionTelemetry::get_statistics() const {
+    std::scoped_lock lock{ mutex_ };
+    return statistics_;
+}
+
+void PredictionTelemetry::reset() {
+    std::scoped_lock lock{ mutex_ };
+    statistics_ = PredictionStatistics{};
+}
+
+}  // namespace cqasm::v3x::parser
@@ -7,6 +7,14 @@
 #include <fmt/format.h>
 
 #include <algorithm>  // transform
+#include <atomic>
+#include <cstddef>  // byte
+#include <mutex>  // unique_lock
+#include <new>
+#include <shared_mutex>
+#include <stdexcept>  // out_of_range
+#include <unordered_map>
+#include <utility>  // exchange, move
 
 namespace cqasm::v3x::primitives {
 
@@ -28,6 +36,242 @@ Str deserialize(const ::tree::cbor::MapReader& map) {
     return map.at("x").as_binary();
 }
 
+/**
+ * Symbol
+ */
+struct Symbol::Data {
+    std::string text;
+    size_t hash;
+    /**
+     * Number of symbols pointing to this entry.
+     * Once it has dropped to zero, the entry is being freed, and is not handed out again.
+     */
+    std::atomic<size_t> reference_count;
+};
+
+struct Symbol::Pool {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string_view, Data*> index;
+};
+
+Symbol::Pool& Symbol::pool() {
+    // Leaked on purpose, so that symbols held by static objects stay valid during static destruction
+    static auto* pool = new Pool{};
+    return *pool;
+}
+
+Symbol::Data* Symbol::empty_data() noexcept {
+    // Statically allocated, and never destroyed nor freed,
+    // so that empty symbols held by static objects stay valid during static destruction
+    alignas(Data) static std::byte storage[sizeof(Data)];
+    static auto* data = new (storage) Data{ std::string{}, std::hash<std::string_view>{}({}), 1 };
+    return data;
+}
+
+/**
+ * Adds a reference to an entry the caller already holds a reference to.
+ */
+void Symbol::add_reference(Data* data) noexcept {
+    if (data != empty_data()) {
+        data->reference_count.fetch_add(1);
+    }
+}
+
+/**
+ * Adds a reference to a pool entry, unless it is being freed.
+ */
+bool Symbol::try_add_reference(Data* data) {
+    auto reference_count = data->reference_count.load();
+    while (reference_count != 0) {
+        if (data->reference_count.compare_exchange_weak(reference_count, reference_count + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Symbol::Data* Symbol::intern(std::string_view text) {
+    if (text.empty()) {
+        return empty_data();
+    }
+    auto& pool = Symbol::pool();
+    {
+        std::shared_lock lock{ pool.mutex };
+        if (auto it = pool.index.find(text); it != pool.index.end() && try_add_reference(it->second)) {
+            return it->second;
+        }
+    }
+    std::unique_lock lock{ pool.mutex };
+    // Another thread may have interned the text in the meantime, or released its last symbol
+    if (auto it = pool.index.find(text); it != pool.index.end()) {
+        if (try_add_reference(it->second)) {
+            return it->second;
+        }
+        // The entry is being freed, so it is replaced, and left to the thread freeing it
+        pool.index.erase(it);
+    }
+    auto* data = new Data{ std::string{ text }, std::hash<std::string_view>{}(text), 1 };
+    pool.index.emplace(data->text, data);
+    return data;
+}
+
+void Symbol::release(Data* data) {
+    if (data == empty_data() || data->reference_count.fetch_sub(1) != 1) {
+        return;
+    }
+    {
+        auto& pool = Symbol::pool();
+        std::unique_lock lock{ pool.mutex };
+        if (auto it = pool.index.find(data->text); it != pool.index.end() && it->second == data) {
+            pool.index.erase(it);
+        }
+    }
+    delete data;
+}
+
+Symbol::Symbol() noexcept
+: data_{ empty_data() } {}
+
+Symbol::Symbol(std::string_view text)
+: data_{ intern(text) } {}
+
+Symbol::Symbol(const std::string& text)
+: data_{ intern(text) } {}
+
+Symbol::Symbol(const char* text)
+: data_{ intern(text) } {}
+
+Symbol::Symbol(const Symbol& other) noexcept
+: data_{ other.data_ } {
+    add_reference(data_);
+}
+
+Symbol::Symbol(Symbol&& other) noexcept
+: data_{ std::exchange(other.data_, empty_data()) } {}
+
+Symbol& Symbol::operator=(const Symbol& other) {
+    if (data_ != other.data_) {
+        add_reference(other.data_);
+        release(data_);
+        data_ = other.data_;
+    }
+    return *this;
+}
+
+Symbol& Symbol::operator=(Symbol&& other) noexcept {
+    if (this != &other) {
+        release(std::exchange(data_, std::exchange(other.data_, empty_data())));
+    }
+    return *this;
+}
+
+Symbol::~Symbol() {
+    release(data_);
+}
+
+const std::string& Symbol::str() const {
+    return data_->text;
+}
+
+Symbol::operator const std::string&() const {
+    return data_->text;
+}
+
+size_t Symbol::hash() const {
+    return data_->hash;
+}
+
+size_t Symbol::size() const {
+    return data_->text.size();
+}
+
+bool Symbol::empty() const {
+    return data_->text.empty();
+}
+
+bool Symbol::operator==(const Symbol& rhs) const {
+    return data_ == rhs.data_;
+}
+
+bool Symbol::operator==(const std::string& rhs) const {
+    return data_->text == rhs;
+}
+
+bool Symbol::operator==(std::string_view rhs) const {
+    return data_->text == rhs;
+}
+
+bool Symbol::operator==(const char* rhs) const {
+    return data_->text == rhs;
+}
+
+size_t Symbol::pool_size() {
+    auto& pool = Symbol::pool();
+    std::shared_lock lock{ pool.mutex };
+    return pool.index.size();
+}
+
+template <>
+void serialize(const Symbol& obj, ::tree::cbor::MapWriter& map) {
+    map.append_binary("x", obj.str());
+}
+
+template <>
+Symbol deserialize(const ::tree::cbor::MapReader& map) {
+    return Symbol{ map.at("x").as_binary() };
+}
+
+/**
+ * RawText
+ */
+RawText::RawText(std::shared_ptr<const std::string> buffer, size_t offset, size_t size)
+: buffer_{ std::move(buffer) }
+, offset_{ offset }
+, size_{ size } {
+    auto buffer_size = buffer_ == nullptr ? 0 : buffer_->size();
+    if (offset_ > buffer_size || size_ > buffer_size - offset_) {
+        throw std::out_of_range{ "raw text span is out of the range of its buffer" };
+    }
+}
+
+RawText::RawText(std::string_view text)
+: buffer_{ std::make_shared<const std::string>(text) }
+, size_{ text.size() } {}
+
+std::string_view RawText::view() const {
+    return buffer_ == nullptr ? std::string_view{} : std::string_view{ *buffer_ }.substr(offset_, size_);
+}
+
+std::string RawText::str() const {
+    return std::string{ view() };
+}
+
+size_t RawText::size() const {
+    return size_;
+}
+
+bool RawText::empty() const {
+    return size_ == 0;
+}
+
+bool RawText::operator==(const RawText& rhs) const {
+    return view() == rhs.view();
+}
+
+bool RawText::operator==(std::string_view rhs) const {
+    return view() == rhs;
+}
+
+template <>
+void serialize(const RawText& obj, ::tree::cbor::MapWriter& map) {
+    map.append_binary("x", obj.str());
+}
+
+template <>
+RawText deserialize(const ::tree::cbor::MapReader& map) {
+    return RawText{ map.at("x").as_binary() };
+}
+
 /**
  * Axis
  */
@@ -137,6 +381,20 @@ Version deserialize(const ::tree::cbor::MapReader& map) {
     return v;
 }
 
+/**
+ * Stream << overload for symbols.
+ */
+std::ostream& operator<<(std::ostream& os, const Symbol& symbol) {
+    return os << symbol.str();
+}
+
+/**
+ * Stream << overload for raw texts.
+ */
+std::ostream& operator<<(std::ostream& os, const RawText& raw_text) {
+    return os << raw_text.view();
+}
+
 /**
  * Stream << overload for axis nodes.
  */
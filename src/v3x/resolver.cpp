@@ -18,24 +18,49 @@ namespace cqasm::v3x::resolver {
 // VariableTable //
 //---------------//
 
+VariableTable::VariableTable()
+: table{ std::make_shared<table_t>() } {}
+
+/**
+ * Returns the variables of this table for writing,
+ * copying them first if they are shared with other tables.
+ */
+[[nodiscard]] VariableTable::table_t& VariableTable::mutable_table() {
+    if (table.use_count() > 1) {
+        table = std::make_shared<table_t>(*table);
+    }
+    return *table;
+}
+
 /**
  * Adds a variable.
  */
-void VariableTable::add(const std::string& name, const Value& value) {
-    if (auto entry = table.find(name); entry != table.end()) {
+void VariableTable::add(const primitives::Symbol& name, const Value& value) {
+    if (auto entry = table->find(name); entry != table->end()) {
         throw NameResolutionFailure{ fmt::format("trying to redeclare variable '{}'", name) };
     }
-    table.insert(std::make_pair(name, value));
+    mutable_table().insert(std::make_pair(name, value));
 }
 
 /**
  * Resolves a variable.
- * Throws NameResolutionFailure if no variable by the given name exists.
+ * Returns empty if no variable by the given name exists.
  */
-[[nodiscard]] Value VariableTable::resolve(const std::string& name) const {
-    if (auto entry = table.find(name); entry != table.end()) {
+[[nodiscard]] Value VariableTable::try_resolve(const primitives::Symbol& name) const {
+    if (auto entry = table->find(name); entry != table->end()) {
         return entry->second->clone();
     }
+    return Value{};
+}
+
+/**
+ * Resolves a variable.
+ * Throws NameResolutionFailure if no variable by the given name exists.
+ */
+[[nodiscard]] Value VariableTable::resolve(const primitives::Symbol& name) const {
+    if (auto value = try_resolve(name); !value.empty()) {
+        return value;
+    }
     throw NameResolutionFailure{ fmt::format("failed to resolve variable '{}'", name) };
 }
 
@@ -45,15 +70,15 @@ void VariableTable::add(const std::string& name, const Value& value) {
 
 // NOLINTBEGIN
 ConstEvalCoreFunctionTable::ConstEvalCoreFunctionTable()
-: resolver{ std::make_unique<resolver_t>() } {};
+: resolver{ std::make_shared<resolver_t>() } {};
 // NOLINTEND
 ConstEvalCoreFunctionTable::~ConstEvalCoreFunctionTable() = default;
 ConstEvalCoreFunctionTable::ConstEvalCoreFunctionTable(const ConstEvalCoreFunctionTable& t)
-: resolver{ std::make_unique<resolver_t>(*t.resolver) } {}
+: resolver{ t.resolver } {}
 ConstEvalCoreFunctionTable::ConstEvalCoreFunctionTable(ConstEvalCoreFunctionTable&& t) noexcept
 : resolver{ std::move(t.resolver) } {}
 ConstEvalCoreFunctionTable& ConstEvalCoreFunctionTable::operator=(const ConstEvalCoreFunctionTable& t) {
-    resolver = std::make_unique<resolver_t>(resolver_t{ *t.resolver });
+    resolver = t.resolver;
     return *this;
 }
 ConstEvalCoreFunctionTable& ConstEvalCoreFunctionTable::operator=(ConstEvalCoreFunctionTable&& t) noexcept {
@@ -61,6 +86,17 @@ ConstEvalCoreFunctionTable& ConstEvalCoreFunctionTable::operator=(ConstEvalCoreF
     return *this;
 }
 
+/**
+ * Returns the resolver of this table for writing,
+ * copying it first if it is shared with other tables.
+ */
+[[nodiscard]] ConstEvalCoreFunctionTable::resolver_t& ConstEvalCoreFunctionTable::mutable_resolver() {
+    if (resolver.use_count() > 1) {
+        resolver = std::make_shared<resolver_t>(*resolver);
+    }
+    return *resolver;
+}
+
 /**
  * Registers a function.
  * Matching will be done case-sensitively.
@@ -76,7 +112,7 @@ ConstEvalCoreFunctionTable& ConstEvalCoreFunctionTable::operator=(ConstEvalCoreF
  */
 void ConstEvalCoreFunctionTable::add(
     const std::string& name, const Types& param_types, const ConstEvalCoreFunction& impl) {
-    resolver->add_overload(name, impl, param_types);
+    mutable_resolver().add_overload(name, impl, param_types);
 }
 
 /**
@@ -99,15 +135,15 @@ Value ConstEvalCoreFunctionTable::resolve(const std::string& name, const Values&
 
 // NOLINTBEGIN
 InstructionTable::InstructionTable()
-: resolver{ std::make_unique<resolver_t>() } {}
+: resolver{ std::make_shared<resolver_t>() } {}
 // NOLINTEND
 InstructionTable::~InstructionTable() = default;
 InstructionTable::InstructionTable(const InstructionTable& t)
-: resolver{ std::make_unique<resolver_t>(*t.resolver) } {}
+: resolver{ t.resolver } {}
 InstructionTable::InstructionTable(InstructionTable&& t) noexcept
 : resolver{ std::move(t.resolver) } {}
 InstructionTable& InstructionTable::operator=(const InstructionTable& t) {
-    resolver = std::make_unique<resolver_t>(resolver_t{ *t.resolver });
+    resolver = t.resolver;
     return *this;
 }
 InstructionTable& InstructionTable::operator=(InstructionTable&& t) noexcept {
@@ -115,11 +151,52 @@ InstructionTable& InstructionTable::operator=(InstructionTable&& t) noexcept {
     return *this;
 }
 
+/**
+ * Returns the resolver of this table for writing,
+ * copying it first if it is shared with other tables.
+ */
+[[nodiscard]] InstructionTable::resolver_t& InstructionTable::mutable_resolver() {
+    if (resolver.use_count() > 1) {
+        resolver = std::make_shared<resolver_t>(*resolver);
+    }
+    return *resolver;
+}
+
 /**
  * Registers an instruction type.
  */
 void InstructionTable::add(const instruction::Instruction& type) {
-    resolver->add_overload(type.name, tree::make<instruction::Instruction>(type), type.operand_types);
+    mutable_resolver().add_overload(type.name, tree::make<instruction::Instruction>(type), type.operand_types);
+}
+
+/**
+ * Resolves an GateInstruction type.
+ * Returns empty if no instruction by the given name exists, or if no overload exists for the given arguments,
+ * otherwise returns the resolved instruction node.
+ * Annotation data, line number information, and the condition still need to be set by the caller.
+ */
+[[nodiscard]] tree::One<semantic::Instruction> InstructionTable::try_resolve(
+    const std::string& name, const tree::One<semantic::Gate>& gate, const Values& args) const {
+    if (auto resolution = resolver->try_resolve(name, args); resolution.has_value()) {
+        auto& [instruction_ref, promoted_args] = *resolution;
+        return tree::make<semantic::GateInstruction>(instruction_ref, gate, promoted_args);
+    }
+    return {};
+}
+
+/**
+ * Resolves an NonGateInstruction type.
+ * Returns empty if no instruction by the given name exists, or if no overload exists for the given arguments,
+ * otherwise returns the resolved instruction node.
+ * Annotation data, line number information, and the condition still need to be set by the caller.
+ */
+[[nodiscard]] tree::One<semantic::Instruction> InstructionTable::try_resolve(
+    const std::string& name, const Values& args) const {
+    if (auto resolution = resolver->try_resolve(name, args); resolution.has_value()) {
+        auto& [instruction_ref, promoted_args] = *resolution;
+        return tree::make<semantic::NonGateInstruction>(instruction_ref, name, promoted_args);
+    }
+    return {};
 }
 
 /**
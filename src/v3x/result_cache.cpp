@@ -0,0 +1,52 @@
+/** \file
+ * Implementation for \ref include/libqasm/v3x/result_cache.hpp "libqasm/v3x/result_cache.hpp".
+ */
+
+#include "libqasm/v3x/result_cache.hpp"
+
+#include "libqasm/v3x/analysis_result.hpp"
+#include "libqasm/v3x/parse_result.hpp"
+#include "libqasm/v3x/semantic.hpp"
+#include "libqasm/v3x/syntactic.hpp"
+
+namespace cqasm::v3x {
+
+namespace {
+
+/**
+ * Rough size of a tree node, including its annotations and the handles referring to it.
+ */
+constexpr size_t node_size = 256;
+
+/**
+ * Rough size of an error, including its message.
+ */
+constexpr size_t error_size = 256;
+
+template <typename RecursiveVisitor, typename Node>
+class NodeCounter : public RecursiveVisitor {
+public:
+    size_t count = 0;
+
+    void visit_node(Node& /* node */) override { ++count; }
+};
+
+}  // namespace
+
+size_t estimate_memory_usage(const parser::ParseResult& result) {
+    NodeCounter<syntactic::RecursiveVisitor, syntactic::Node> node_counter{};
+    if (!result.root.empty()) {
+        result.root->visit(node_counter);
+    }
+    return node_counter.count * node_size + result.errors.size() * error_size;
+}
+
+size_t estimate_memory_usage(const analyzer::AnalysisResult& result) {
+    NodeCounter<semantic::RecursiveVisitor, semantic::Node> node_counter{};
+    if (!result.root.empty()) {
+        result.root->visit(node_counter);
+    }
+    return node_counter.count * node_size + result.errors.size() * error_size;
+}
+
+}  // namespace cqasm::v3x
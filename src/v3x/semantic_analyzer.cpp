@@ -3,6 +3,7 @@
 #include <algorithm>  // any_of, for_each, transform
 #include <any>
 #include <iterator>  // back_inserter
+#include <optional>
 
 #include "libqasm/v3x/analyzer.hpp"
 #include "libqasm/v3x/instruction.hpp"
@@ -11,11 +12,14 @@
 
 namespace cqasm::v3x::analyzer {
 
+using instruction::InstructionKind;
 using instruction::InstructionSet;
+using instruction::Opcode;
 
-SemanticAnalyzer::SemanticAnalyzer(Analyzer& analyzer)
+SemanticAnalyzer::SemanticAnalyzer(const Analyzer& analyzer)
 : analyzer_{ analyzer }
-, result_{} {}
+, result_{}
+, block_{ tree::make<semantic::Block>() } {}
 
 std::any SemanticAnalyzer::visit_node(syntactic::Node& /* node */) {
     throw error::AnalysisError{ "unimplemented" };
@@ -31,6 +35,30 @@ std::any SemanticAnalyzer::visit_program(syntactic::Program& program_ast) {
     return result_;
 }
 
+void SemanticAnalyzer::begin_program(syntactic::Version& version) {
+    result_.root = tree::make<semantic::Program>();
+    result_.root->api_version = analyzer_.api_version;
+    result_.root->version = std::any_cast<tree::One<semantic::Version>>(visit_version(version));
+}
+
+/**
+ * Same as visiting a statement of the global block in visit_global_block.
+ * The global block has no source location, so it adds no context to the errors.
+ */
+void SemanticAnalyzer::visit_global_block_statement(syntactic::Statement& statement) {
+    try {
+        analyze_statement(statement);
+    } catch (error::AnalysisError& err) {
+        result_.errors.push_back(std::move(err));
+    }
+}
+
+AnalysisResult SemanticAnalyzer::end_program() {
+    result_.root->block = block_;
+    result_.root->variables = variables_;
+    return result_;
+}
+
 std::any SemanticAnalyzer::visit_version(syntactic::Version& node) {
     auto ret = tree::make<semantic::Version>();
     try {
@@ -61,25 +89,51 @@ std::any SemanticAnalyzer::visit_version(syntactic::Version& node) {
 
 std::any SemanticAnalyzer::visit_global_block(syntactic::GlobalBlock& node) {
     visit_block(node);
-    return GlobalBlockReturnT{ analyzer_.current_block(), analyzer_.current_variables() };
+    return GlobalBlockReturnT{ block_, variables_ };
 }
 
-std::any SemanticAnalyzer::visit_annotated(syntactic::Annotated& node) {
+/**
+ * Registers a variable declared by the program.
+ * Throws NameResolutionFailure if the program or the analyzer already have a variable by the given name.
+ */
+void SemanticAnalyzer::register_variable(const primitives::Symbol& name, const values::Value& value) {
+    if (!analyzer_.try_resolve_variable(name).empty()) {
+        throw resolver::NameResolutionFailure{ fmt::format("trying to redeclare variable '{}'", name) };
+    }
+    variable_table_.add(name, value);
+}
+
+/**
+ * Resolves a variable declared by the program or registered in the analyzer.
+ * Throws NameResolutionFailure if no variable by the given name exists.
+ */
+values::Value SemanticAnalyzer::resolve_variable(const primitives::Symbol& name) const {
+    if (auto value = variable_table_.try_resolve(name); !value.empty()) {
+        return value;
+    }
+    return analyzer_.resolve_variable(name);
+}
+
+tree::Any<semantic::AnnotationData> SemanticAnalyzer::analyze_annotations(syntactic::Annotated& node) {
     auto ret = tree::Any<semantic::AnnotationData>();
     for (const auto& annotation_data_ast : node.annotations) {
-        ret.add(std::any_cast<syntactic::One<semantic::AnnotationData>>(visit_annotation_data(*annotation_data_ast)));
+        ret.add(analyze_annotation_data(*annotation_data_ast));
     }
     return ret;
 }
 
-std::any SemanticAnalyzer::visit_annotation_data(syntactic::AnnotationData& node) {
+std::any SemanticAnalyzer::visit_annotated(syntactic::Annotated& node) {
+    return analyze_annotations(node);
+}
+
+tree::One<semantic::AnnotationData> SemanticAnalyzer::analyze_annotation_data(syntactic::AnnotationData& node) {
     auto ret = tree::make<semantic::AnnotationData>();
     try {
         ret->interface = node.interface->name;
         ret->operation = node.operation->name;
         for (const auto& expression_ast : node.operands->items) {
             try {
-                ret->operands.add(std::any_cast<values::Value>(expression_ast->visit(*this)));
+                ret->operands.add(dispatch_expression(*expression_ast));
             } catch (error::AnalysisError& err) {
                 err.context(node);
                 result_.errors.push_back(std::move(err));
@@ -94,7 +148,11 @@ std::any SemanticAnalyzer::visit_annotation_data(syntactic::AnnotationData& node
     return ret;
 }
 
-std::any SemanticAnalyzer::visit_variable(syntactic::Variable& node) {
+std::any SemanticAnalyzer::visit_annotation_data(syntactic::AnnotationData& node) {
+    return analyze_annotation_data(node);
+}
+
+tree::One<semantic::Variable> SemanticAnalyzer::analyze_variable(syntactic::Variable& node) {
     auto ret = tree::make<semantic::Variable>();
     try {
         // Build semantic type from syntactic type
@@ -105,14 +163,14 @@ std::any SemanticAnalyzer::visit_variable(syntactic::Variable& node) {
         const auto& identifier = node.name;
         ret->name = identifier->name;
         ret->typ = type.clone();
-        ret->annotations = std::any_cast<tree::Any<semantic::AnnotationData>>(visit_annotated(*node.as_annotated()));
+        ret->annotations = analyze_annotations(*node.as_annotated());
         ret->copy_annotation<parser::SourceLocation>(*identifier);
 
-        // Add the variable to the current scope
-        analyzer_.add_variable_to_current_scope(ret);
+        // Add the variable to the program
+        variables_.add(ret);
 
         // Register the variable
-        analyzer_.register_variable(identifier->name, tree::make<values::VariableRef>(ret));
+        register_variable(identifier->name, tree::make<values::VariableRef>(ret));
     } catch (error::AnalysisError& err) {
         err.context(node);
         result_.errors.push_back(std::move(err));
@@ -121,6 +179,10 @@ std::any SemanticAnalyzer::visit_variable(syntactic::Variable& node) {
     return ret;
 }
 
+std::any SemanticAnalyzer::visit_variable(syntactic::Variable& node) {
+    return analyze_variable(node);
+}
+
 /**
  * Convenience function for extracting the types of a list of variables.
  */
@@ -133,20 +195,41 @@ types::Types types_of(const tree::Any<semantic::Variable>& variables) {
 }
 
 /**
- * For a named gate, such as X or Rz, the terminal name will be the name of the gate.
- * For a composition of gate modifiers acting on a named gate, the terminal name will be the name of the named gate.
+ * For a named gate, such as X or Rz, the terminal gate will be the gate itself.
+ * For a composition of gate modifiers acting on a named gate, the terminal gate will be the named gate.
  */
-std::string get_gate_terminal_name(const tree::One<semantic::Gate>& gate) {
-    return gate->gate.empty() ? gate->name : get_gate_terminal_name(gate->gate);
+const semantic::Gate& get_terminal_gate(const tree::One<semantic::Gate>& gate) {
+    return gate->gate.empty() ? *gate : get_terminal_gate(gate->gate);
+}
+
+/**
+ * Returns whether the outermost gate modifier of a gate composition is a single-qubit gate modifier.
+ */
+bool is_single_qubit_gate_modifier(const primitives::Symbol& name) {
+    const auto& instruction_set = InstructionSet::get_instance();
+    auto opcode = instruction_set.get_opcode(name);
+    return opcode != Opcode::none && instruction_set.get_opcode_info(opcode).is_single_qubit_gate_modifier();
 }
 
 std::string get_gate_resolution_name(const tree::One<semantic::Gate>& gate) {
-    return gate->gate.empty() ? gate->name
-                              : fmt::format("{}_{}",
-                                    (InstructionSet::get_instance().is_single_qubit_gate_modifier(gate->name))
-                                        ? InstructionSet::get_instance().single_qubit_gate_composition_prefix
-                                        : InstructionSet::get_instance().two_qubit_gate_composition_prefix,
-                                    get_gate_terminal_name(gate->gate));
+    if (gate->gate.empty()) {
+        return gate->name.str();
+    }
+    const auto& instruction_set = InstructionSet::get_instance();
+    auto single_qubit = is_single_qubit_gate_modifier(gate->name);
+    const auto& terminal_name = get_terminal_gate(gate->gate).name;
+    if (auto opcode = instruction_set.get_opcode(terminal_name); opcode != Opcode::none) {
+        const auto& info = instruction_set.get_opcode_info(opcode);
+        auto composition = single_qubit ? info.single_qubit_gate_composition : info.two_qubit_gate_composition;
+        if (composition != Opcode::none) {
+            return instruction_set.get_opcode_info(composition).name;
+        }
+    }
+    // Not a composition of a single-qubit named gate, so that the resolution of the instruction will fail
+    return fmt::format("{}_{}",
+        single_qubit ? instruction_set.single_qubit_gate_composition_prefix
+                     : instruction_set.two_qubit_gate_composition_prefix,
+        terminal_name);
 }
 
 void check_qubit_operands_indices_have_same_size(const values::Values& operands) {
@@ -181,12 +264,12 @@ void check_gate_instruction(const tree::One<semantic::GateInstruction>& instruct
     check_qubit_operands_indices_have_same_size(instruction->operands);
 }
 
-std::any SemanticAnalyzer::visit_gate_instruction(syntactic::GateInstruction& node) {
+tree::One<semantic::GateInstruction> SemanticAnalyzer::analyze_gate_instruction(syntactic::GateInstruction& node) {
     auto ret = tree::make<semantic::GateInstruction>();
     try {
         // Set gate and operands
-        auto gate = std::any_cast<tree::One<semantic::Gate>>(node.gate->visit(*this));
-        auto operands = std::any_cast<values::Values>(node.operands->visit(*this));
+        auto gate = analyze_gate(*node.gate);
+        auto operands = analyze_expression_list(*node.operands);
 
         // Resolve the instruction
         const auto& resolution_name = get_gate_resolution_name(gate);
@@ -196,11 +279,11 @@ std::any SemanticAnalyzer::visit_gate_instruction(syntactic::GateInstruction& no
         check_gate_instruction(ret);
 
         // Copy annotation data
-        ret->annotations = std::any_cast<tree::Any<semantic::AnnotationData>>(visit_annotated(*node.as_annotated()));
+        ret->annotations = analyze_annotations(*node.as_annotated());
         ret->copy_annotation<parser::SourceLocation>(node);
 
         // Add the statement to the current scope
-        analyzer_.add_statement_to_current_scope(ret);
+        Analyzer::add_statement_to_block(block_, ret);
     } catch (error::AnalysisError& err) {
         err.context(node);
         result_.errors.push_back(std::move(err));
@@ -209,18 +292,27 @@ std::any SemanticAnalyzer::visit_gate_instruction(syntactic::GateInstruction& no
     return ret;
 }
 
+std::any SemanticAnalyzer::visit_gate_instruction(syntactic::GateInstruction& node) {
+    return analyze_gate_instruction(node);
+}
+
 bool is_two_qubit_gate(const tree::One<semantic::Gate>& gate) {
-    const auto& resolution_name = get_gate_resolution_name(gate);
-    return InstructionSet::get_instance().is_two_qubit_gate(resolution_name);
+    if (!gate->gate.empty()) {
+        return !is_single_qubit_gate_modifier(gate->name);
+    }
+    const auto& instruction_set = InstructionSet::get_instance();
+    auto opcode = instruction_set.get_opcode(gate->name);
+    return opcode != Opcode::none && instruction_set.get_opcode_info(opcode).is_two_qubit_gate();
 }
 
-values::Values resolve_parameters(const std::string& instruction_name, const values::Values& parameters) {
+values::Values resolve_parameters(const primitives::Symbol& instruction_name, const values::Values& parameters) {
     auto ret = values::Values{};
     const auto& instruction_set = InstructionSet::get_instance();
+    auto opcode = instruction_set.get_opcode(instruction_name);
+    auto kind = (opcode == Opcode::none) ? std::nullopt : std::optional{ instruction_set.get_opcode_info(opcode).kind };
 
-    if (instruction_set.is_non_gate(instruction_name)) {
-        const auto& param_types =
-            instruction_set.get_non_gate_param_types_with_param_count(instruction_name, parameters.size());
+    if (kind == InstructionKind::non_gate) {
+        const auto& param_types = instruction_set.get_non_gate_param_types_with_param_count(opcode, parameters.size());
         bool found_with_zero_params = (!param_types.has_value() && parameters.empty());
 
         if (!found_with_zero_params && !param_types.has_value()) {
@@ -249,7 +341,11 @@ values::Values resolve_parameters(const std::string& instruction_name, const val
         return ret;
     }
 
-    const auto& param_types = instruction_set.get_instruction_param_types(instruction_name);
+    if (kind != InstructionKind::single_qubit_named_gate && kind != InstructionKind::two_qubit_named_gate &&
+        kind != InstructionKind::gate_modifier) {
+        throw error::AnalysisError{ fmt::format("couldn't find instruction '{}'", instruction_name) };
+    }
+    const auto& param_types = instruction_set.get_opcode_info(opcode).param_types.front();
     if (!param_types.has_value()) {
         if (!parameters.empty()) {
             throw error::AnalysisError{ fmt::format(
@@ -285,14 +381,14 @@ void check_gate(const tree::One<semantic::Gate>& gate) {
     }
 }
 
-std::any SemanticAnalyzer::visit_gate(syntactic::Gate& node) {
+tree::One<semantic::Gate> SemanticAnalyzer::analyze_gate(syntactic::Gate& node) {
     auto ret = tree::make<semantic::Gate>();
     try {
         ret->name = node.name->name;
         if (!node.gate.empty()) {
-            ret->gate = std::any_cast<tree::One<semantic::Gate>>(visit_gate(*node.gate)).get_ptr();
+            ret->gate = analyze_gate(*node.gate).get_ptr();
         }
-        ret->parameters = std::any_cast<values::Values>(visit_expression_list(*node.parameters));
+        ret->parameters = analyze_expression_list(*node.parameters);
 
         // Resolve the parameter
         ret->parameters = resolve_parameters(ret->name, ret->parameters);
@@ -301,7 +397,7 @@ std::any SemanticAnalyzer::visit_gate(syntactic::Gate& node) {
         check_gate(ret);
 
         // Copy annotation data
-        ret->annotations = std::any_cast<tree::Any<semantic::AnnotationData>>(visit_annotated(*node.as_annotated()));
+        ret->annotations = analyze_annotations(*node.as_annotated());
         ret->copy_annotation<parser::SourceLocation>(node);
     } catch (error::AnalysisError& err) {
         err.context(node);
@@ -310,6 +406,10 @@ std::any SemanticAnalyzer::visit_gate(syntactic::Gate& node) {
     return ret;
 }
 
+std::any SemanticAnalyzer::visit_gate(syntactic::Gate& node) {
+    return analyze_gate(node);
+}
+
 void check_qubit_and_bit_indices_have_same_size(const values::Values& operands) {
     size_t qubit_indices_size{};
     size_t bit_indices_size{};
@@ -344,16 +444,18 @@ void check_qubit_and_bit_indices_have_same_size(const values::Values& operands)
 }
 
 void check_non_gate_instruction(const tree::One<semantic::NonGateInstruction>& instruction) {
-    if (InstructionSet::get_instance().is_measure(instruction->name)) {
+    const auto& instruction_set = InstructionSet::get_instance();
+    if (instruction_set.is_measure(instruction_set.get_opcode(instruction->name))) {
         check_qubit_and_bit_indices_have_same_size(instruction->operands);
     }
 }
 
-std::any SemanticAnalyzer::visit_non_gate_instruction(syntactic::NonGateInstruction& node) {
+tree::One<semantic::NonGateInstruction> SemanticAnalyzer::analyze_non_gate_instruction(
+    syntactic::NonGateInstruction& node) {
     auto ret = tree::make<semantic::NonGateInstruction>();
     try {
         ret->name = node.name->name;
-        ret->operands = std::any_cast<values::Values>(visit_expression_list(*node.operands));
+        ret->operands = analyze_expression_list(*node.operands);
 
         // Resolve the instruction
         ret = analyzer_.resolve_instruction(ret->name, ret->operands);
@@ -361,18 +463,18 @@ std::any SemanticAnalyzer::visit_non_gate_instruction(syntactic::NonGateInstruct
         // Resolve the parameters
         if (!node.parameters.empty()) {
             ret->parameters =
-                resolve_parameters(ret->name, std::any_cast<values::Values>(visit_expression_list(*node.parameters)));
+                resolve_parameters(ret->name, analyze_expression_list(*node.parameters));
         }
 
         // Specific checks
         check_non_gate_instruction(ret);
 
         // Copy annotation data
-        ret->annotations = std::any_cast<tree::Any<semantic::AnnotationData>>(visit_annotated(*node.as_annotated()));
+        ret->annotations = analyze_annotations(*node.as_annotated());
         ret->copy_annotation<parser::SourceLocation>(node);
 
         // Add the statement to the current scope
-        analyzer_.add_statement_to_current_scope(ret);
+        Analyzer::add_statement_to_block(block_, ret);
     } catch (error::AnalysisError& err) {
         err.context(node);
         result_.errors.push_back(std::move(err));
@@ -381,18 +483,22 @@ std::any SemanticAnalyzer::visit_non_gate_instruction(syntactic::NonGateInstruct
     return ret;
 }
 
-std::any SemanticAnalyzer::visit_asm_declaration(syntactic::AsmDeclaration& node) {
+std::any SemanticAnalyzer::visit_non_gate_instruction(syntactic::NonGateInstruction& node) {
+    return analyze_non_gate_instruction(node);
+}
+
+tree::One<semantic::AsmDeclaration> SemanticAnalyzer::analyze_asm_declaration(syntactic::AsmDeclaration& node) {
     auto ret = tree::make<semantic::AsmDeclaration>();
     try {
         ret->backend_name = node.backend_name->name;
         ret->backend_code = node.backend_code;
 
         // Copy annotation data
-        ret->annotations = std::any_cast<tree::Any<semantic::AnnotationData>>(visit_annotated(*node.as_annotated()));
+        ret->annotations = analyze_annotations(*node.as_annotated());
         ret->copy_annotation<parser::SourceLocation>(node);
 
         // Add the statement to the current scope
-        analyzer_.add_statement_to_current_scope(ret);
+        Analyzer::add_statement_to_block(block_, ret);
     } catch (error::AnalysisError& err) {
         err.context(node);
         result_.errors.push_back(std::move(err));
@@ -401,18 +507,26 @@ std::any SemanticAnalyzer::visit_asm_declaration(syntactic::AsmDeclaration& node
     return ret;
 }
 
-std::any SemanticAnalyzer::visit_expression_list(syntactic::ExpressionList& node) {
+std::any SemanticAnalyzer::visit_asm_declaration(syntactic::AsmDeclaration& node) {
+    return analyze_asm_declaration(node);
+}
+
+values::Values SemanticAnalyzer::analyze_expression_list(syntactic::ExpressionList& node) {
     auto ret = values::Values();
     std::transform(
         node.items.begin(), node.items.end(), std::back_inserter(ret.get_vec()), [this](const auto& expression_ast) {
-            return std::any_cast<values::Value>(visit_expression(*expression_ast));
+            return analyze_expression(*expression_ast);
         });
     return ret;
 }
 
-std::any SemanticAnalyzer::visit_expression(syntactic::Expression& node) {
+std::any SemanticAnalyzer::visit_expression_list(syntactic::ExpressionList& node) {
+    return analyze_expression_list(node);
+}
+
+values::Value SemanticAnalyzer::analyze_expression(syntactic::Expression& node) {
     try {
-        auto ret = std::any_cast<values::Value>(node.visit(*this));
+        auto ret = dispatch_expression(node);
         ret->copy_annotation<parser::SourceLocation>(node);
         return ret;
     } catch (error::AnalysisError& err) {
@@ -421,6 +535,10 @@ std::any SemanticAnalyzer::visit_expression(syntactic::Expression& node) {
     }
 }
 
+std::any SemanticAnalyzer::visit_expression(syntactic::Expression& node) {
+    return analyze_expression(node);
+}
+
 /**
  * Convenience function for visiting a function call given the function's name and arguments
  */
@@ -429,8 +547,8 @@ values::Value SemanticAnalyzer::visit_function_call(
     auto function_arguments = values::Values();
     if (!arguments.empty()) {
         std::for_each(
-            arguments->items.begin(), arguments->items.end(), [&function_arguments, this](const auto node_argument) {
-                function_arguments.add(std::any_cast<values::Value>(visit_expression(*node_argument)));
+            arguments->items.begin(), arguments->items.end(), [&function_arguments, this](const auto& node_argument) {
+                function_arguments.add(analyze_expression(*node_argument));
             });
     }
     const auto function_name = name->name;
@@ -442,13 +560,13 @@ values::Value SemanticAnalyzer::visit_function_call(
 }
 
 std::any SemanticAnalyzer::visit_function_call(syntactic::FunctionCall& node) {
-    return visit_function_call(node.name, node.arguments);
+    return dispatch_expression(node);
 }
 
 /**
  * Convenience function for visiting unary operators
  */
-std::any SemanticAnalyzer::visit_unary_operator(
+values::Value SemanticAnalyzer::visit_unary_operator(
     const std::string& name, const tree::One<syntactic::Expression>& expression) {
     return visit_function_call(tree::make<syntactic::Identifier>(std::string{ "operator" } + name),
         tree::Maybe<syntactic::ExpressionList>{
@@ -458,7 +576,7 @@ std::any SemanticAnalyzer::visit_unary_operator(
 /**
  * Convenience function for visiting binary operators
  */
-std::any SemanticAnalyzer::visit_binary_operator(
+values::Value SemanticAnalyzer::visit_binary_operator(
     const std::string& name, const tree::One<syntactic::Expression>& lhs, const tree::One<syntactic::Expression>& rhs) {
     return visit_function_call(tree::make<syntactic::Identifier>(std::string{ "operator" } + name),
         tree::Maybe<syntactic::ExpressionList>{
@@ -466,101 +584,268 @@ std::any SemanticAnalyzer::visit_binary_operator(
 }
 
 std::any SemanticAnalyzer::visit_unary_minus_expression(syntactic::UnaryMinusExpression& node) {
-    return visit_unary_operator("-", node.expr);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_bitwise_not_expression(syntactic::BitwiseNotExpression& node) {
-    return visit_unary_operator("~", node.expr);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_logical_not_expression(syntactic::LogicalNotExpression& node) {
-    return visit_unary_operator("!", node.expr);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_power_expression(syntactic::PowerExpression& node) {
-    return visit_binary_operator("**", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_product_expression(syntactic::ProductExpression& node) {
-    return visit_binary_operator("*", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_division_expression(syntactic::DivisionExpression& node) {
-    return visit_binary_operator("/", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_modulo_expression(syntactic::ModuloExpression& node) {
-    return visit_binary_operator("%", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_addition_expression(syntactic::AdditionExpression& node) {
-    return visit_binary_operator("+", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_subtraction_expression(syntactic::SubtractionExpression& node) {
-    return visit_binary_operator("-", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_shift_left_expression(syntactic::ShiftLeftExpression& node) {
-    return visit_binary_operator("<<", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_shift_right_expression(syntactic::ShiftRightExpression& node) {
-    return visit_binary_operator(">>", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_cmp_gt_expression(syntactic::CmpGtExpression& node) {
-    return visit_binary_operator(">", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_cmp_lt_expression(syntactic::CmpLtExpression& node) {
-    return visit_binary_operator("<", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_cmp_ge_expression(syntactic::CmpGeExpression& node) {
-    return visit_binary_operator(">=", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_cmp_le_expression(syntactic::CmpLeExpression& node) {
-    return visit_binary_operator("<=", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_cmp_eq_expression(syntactic::CmpEqExpression& node) {
-    return visit_binary_operator("==", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_cmp_ne_expression(syntactic::CmpNeExpression& node) {
-    return visit_binary_operator("!=", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_bitwise_and_expression(syntactic::BitwiseAndExpression& node) {
-    return visit_binary_operator("&", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_bitwise_xor_expression(syntactic::BitwiseXorExpression& node) {
-    return visit_binary_operator("^", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_bitwise_or_expression(syntactic::BitwiseOrExpression& node) {
-    return visit_binary_operator("|", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_logical_and_expression(syntactic::LogicalAndExpression& node) {
-    return visit_binary_operator("&&", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_logical_xor_expression(syntactic::LogicalXorExpression& node) {
-    return visit_binary_operator("^^", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_logical_or_expression(syntactic::LogicalOrExpression& node) {
-    return visit_binary_operator("||", node.lhs, node.rhs);
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_ternary_conditional_expression(syntactic::TernaryConditionalExpression& node) {
-    return visit_function_call(tree::make<syntactic::Identifier>("operator?:"),
-        tree::make<syntactic::ExpressionList>(
-            tree::Any<syntactic::Expression>{ node.cond, node.if_true, node.if_false }));
+    return dispatch_expression(node);
+}
+
+/**
+ * Typed visitor analyzing an expression according to its kind,
+ * so that its value is returned directly instead of through a std::any.
+ * Errors are not given the context of the expression, nor is the value given its source location.
+ */
+class SemanticAnalyzer::ExpressionVisitor : public syntactic::Visitor<values::Value> {
+    SemanticAnalyzer& semantic_analyzer_;
+
+public:
+    explicit ExpressionVisitor(SemanticAnalyzer& semantic_analyzer)
+    : semantic_analyzer_{ semantic_analyzer } {}
+
+    values::Value visit_node(syntactic::Node& /* node */) override { throw error::AnalysisError{ "unimplemented" }; }
+
+    values::Value visit_unary_minus_expression(syntactic::UnaryMinusExpression& node) override {
+        return semantic_analyzer_.visit_unary_operator("-", node.expr);
+    }
+
+    values::Value visit_bitwise_not_expression(syntactic::BitwiseNotExpression& node) override {
+        return semantic_analyzer_.visit_unary_operator("~", node.expr);
+    }
+
+    values::Value visit_logical_not_expression(syntactic::LogicalNotExpression& node) override {
+        return semantic_analyzer_.visit_unary_operator("!", node.expr);
+    }
+
+    values::Value visit_power_expression(syntactic::PowerExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("**", node.lhs, node.rhs);
+    }
+
+    values::Value visit_product_expression(syntactic::ProductExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("*", node.lhs, node.rhs);
+    }
+
+    values::Value visit_division_expression(syntactic::DivisionExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("/", node.lhs, node.rhs);
+    }
+
+    values::Value visit_modulo_expression(syntactic::ModuloExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("%", node.lhs, node.rhs);
+    }
+
+    values::Value visit_addition_expression(syntactic::AdditionExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("+", node.lhs, node.rhs);
+    }
+
+    values::Value visit_subtraction_expression(syntactic::SubtractionExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("-", node.lhs, node.rhs);
+    }
+
+    values::Value visit_shift_left_expression(syntactic::ShiftLeftExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("<<", node.lhs, node.rhs);
+    }
+
+    values::Value visit_shift_right_expression(syntactic::ShiftRightExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator(">>", node.lhs, node.rhs);
+    }
+
+    values::Value visit_cmp_gt_expression(syntactic::CmpGtExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator(">", node.lhs, node.rhs);
+    }
+
+    values::Value visit_cmp_lt_expression(syntactic::CmpLtExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("<", node.lhs, node.rhs);
+    }
+
+    values::Value visit_cmp_ge_expression(syntactic::CmpGeExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator(">=", node.lhs, node.rhs);
+    }
+
+    values::Value visit_cmp_le_expression(syntactic::CmpLeExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("<=", node.lhs, node.rhs);
+    }
+
+    values::Value visit_cmp_eq_expression(syntactic::CmpEqExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("==", node.lhs, node.rhs);
+    }
+
+    values::Value visit_cmp_ne_expression(syntactic::CmpNeExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("!=", node.lhs, node.rhs);
+    }
+
+    values::Value visit_bitwise_and_expression(syntactic::BitwiseAndExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("&", node.lhs, node.rhs);
+    }
+
+    values::Value visit_bitwise_xor_expression(syntactic::BitwiseXorExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("^", node.lhs, node.rhs);
+    }
+
+    values::Value visit_bitwise_or_expression(syntactic::BitwiseOrExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("|", node.lhs, node.rhs);
+    }
+
+    values::Value visit_logical_and_expression(syntactic::LogicalAndExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("&&", node.lhs, node.rhs);
+    }
+
+    values::Value visit_logical_xor_expression(syntactic::LogicalXorExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("^^", node.lhs, node.rhs);
+    }
+
+    values::Value visit_logical_or_expression(syntactic::LogicalOrExpression& node) override {
+        return semantic_analyzer_.visit_binary_operator("||", node.lhs, node.rhs);
+    }
+
+    values::Value visit_ternary_conditional_expression(syntactic::TernaryConditionalExpression& node) override {
+        return semantic_analyzer_.visit_function_call(tree::make<syntactic::Identifier>("operator?:"),
+            tree::make<syntactic::ExpressionList>(
+                tree::Any<syntactic::Expression>{ node.cond, node.if_true, node.if_false }));
+    }
+
+    values::Value visit_function_call(syntactic::FunctionCall& node) override {
+        return semantic_analyzer_.visit_function_call(node.name, node.arguments);
+    }
+
+    values::Value visit_index(syntactic::Index& node) override { return semantic_analyzer_.analyze_index(node); }
+
+    values::Value visit_identifier(syntactic::Identifier& node) override {
+        return semantic_analyzer_.resolve_variable(node.name);
+    }
+
+    values::Value visit_boolean_literal(syntactic::BooleanLiteral& node) override {
+        return values::Value{ tree::make<values::ConstBool>(node.value) };
+    }
+
+    values::Value visit_integer_literal(syntactic::IntegerLiteral& node) override {
+        return values::Value{ tree::make<values::ConstInt>(node.value) };
+    }
+
+    values::Value visit_float_literal(syntactic::FloatLiteral& node) override {
+        return values::Value{ tree::make<values::ConstFloat>(node.value) };
+    }
+};
+
+/**
+ * Typed visitor analyzing a statement according to its kind.
+ * Every statement is added to the current scope, so nothing needs to be returned.
+ */
+class SemanticAnalyzer::StatementVisitor : public syntactic::Visitor<void> {
+    SemanticAnalyzer& semantic_analyzer_;
+
+public:
+    explicit StatementVisitor(SemanticAnalyzer& semantic_analyzer)
+    : semantic_analyzer_{ semantic_analyzer } {}
+
+    void visit_node(syntactic::Node& /* node */) override { throw error::AnalysisError{ "unimplemented" }; }
+    void visit_variable(syntactic::Variable& node) override { semantic_analyzer_.analyze_variable(node); }
+    void visit_gate_instruction(syntactic::GateInstruction& node) override {
+        semantic_analyzer_.analyze_gate_instruction(node);
+    }
+    void visit_non_gate_instruction(syntactic::NonGateInstruction& node) override {
+        semantic_analyzer_.analyze_non_gate_instruction(node);
+    }
+    void visit_asm_declaration(syntactic::AsmDeclaration& node) override {
+        semantic_analyzer_.analyze_asm_declaration(node);
+    }
+};
+
+void SemanticAnalyzer::analyze_statement(syntactic::Statement& node) {
+    StatementVisitor visitor{ *this };
+    node.visit(visitor);
+}
+
+values::Value SemanticAnalyzer::dispatch_expression(syntactic::Expression& node) {
+    ExpressionVisitor visitor{ *this };
+    return node.visit(visitor);
 }
 
 /**
@@ -574,14 +859,14 @@ void check_out_of_range(const IndexListT& indices, primitives::Int size) {
     }
 }
 
-std::any SemanticAnalyzer::visit_index(syntactic::Index& node) {
+values::Value SemanticAnalyzer::analyze_index(syntactic::Index& node) {
     try {
-        auto expression = std::any_cast<values::Value>(visit_expression(*node.expr));
+        auto expression = analyze_expression(*node.expr);
         auto variable_ref_ptr = expression->as_variable_ref();
         const auto variable_link = variable_ref_ptr->variable;
         const auto variable_type = variable_link->typ;
         if (variable_type->as_qubit_array() || variable_type->as_bit_array()) {
-            auto indices = std::any_cast<IndexListT>(visit_index_list(*node.indices));
+            auto indices = analyze_index_list(*node.indices);
             check_out_of_range(indices, types::size_of(variable_type));
             auto ret = tree::make<values::IndexRef>(variable_link, indices);
             return values::Value{ ret };
@@ -595,15 +880,19 @@ std::any SemanticAnalyzer::visit_index(syntactic::Index& node) {
     }
 }
 
-std::any SemanticAnalyzer::visit_index_list(syntactic::IndexList& index_list_ast) {
+std::any SemanticAnalyzer::visit_index(syntactic::Index& node) {
+    return analyze_index(node);
+}
+
+IndexListT SemanticAnalyzer::analyze_index_list(syntactic::IndexList& index_list_ast) {
     auto ret = IndexListT{};
     for (const auto& index_entry : index_list_ast.items) {
         if (auto index_item = index_entry->as_index_item()) {
             // Single index
-            ret.add(std::any_cast<tree::One<IndexT>>(visit_index_item(*index_item)));
+            ret.add(analyze_index_item(*index_item));
         } else if (auto index_range = index_entry->as_index_range()) {
             // Range notation
-            ret.extend(std::any_cast<IndexListT>(visit_index_range(*index_range)));
+            ret.extend(analyze_index_range(*index_range));
         } else {
             throw std::runtime_error{ "unknown IndexEntry AST node" };
         }
@@ -611,14 +900,22 @@ std::any SemanticAnalyzer::visit_index_list(syntactic::IndexList& index_list_ast
     return ret;
 }
 
-std::any SemanticAnalyzer::visit_index_item(syntactic::IndexItem& index_item_ast) {
+std::any SemanticAnalyzer::visit_index_list(syntactic::IndexList& index_list_ast) {
+    return analyze_index_list(index_list_ast);
+}
+
+tree::One<IndexT> SemanticAnalyzer::analyze_index_item(syntactic::IndexItem& index_item_ast) {
     auto index_item = visit_const_int(*index_item_ast.index);
     auto index_value_sp = tree::make<IndexT>(index_item);
     index_value_sp->copy_annotation<parser::SourceLocation>(index_item_ast);
     return index_value_sp;
 }
 
-std::any SemanticAnalyzer::visit_index_range(syntactic::IndexRange& index_range_ast) {
+std::any SemanticAnalyzer::visit_index_item(syntactic::IndexItem& index_item_ast) {
+    return analyze_index_item(index_item_ast);
+}
+
+IndexListT SemanticAnalyzer::analyze_index_range(syntactic::IndexRange& index_range_ast) {
     auto first = visit_const_int(*index_range_ast.first);
     auto last = visit_const_int(*index_range_ast.last);
     if (first > last) {
@@ -633,8 +930,12 @@ std::any SemanticAnalyzer::visit_index_range(syntactic::IndexRange& index_range_
     return ret;
 }
 
+std::any SemanticAnalyzer::visit_index_range(syntactic::IndexRange& index_range_ast) {
+    return analyze_index_range(index_range_ast);
+}
+
 std::any SemanticAnalyzer::visit_identifier(syntactic::Identifier& node) {
-    return analyzer_.resolve_variable(node.name);
+    return dispatch_expression(node);
 }
 
 /**
@@ -647,18 +948,15 @@ void check_initialization_list_element_type(const values::Value& value) {
 }
 
 std::any SemanticAnalyzer::visit_boolean_literal(syntactic::BooleanLiteral& node) {
-    auto ret = tree::make<values::ConstBool>(node.value);
-    return values::Value{ ret };
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_integer_literal(syntactic::IntegerLiteral& node) {
-    auto ret = tree::make<values::ConstInt>(node.value);
-    return values::Value{ ret };
+    return dispatch_expression(node);
 }
 
 std::any SemanticAnalyzer::visit_float_literal(syntactic::FloatLiteral& node) {
-    auto ret = tree::make<values::ConstFloat>(node.value);
-    return values::Value{ ret };
+    return dispatch_expression(node);
 }
 
 /**
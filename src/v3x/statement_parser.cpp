@@ -0,0 +1,320 @@
+/** \file
+ * Implementation for \ref include/libqasm/v3x/statement_parser.hpp "libqasm/v3x/statement_parser.hpp".
+ */
+
+#include "libqasm/v3x/statement_parser.hpp"
+
+#include "libqasm/v3x/CqasmParser.h"
+
+namespace cqasm::v3x::parser {
+
+using namespace cqasm::v3x::syntactic;
+
+class StatementParser::Parser : public CqasmParser {
+    size_t tracked_parse_tree_count_ = 0;
+
+public:
+    using CqasmParser::CqasmParser;
+
+    void enterRule(antlr4::ParserRuleContext* context, size_t state, size_t rule_index) override {
+        ++tracked_parse_tree_count_;
+        CqasmParser::enterRule(context, state, rule_index);
+    }
+
+    antlr4::tree::TerminalNode* createTerminalNode(antlr4::Token* token) override {
+        ++tracked_parse_tree_count_;
+        return CqasmParser::createTerminalNode(token);
+    }
+
+    /**
+     * Deletes all the contexts and terminal nodes created so far.
+     * Must only be called in between top-level rule invocations, when no rule context is active.
+     */
+    void release_parse_trees() {
+        _tracker.reset();
+        tracked_parse_tree_count_ = 0;
+    }
+
+    [[nodiscard]] size_t tracked_parse_tree_count() const { return tracked_parse_tree_count_; }
+};
+
+namespace {
+
+/**
+ * Holds a mark on a token stream for its lifetime.
+ * An unbuffered token stream keeps all the tokens from the first marked one,
+ * so that the tokens referenced by the parse tree of a statement remain valid until the statement has been visited,
+ * and the token stream can be rewound to the start of the statement.
+ */
+class TokenStreamMark {
+    antlr4::TokenStream& tokens_;
+    ssize_t marker_;
+
+public:
+    explicit TokenStreamMark(antlr4::TokenStream& tokens)
+    : tokens_{ tokens }
+    , marker_{ tokens.mark() } {}
+    ~TokenStreamMark() { tokens_.release(marker_); }
+
+    TokenStreamMark(const TokenStreamMark&) = delete;
+    TokenStreamMark& operator=(const TokenStreamMark&) = delete;
+};
+
+}  // namespace
+
+StatementParser::StatementParser(antlr4::TokenStream& tokens, BaseSyntacticAnalyzer& builder_visitor,
+    antlr4::ANTLRErrorListener* error_listener, bool sll, ExpressionParserType expression_parser_type)
+: parser_up_{ std::make_unique<Parser>(&tokens) }
+, builder_visitor_{ builder_visitor }
+, expression_parser_{ tokens, builder_visitor }
+, expression_parser_type_{ expression_parser_type } {
+    parser_up_->removeErrorListeners();
+    parser_up_->addErrorListener(error_listener);
+    if (sll) {
+        parser_up_->setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+        parser_up_->getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(
+            antlr4::atn::PredictionMode::SLL);
+    }
+}
+
+StatementParser::~StatementParser() = default;
+
+/**
+ * versionSection: statementSeparator* version;
+ */
+One<Version> StatementParser::parse_version() {
+    TokenStreamMark mark{ *parser_up_->getTokenStream() };
+    auto ret = std::any_cast<One<Version>>(builder_visitor_.visitVersionSection(parser_up_->versionSection()));
+    parser_up_->release_parse_trees();
+    return ret;
+}
+
+/**
+ * globalBlockSection: (statementSeparator+ globalBlockStatement)+;
+ * eofSection: statementSeparator* EOF;
+ */
+Maybe<Statement> StatementParser::parse_statement() {
+    if (done_) {
+        return {};
+    }
+    auto* tokens = parser_up_->getTokenStream();
+    TokenStreamMark mark{ *tokens };
+    auto is_statement_separator = [tokens]() {
+        auto type = tokens->LA(1);
+        return type == CqasmParser::NEW_LINE || type == CqasmParser::SEMICOLON;
+    };
+    // A statement has to be preceded by at least one statement separator.
+    // Without one, the only valid input left is the end of the program
+    if (is_statement_separator()) {
+        while (is_statement_separator()) {
+            parser_up_->statementSeparator();
+        }
+        if (tokens->LA(1) != antlr4::Token::EOF) {
+            if (expression_parser_type_ == ExpressionParserType::precedence_climbing) {
+                if (auto ret = try_parse_instruction_(); !ret.empty()) {
+                    // Release the statement separators parsed by CqasmParser
+                    parser_up_->release_parse_trees();
+                    return ret;
+                }
+            }
+            auto ret = std::any_cast<One<Statement>>(
+                builder_visitor_.visitGlobalBlockStatement(parser_up_->globalBlockStatement()));
+            parser_up_->release_parse_trees();
+            return ret;
+        }
+    }
+    parser_up_->eofSection();
+    parser_up_->release_parse_trees();
+    done_ = true;
+    return {};
+}
+
+size_t StatementParser::tracked_parse_tree_count() const {
+    return parser_up_->tracked_parse_tree_count();
+}
+
+void StatementParser::skip_statement() {
+    // The error strategy is left in error recovery mode after an error, and would not report the next one
+    parser_up_->getErrorHandler()->reset(parser_up_.get());
+    auto* tokens = parser_up_->getTokenStream();
+    for (auto type = tokens->LA(1);
+         type != CqasmParser::NEW_LINE && type != CqasmParser::SEMICOLON && type != antlr4::Token::EOF;
+         type = tokens->LA(1)) {
+        tokens->consume();
+    }
+    parser_up_->release_parse_trees();
+}
+
+/**
+ * Parses a gate or non-gate instruction with the expression parser.
+ * Returns an empty Maybe, with the token stream left untouched, if the statement has to be parsed by CqasmParser.
+ */
+Maybe<Statement> StatementParser::try_parse_instruction_() {
+    auto* tokens = parser_up_->getTokenStream();
+    auto type = tokens->LA(1);
+    if (type == CqasmParser::QUBIT_TYPE || type == CqasmParser::BIT_TYPE || type == CqasmParser::ASM) {
+        return {};
+    }
+    auto index = tokens->index();
+    try {
+        auto ret = parse_instruction_();
+        type = tokens->LA(1);
+        if (type != CqasmParser::NEW_LINE && type != CqasmParser::SEMICOLON && type != antlr4::Token::EOF) {
+            throw ExpressionParserMismatch{};
+        }
+        return ret;
+    } catch (const ExpressionParserMismatch&) {
+        tokens->seek(index);
+    }
+    return {};
+}
+
+/**
+ * instruction: gateInstruction | nonGateInstruction;
+ */
+One<Statement> StatementParser::parse_instruction_() {
+    auto* tokens = parser_up_->getTokenStream();
+    auto* token = tokens->LT(1);
+    switch (token->getType()) {
+        case CqasmParser::INV:
+        case CqasmParser::POW:
+        case CqasmParser::CTRL:
+            return parse_gate_instruction_();
+        case CqasmParser::RESET:
+        case CqasmParser::INIT:
+        case CqasmParser::BARRIER: {
+            tokens->consume();
+            auto ret = tree::make<NonGateInstruction>();
+            ret->name = tree::make<Keyword>(token->getText());
+            ret->parameters = tree::make<ExpressionList>();
+            ret->operands = tree::make<ExpressionList>();
+            ret->operands->items.add(expression_parser_.parse_expression());
+            builder_visitor_.setNodeAnnotation(ret, token);
+            return One<Statement>{ ret };
+        }
+        case CqasmParser::WAIT: {
+            tokens->consume();
+            auto ret = tree::make<NonGateInstruction>();
+            ret->name = tree::make<Keyword>(token->getText());
+            ret->parameters = tree::make<ExpressionList>();
+            expression_parser_.match(CqasmParser::OPEN_PARENS);
+            ret->parameters->items.add(expression_parser_.parse_expression());
+            expression_parser_.match(CqasmParser::CLOSE_PARENS);
+            ret->operands = tree::make<ExpressionList>();
+            ret->operands->items.add(expression_parser_.parse_expression());
+            builder_visitor_.setNodeAnnotation(ret, token);
+            return One<Statement>{ ret };
+        }
+        case CqasmParser::IDENTIFIER:
+            if (!is_measure_instruction_()) {
+                return parse_gate_instruction_();
+            }
+            [[fallthrough]];
+        default:
+            return parse_measure_instruction_();
+    }
+}
+
+/**
+ * gateInstruction: gate expressionList;
+ */
+One<Statement> StatementParser::parse_gate_instruction_() {
+    auto ret = tree::make<GateInstruction>();
+    ret->gate = parse_gate_();
+    ret->operands = expression_parser_.parse_expression_list();
+    // Set the instruction annotation to the annotation of its gate
+    builder_visitor_.copyNodeAnnotation(ret->gate, ret);
+    return One<Statement>{ ret };
+}
+
+/**
+ * gate: INV DOT gate | POW OPEN_PARENS expression CLOSE_PARENS DOT gate | CTRL DOT gate
+ *     | IDENTIFIER (OPEN_PARENS expressionList CLOSE_PARENS)?;
+ *
+ * The parameters of a named gate are always parsed if present.
+ * That is also what CqasmParser does when both choices are valid, e.g. for 'X (a) + b'.
+ * When only the choice of parsing the parentheses as part of the first operand is valid, e.g. for 'X (a), b',
+ * the parsing of the operands fails, and the instruction is left to CqasmParser.
+ */
+One<Gate> StatementParser::parse_gate_() {
+    auto* tokens = parser_up_->getTokenStream();
+    auto* token = tokens->LT(1);
+    auto ret = tree::make<Gate>();
+    ret->parameters = tree::make<ExpressionList>();
+    switch (token->getType()) {
+        case CqasmParser::INV:
+        case CqasmParser::CTRL:
+            tokens->consume();
+            ret->name = tree::make<Identifier>(token->getText());
+            expression_parser_.match(CqasmParser::DOT);
+            ret->gate = parse_gate_().get_ptr();
+            break;
+        case CqasmParser::POW:
+            tokens->consume();
+            ret->name = tree::make<Identifier>(token->getText());
+            expression_parser_.match(CqasmParser::OPEN_PARENS);
+            ret->parameters->items.add(expression_parser_.parse_expression());
+            expression_parser_.match(CqasmParser::CLOSE_PARENS);
+            expression_parser_.match(CqasmParser::DOT);
+            ret->gate = parse_gate_().get_ptr();
+            break;
+        default:
+            expression_parser_.match(CqasmParser::IDENTIFIER);
+            ret->name = tree::make<Identifier>(token->getText());
+            if (tokens->LA(1) == CqasmParser::OPEN_PARENS) {
+                tokens->consume();
+                ret->parameters = expression_parser_.parse_expression_list();
+                expression_parser_.match(CqasmParser::CLOSE_PARENS);
+            }
+            break;
+    }
+    builder_visitor_.setNodeAnnotation(ret, token);
+    return ret;
+}
+
+/**
+ * measureInstruction: expression EQUALS MEASURE (OPEN_PARENS expressionList CLOSE_PARENS)? expression;
+ *
+ * As for named gates, the parameters are always parsed if present.
+ */
+One<Statement> StatementParser::parse_measure_instruction_() {
+    auto* tokens = parser_up_->getTokenStream();
+    auto ret = tree::make<NonGateInstruction>();
+    auto lhs = expression_parser_.parse_expression();
+    expression_parser_.match(CqasmParser::EQUALS);
+    auto* measure = expression_parser_.match(CqasmParser::MEASURE);
+    ret->name = tree::make<Keyword>(measure->getText());
+    ret->parameters = tree::make<ExpressionList>();
+    if (tokens->LA(1) == CqasmParser::OPEN_PARENS) {
+        tokens->consume();
+        ret->parameters = expression_parser_.parse_expression_list();
+        expression_parser_.match(CqasmParser::CLOSE_PARENS);
+    }
+    ret->operands = tree::make<ExpressionList>();
+    ret->operands->items.add(lhs);
+    ret->operands->items.add(expression_parser_.parse_expression());
+    builder_visitor_.setNodeAnnotation(ret, measure);
+    return One<Statement>{ ret };
+}
+
+/**
+ * Checks whether the statement starting at the next token is a measure instruction.
+ * Measure instructions are the only statements that contain an EQUALS token.
+ */
+bool StatementParser::is_measure_instruction_() const {
+    auto* tokens = parser_up_->getTokenStream();
+    for (ssize_t i = 1;; ++i) {
+        switch (tokens->LA(i)) {
+            case CqasmParser::EQUALS:
+                return true;
+            case CqasmParser::NEW_LINE:
+            case CqasmParser::SEMICOLON:
+            case antlr4::Token::EOF:
+                return false;
+            default:
+                break;
+        }
+    }
+}
+
+}  // namespace cqasm::v3x::parser
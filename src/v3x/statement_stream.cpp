@@ -0,0 +1,41 @@
+/** \file
+ * Implementation for \ref include/libqasm/v3x/statement_stream.hpp "libqasm/v3x/statement_stream.hpp".
+ */
+
+#include "libqasm/v3x/statement_stream.hpp"
+
+#include <antlr4-runtime.h>
+
+#include "libqasm/v3x/antlr_custom_error_listener.hpp"
+#include "libqasm/v3x/antlr_scanner.hpp"
+#include "libqasm/v3x/statement_parser.hpp"
+#include "libqasm/v3x/syntactic_analyzer.hpp"
+#include "libqasm/v3x/utf8_char_stream.hpp"
+
+namespace cqasm::v3x::parser {
+
+StatementStream::StatementStream(
+    std::string_view data, const std::optional<std::string>& file_name, const ParseOptions& options)
+: builder_visitor_up_{ std::make_unique<SyntacticAnalyzer>(file_name, options.source_location_mode) }
+, error_listener_up_{ std::make_unique<AntlrCustomErrorListener>(file_name) }
+, char_stream_up_{ std::make_unique<Utf8CharStream>(data) }
+, lexer_up_{ create_lexer(*char_stream_up_, error_listener_up_.get(), options.lexer_type) } {
+    builder_visitor_up_->addErrorListener(error_listener_up_.get());
+    // The unbuffered token stream lexes its first token on construction
+    tokens_up_ = std::make_unique<antlr4::UnbufferedTokenStream>(lexer_up_.get());
+    statement_parser_up_ = std::make_unique<StatementParser>(
+        *tokens_up_, *builder_visitor_up_, error_listener_up_.get(), false, options.expression_parser);
+    version_ = statement_parser_up_->parse_version();
+}
+
+StatementStream::~StatementStream() = default;
+
+const syntactic::One<syntactic::Version>& StatementStream::version() const {
+    return version_;
+}
+
+syntactic::Maybe<syntactic::Statement> StatementStream::next() {
+    return statement_parser_up_->parse_statement();
+}
+
+}  // namespace cqasm::v3x::parser
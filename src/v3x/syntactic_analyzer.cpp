@@ -4,10 +4,11 @@
 
 #include <algorithm>  // for_each
 #include <cassert>  // assert
+#include <charconv>  // from_chars
 #include <cstdint>  // uint32_t
-#include <regex>
-#include <stdexcept>  // runtime_error
-#include <string>  // stod, stoll
+#include <stdexcept>  // out_of_range, runtime_error
+#include <string>  // stod
+#include <system_error>  // errc
 
 #include "libqasm/annotations.hpp"
 #include "libqasm/tree.hpp"
@@ -15,6 +16,7 @@
 #include "libqasm/v3x/antlr_custom_error_listener.hpp"
 #include "libqasm/v3x/syntactic.hpp"
 #include "libqasm/v3x/types.hpp"
+#include "libqasm/v3x/utf8_char_stream.hpp"
 
 namespace cqasm::v3x::parser {
 
@@ -22,12 +24,15 @@ using namespace cqasm::error;
 using namespace cqasm::utils;
 using namespace cqasm::v3x::syntactic;
 
-SyntacticAnalyzer::SyntacticAnalyzer(const std::optional<std::string>& file_name)
-: file_name_{ file_name }
+SyntacticAnalyzer::SyntacticAnalyzer(
+    const std::optional<std::string>& file_name, SourceLocationMode source_location_mode)
+: source_location_mode_{ source_location_mode }
 , error_listener_p_{ nullptr } {
-    if (file_name_.has_value() && file_name_.value().empty()) {
-        file_name_ = std::nullopt;
-    }
+    set_file_name(file_name);
+}
+
+void SyntacticAnalyzer::set_file_name(const std::optional<std::string>& file_name) {
+    file_name_ = file_name;
 }
 
 void SyntacticAnalyzer::addErrorListener(AntlrCustomErrorListener* error_listener) {
@@ -44,6 +49,9 @@ void SyntacticAnalyzer::syntaxError(size_t line, size_t char_position_in_line, c
  * We change it here to a one-based index, which is the more human-readable, and the common option in text editors
  */
 void SyntacticAnalyzer::setNodeAnnotation(const syntactic::One<syntactic::Node>& node, antlr4::Token* token) const {
+    if (source_location_mode_ == SourceLocationMode::statements && node->as_annotated() == nullptr) {
+        return;
+    }
     auto token_size = token->getStopIndex() - token->getStartIndex() + 1;
     node->set_annotation(annotations::SourceLocation{
         file_name_,
@@ -68,41 +76,64 @@ void SyntacticAnalyzer::copyNodeAnnotation(
     to->copy_annotation<annotations::SourceLocation>(*from);
 }
 
-std::int64_t SyntacticAnalyzer::get_int_value(
-    size_t line, size_t char_position_in_line, const std::string& text) const {
-    try {
-        return std::stoll(text);
-    } catch (std::out_of_range&) {
+std::int64_t SyntacticAnalyzer::get_int_value(size_t line, size_t char_position_in_line, std::string_view text) const {
+    std::int64_t ret{};
+    if (std::from_chars(text.data(), text.data() + text.size(), ret).ec == std::errc::result_out_of_range) {
         syntaxError(line, char_position_in_line, fmt::format("value '{}' is out of the INTEGER_LITERAL range", text));
     }
-    return {};
+    return ret;
 }
 
-double SyntacticAnalyzer::get_float_value(size_t line, size_t char_position_in_line, const std::string& text) const {
+/**
+ * Floating-point std::from_chars is not available in every supported standard library, e.g. not before GCC 11,
+ * in which case the text is copied into a string for std::stod
+ */
+double SyntacticAnalyzer::get_float_value(size_t line, size_t char_position_in_line, std::string_view text) const {
+#if defined(__cpp_lib_to_chars)
+    double ret{};
+    if (std::from_chars(text.data(), text.data() + text.size(), ret).ec == std::errc::result_out_of_range) {
+        syntaxError(line, char_position_in_line, fmt::format("value '{}' is out of the FLOAT_LITERAL range", text));
+        return {};
+    }
+    return ret;
+#else
     try {
-        return std::stod(text);
+        return std::stod(std::string{ text });
     } catch (std::out_of_range&) {
         syntaxError(line, char_position_in_line, fmt::format("value '{}' is out of the FLOAT_LITERAL range", text));
     }
     return {};
+#endif
 }
 
 bool SyntacticAnalyzer::get_bool_value(antlr4::tree::TerminalNode* node) const {
-    assert(node->getSymbol()->getType() == CqasmParser::BOOLEAN_LITERAL);
-    return node->getText() == "true";
+    return getBoolValue(node->getSymbol());
 }
 
 std::int64_t SyntacticAnalyzer::get_int_value(antlr4::tree::TerminalNode* node) const {
-    const auto token = node->getSymbol();
-    assert(token->getType() == CqasmParser::INTEGER_LITERAL);
-    return get_int_value(token->getLine(), token->getCharPositionInLine(), node->getText());
+    return getIntValue(node->getSymbol());
 }
 
 double SyntacticAnalyzer::get_float_value(antlr4::tree::TerminalNode* node) const {
-    const auto token = node->getSymbol();
-    const auto& text = node->getText();
+    return getFloatValue(node->getSymbol());
+}
+
+bool SyntacticAnalyzer::getBoolValue(antlr4::Token* token) const {
+    assert(token->getType() == CqasmParser::BOOLEAN_LITERAL);
+    std::string buffer{};
+    return get_token_text(*token, buffer) == "true";
+}
+
+std::int64_t SyntacticAnalyzer::getIntValue(antlr4::Token* token) const {
+    assert(token->getType() == CqasmParser::INTEGER_LITERAL);
+    std::string buffer{};
+    return get_int_value(token->getLine(), token->getCharPositionInLine(), get_token_text(*token, buffer));
+}
+
+double SyntacticAnalyzer::getFloatValue(antlr4::Token* token) const {
     assert(token->getType() == CqasmParser::FLOAT_LITERAL);
-    return get_float_value(token->getLine(), token->getCharPositionInLine(), text);
+    std::string buffer{};
+    return get_float_value(token->getLine(), token->getCharPositionInLine(), get_token_text(*token, buffer));
 }
 
 std::any SyntacticAnalyzer::visitProgram(CqasmParser::ProgramContext* context) {
@@ -138,14 +169,14 @@ std::any SyntacticAnalyzer::visitStatementSeparator(CqasmParser::StatementSepara
 std::any SyntacticAnalyzer::visitVersion(CqasmParser::VersionContext* context) {
     auto ret = tree::make<Version>();
     const auto token = context->VERSION_NUMBER()->getSymbol();
-    const auto& text = context->VERSION_NUMBER()->getText();
-    const std::regex pattern{ "([0-9]+)(?:\\.([0-9]+))?" };
-    std::smatch matches{};
-    std::regex_match(text, matches, pattern);
-    ret->items.push_back(get_int_value(token->getLine(), token->getCharPositionInLine(), matches[1]));
-    if (matches[2].matched) {
+    std::string buffer{};
+    // VERSION_NUMBER: Digit+ ('.' Digit+)?
+    auto text = get_token_text(*token, buffer);
+    auto dot = text.find('.');
+    ret->items.push_back(get_int_value(token->getLine(), token->getCharPositionInLine(), text.substr(0, dot)));
+    if (dot != std::string_view::npos) {
         ret->items.push_back(
-            get_int_value(token->getLine(), token->getCharPositionInLine() + matches.position(2), matches[2]));
+            get_int_value(token->getLine(), token->getCharPositionInLine() + dot + 1, text.substr(dot + 1)));
     }
     setNodeAnnotation(ret, token);
     return ret;
@@ -279,7 +310,12 @@ std::any SyntacticAnalyzer::visitWaitInstruction(CqasmParser::WaitInstructionCon
 std::any SyntacticAnalyzer::visitAsmDeclaration(CqasmParser::AsmDeclarationContext* context) {
     auto ret = tree::make<AsmDeclaration>();
     ret->backend_name = tree::make<Identifier>(context->IDENTIFIER()->getText());
-    ret->backend_code = remove_triple_quotes(context->RAW_TEXT_STRING()->getText());
+    // The backend code is copied once, from a view of the raw text string without its triple quotes,
+    // into the buffer of the raw text, which is later shared with the semantic asm declaration
+    std::string buffer{};
+    auto raw_text_string = get_token_text(*context->RAW_TEXT_STRING()->getSymbol(), buffer);
+    assert(raw_text_string.size() >= 6);
+    ret->backend_code = primitives::RawText{ raw_text_string.substr(3, raw_text_string.size() - 6) };
     return One<Statement>{ ret };
 }
 
@@ -0,0 +1,117 @@
+/** \file
+ * Implementation for \ref include/libqasm/v3x/syntax_checker.hpp "libqasm/v3x/syntax_checker.hpp".
+ */
+
+#include "libqasm/v3x/syntax_checker.hpp"
+
+#include <antlr4-runtime.h>
+
+#include <algorithm>  // min
+#include <memory>  // make_shared
+
+#include "libqasm/memory_mapped_file.hpp"
+#include "libqasm/v3x/CqasmParser.h"
+#include "libqasm/v3x/antlr_custom_error_listener.hpp"
+#include "libqasm/v3x/antlr_scanner.hpp"
+#include "libqasm/v3x/syntactic_analyzer.hpp"
+#include "libqasm/v3x/utf8_char_stream.hpp"
+
+namespace cqasm::v3x::parser {
+
+namespace {
+
+/**
+ * Recognizes the tokens with either SLL or full LL prediction, without building a parse tree.
+ * SLL recognition throws a ParseCancellationException at the first parser error, without reporting it.
+ */
+void recognize(antlr4::CommonTokenStream& tokens, antlr4::ANTLRErrorListener* error_listener, bool sll) {
+    CqasmParser parser{ &tokens };
+    parser.removeErrorListeners();
+    parser.addErrorListener(error_listener);
+    parser.setBuildParseTree(false);
+    if (sll) {
+        parser.setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+        parser.getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(
+            antlr4::atn::PredictionMode::SLL);
+    }
+    parser.program();
+}
+
+/**
+ * Checks the values of the literals of a recognized program are in range,
+ * as the syntactic analyzer does when building their nodes.
+ * Each component of the version number is checked as an integer literal.
+ */
+void check_literals(antlr4::CommonTokenStream& tokens, const SyntacticAnalyzer& builder_visitor) {
+    for (auto* token : tokens.getTokens()) {
+        switch (token->getType()) {
+            case CqasmParser::INTEGER_LITERAL:
+                static_cast<void>(builder_visitor.getIntValue(token));
+                break;
+            case CqasmParser::FLOAT_LITERAL:
+                static_cast<void>(builder_visitor.getFloatValue(token));
+                break;
+            case CqasmParser::VERSION_NUMBER: {
+                const auto& text = token->getText();
+                for (size_t start = 0; start < text.size();) {
+                    auto end = std::min(text.find('.', start), text.size());
+                    antlr4::CommonToken component{ CqasmParser::INTEGER_LITERAL, text.substr(start, end - start) };
+                    component.setLine(token->getLine());
+                    component.setCharPositionInLine(token->getCharPositionInLine() + start);
+                    static_cast<void>(builder_visitor.getIntValue(&component));
+                    start = end + 1;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * Checks the syntax of the input stream, stopping at the first error, as parse_string does.
+ */
+error::ParseErrors check(
+    antlr4::CharStream& is, const std::optional<std::string>& file_name, const ParseOptions& options) {
+    AntlrCustomErrorListener error_listener{ file_name };
+    SyntacticAnalyzer builder_visitor{ file_name };
+    builder_visitor.addErrorListener(&error_listener);
+    try {
+        if (options.prediction_strategy == PredictionStrategy::sll_then_ll) {
+            BailErrorListener bail_error_listener{};
+            auto lexer_up = create_lexer(is, &bail_error_listener, options.lexer_type);
+            antlr4::CommonTokenStream tokens{ lexer_up.get() };
+            try {
+                recognize(tokens, &bail_error_listener, true);
+                check_literals(tokens, builder_visitor);
+                return {};
+            } catch (const antlr4::ParseCancellationException&) {
+                is.seek(0);
+            }
+        }
+        auto lexer_up = create_lexer(is, &error_listener, options.lexer_type);
+        antlr4::CommonTokenStream tokens{ lexer_up.get() };
+        recognize(tokens, &error_listener, false);
+        check_literals(tokens, builder_visitor);
+    } catch (const error::ParseError& error) {
+        return { error };
+    }
+    return {};
+}
+
+}  // namespace
+
+error::ParseErrors check_string(
+    std::string_view data, const std::optional<std::string>& file_name, const ParseOptions& options) {
+    Utf8CharStream is{ data };
+    return check(is, file_name, options);
+}
+
+error::ParseErrors check_file(
+    const std::string& file_path, const std::optional<std::string>& file_name, const ParseOptions& options) {
+    MemoryMappedFile file{ file_path };
+    return check_string(file.data(), file_name, options);
+}
+
+}  // namespace cqasm::v3x::parser
@@ -0,0 +1,209 @@
+/** \file
+ * Implementation for \ref include/libqasm/v3x/utf8_char_stream.hpp "libqasm/v3x/utf8_char_stream.hpp".
+ */
+
+#include "libqasm/v3x/utf8_char_stream.hpp"
+
+#include <algorithm>  // min
+#include <cstdint>  // uint8_t, uint32_t
+#include <utility>  // move, pair
+
+namespace cqasm::v3x::parser {
+
+namespace {
+
+constexpr std::uint32_t replacement_character = 0xFFFD;
+
+constexpr bool is_continuation_byte(std::uint8_t byte) {
+    return (byte & 0xC0) == 0x80;
+}
+
+/**
+ * Decodes the code point at the start of the given bytes.
+ * Returns the code point and its size in bytes,
+ * or the replacement character and a size of 1 if the bytes do not start with a valid UTF-8 sequence.
+ */
+constexpr std::pair<std::uint32_t, size_t> decode_utf8(std::string_view bytes) {
+    auto lead = static_cast<std::uint8_t>(bytes[0]);
+    if (lead < 0x80) {
+        return { lead, 1 };
+    }
+    size_t size = 0;
+    std::uint32_t code_point = 0;
+    std::uint32_t min_code_point = 0;
+    if ((lead & 0xE0) == 0xC0) {
+        size = 2;
+        code_point = lead & 0x1F;
+        min_code_point = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        size = 3;
+        code_point = lead & 0x0F;
+        min_code_point = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        size = 4;
+        code_point = lead & 0x07;
+        min_code_point = 0x10000;
+    } else {
+        return { replacement_character, 1 };
+    }
+    if (bytes.size() < size) {
+        return { replacement_character, 1 };
+    }
+    for (size_t i = 1; i < size; ++i) {
+        auto byte = static_cast<std::uint8_t>(bytes[i]);
+        if (!is_continuation_byte(byte)) {
+            return { replacement_character, 1 };
+        }
+        code_point = (code_point << 6) | (byte & 0x3F);
+    }
+    // Reject overlong encodings, surrogates, and code points beyond the Unicode range
+    if (code_point < min_code_point || (code_point >= 0xD800 && code_point <= 0xDFFF) || code_point > 0x10FFFF) {
+        return { replacement_character, 1 };
+    }
+    return { code_point, size };
+}
+
+}  // namespace
+
+Utf8CharStream::Utf8CharStream(std::string_view data, std::string source_name)
+: data_{ data }
+, source_name_{ std::move(source_name) } {}
+
+/**
+ * Size in bytes of the code point starting at the given index.
+ */
+size_t Utf8CharStream::code_point_size(size_t index) const {
+    if (static_cast<std::uint8_t>(data_[index]) < 0x80) {
+        return 1;
+    }
+    return decode_utf8(data_.substr(index)).second;
+}
+
+/**
+ * Index of the code point preceding the one starting at the given index.
+ * A continuation byte is only part of a preceding code point if that code point is valid.
+ */
+size_t Utf8CharStream::previous_code_point_index(size_t index) const {
+    for (size_t size = 2; size <= 4 && size <= index; ++size) {
+        if (!is_continuation_byte(static_cast<std::uint8_t>(data_[index - size + 1]))) {
+            break;
+        }
+        if (code_point_size(index - size) == size) {
+            return index - size;
+        }
+    }
+    return index - 1;
+}
+
+/**
+ * Code point starting at the given index.
+ */
+size_t Utf8CharStream::decode(size_t index) const {
+    auto byte = static_cast<std::uint8_t>(data_[index]);
+    if (byte < 0x80) {
+        return byte;
+    }
+    return decode_utf8(data_.substr(index)).first;
+}
+
+void Utf8CharStream::consume() {
+    if (index_ >= data_.size()) {
+        throw antlr4::IllegalStateException{ "cannot consume EOF" };
+    }
+    index_ += code_point_size(index_);
+}
+
+size_t Utf8CharStream::LA(ssize_t i) {
+    if (i == 0) {
+        return 0;  // undefined
+    }
+    auto index = index_;
+    if (i > 0) {
+        for (; i > 1 && index < data_.size(); --i) {
+            index += code_point_size(index);
+        }
+        return (index < data_.size()) ? decode(index) : antlr4::IntStream::EOF;
+    }
+    for (; i < 0; ++i) {
+        if (index == 0) {
+            return antlr4::IntStream::EOF;  // invalid; no char before first char
+        }
+        index = previous_code_point_index(index);
+    }
+    return decode(index);
+}
+
+/**
+ * The whole input is always available, so marks are not needed.
+ */
+ssize_t Utf8CharStream::mark() {
+    return -1;
+}
+
+void Utf8CharStream::release(ssize_t /* marker */) {}
+
+size_t Utf8CharStream::index() {
+    return index_;
+}
+
+/**
+ * The index has to be the start of a code point, as returned by index().
+ */
+void Utf8CharStream::seek(size_t index) {
+    index_ = std::min(index, data_.size());
+}
+
+/**
+ * Size of the input in bytes.
+ */
+size_t Utf8CharStream::size() {
+    return data_.size();
+}
+
+std::string Utf8CharStream::getSourceName() const {
+    return source_name_.empty() ? antlr4::IntStream::UNKNOWN_SOURCE_NAME : source_name_;
+}
+
+/**
+ * Returns the input bytes from the start of the interval up to the end of the code point containing its stop index.
+ * So both the stop index of a token, i.e. the last byte of its last code point,
+ * and the index of the current code point, e.g. for the offending character of a lexer error, work as expected.
+ */
+std::string Utf8CharStream::getText(const antlr4::misc::Interval& interval) {
+    return std::string{ get_text_view(interval) };
+}
+
+std::string_view Utf8CharStream::get_text_view(const antlr4::misc::Interval& interval) const {
+    if (interval.a < 0 || interval.b < interval.a || static_cast<size_t>(interval.a) >= data_.size()) {
+        return {};
+    }
+    auto start = static_cast<size_t>(interval.a);
+    auto last = std::min(static_cast<size_t>(interval.b), data_.size() - 1);
+    auto stop = start;
+    while (stop <= last) {
+        stop += code_point_size(stop);
+    }
+    return data_.substr(start, stop - start);
+}
+
+size_t Utf8CharStream::count_code_points(size_t start, size_t stop) const {
+    size_t ret = 0;
+    for (auto index = start; index < std::min(stop, data_.size()); index += code_point_size(index)) {
+        ++ret;
+    }
+    return ret;
+}
+
+std::string Utf8CharStream::toString() const {
+    return std::string{ data_ };
+}
+
+std::string_view get_token_text(const antlr4::Token& token, std::string& buffer) {
+    if (const auto* is = dynamic_cast<const Utf8CharStream*>(token.getInputStream()); is != nullptr) {
+        return is->get_text_view(antlr4::misc::Interval{ token.getStartIndex(), token.getStopIndex() });
+    }
+    buffer = token.getText();
+    return buffer;
+}
+
+}  // namespace cqasm::v3x::parser
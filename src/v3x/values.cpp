@@ -63,6 +63,15 @@ Value promote(const Value& value, const types::Type& type) {
     return ret;
 }
 
+/**
+ * Returns a code made of the node kinds of the given value and of its type.
+ * Whether and how promote promotes a value to a type only depends on this code and on the type.
+ */
+std::uint16_t promotion_code(const Value& value) {
+    return static_cast<std::uint16_t>(
+        (static_cast<unsigned>(value->type()) << 8) | static_cast<unsigned>(type_of(value)->type()));
+}
+
 /**
  * Checks if a from_type can be promoted to a to_type.
  */
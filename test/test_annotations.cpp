@@ -2,6 +2,8 @@
 #include <gmock/gmock.h>
 
 #include <optional>
+#include <string>
+#include <utility>  // move
 
 #include "libqasm/annotations.hpp"  // SourceLocation
 
@@ -52,3 +54,37 @@ TEST(source_location_constructor, unknown_file_name__yes_line_numbers__yes_colum
     };
     EXPECT_EQ(fmt::format("{}", location), "<unknown file name>:10:12..15");
 }
+
+TEST(file_name, equal_file_names_share_the_same_entry) {
+    auto file_name = FileName{ "input.cq" };
+    EXPECT_TRUE(file_name.has_value());
+    EXPECT_EQ(FileName{ std::string{ "input.cq" } }, file_name);
+    EXPECT_EQ(FileName{ std::optional<std::string>{ "input.cq" } }, file_name);
+    EXPECT_NE(FileName{ "other.cq" }, file_name);
+    EXPECT_EQ(&FileName{ "input.cq" }.value(), &file_name.value());
+    EXPECT_EQ(file_name.value(), "input.cq");
+    EXPECT_EQ(file_name, "input.cq");
+}
+TEST(file_name, empty_file_name_is_no_file_name) {
+    for (const auto& file_name : { FileName{}, FileName{ std::nullopt }, FileName{ "" } }) {
+        EXPECT_FALSE(file_name.has_value());
+        EXPECT_EQ(file_name, FileName{});
+        EXPECT_EQ(file_name.value_or("default"), "default");
+        EXPECT_THROW(static_cast<void>(file_name.value()), std::bad_optional_access);
+    }
+}
+TEST(file_name, names_are_freed_with_their_last_file_name) {
+    auto table_size = FileName::table_size();
+    {
+        auto file_name = FileName{ "reclaimed_file_name.cq" };
+        auto copy = file_name;
+        auto moved = std::move(file_name);
+        EXPECT_EQ(FileName::table_size(), table_size + 1);
+        EXPECT_EQ(moved, copy);
+        EXPECT_FALSE(file_name.has_value());  // NOLINT(bugprone-use-after-move)
+    }
+    EXPECT_EQ(FileName::table_size(), table_size);
+}
+TEST(file_name, source_locations_do_not_hold_a_copy_of_the_file_name) {
+    EXPECT_LE(sizeof(SourceLocation), sizeof(void*) + sizeof(SourceLocation::Range));
+}
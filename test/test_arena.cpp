@@ -0,0 +1,63 @@
+#include "libqasm/arena.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>  // uintptr_t
+#include <memory>  // allocate_shared, make_shared, weak_ptr
+#include <string>
+
+namespace cqasm::tree {
+
+TEST(ArenaTest, allocations_are_aligned_and_do_not_overlap) {
+    Arena arena{};
+    auto* first = static_cast<char*>(arena.allocate(3, 1));
+    auto* second = static_cast<char*>(arena.allocate(8, 8));
+    auto* third = static_cast<char*>(arena.allocate(16, 16));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) % 8, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(third) % 16, 0);
+    EXPECT_GE(second, first + 3);
+    EXPECT_GE(third, second + 8);
+    EXPECT_EQ(arena.number_of_allocations(), 3);
+    EXPECT_EQ(arena.number_of_chunks(), 1);
+    EXPECT_EQ(arena.memory_usage(), Arena::initial_chunk_size);
+}
+
+TEST(ArenaTest, chunks_grow_and_large_allocations_get_a_chunk_of_their_own) {
+    Arena arena{};
+    for (auto i = 0; i < 2; ++i) {
+        static_cast<void>(arena.allocate(Arena::initial_chunk_size / 2 + 1, 1));
+    }
+    EXPECT_EQ(arena.number_of_chunks(), 2);
+    EXPECT_EQ(arena.memory_usage(), 3 * Arena::initial_chunk_size);
+    static_cast<void>(arena.allocate(2 * Arena::max_chunk_size, 8));
+    EXPECT_EQ(arena.number_of_chunks(), 3);
+    EXPECT_GE(arena.memory_usage(), 2 * Arena::max_chunk_size);
+}
+
+TEST(ArenaTest, objects_share_the_ownership_of_their_arena) {
+    auto arena = std::make_shared<Arena>();
+    std::weak_ptr<Arena> weak_arena = arena;
+    auto object = std::allocate_shared<std::string>(ArenaAllocator<std::string>{ arena }, "allocated from an arena");
+    arena.reset();
+    EXPECT_FALSE(weak_arena.expired());
+    EXPECT_EQ(*object, "allocated from an arena");
+    object.reset();
+    EXPECT_TRUE(weak_arena.expired());
+}
+
+TEST(ArenaTest, scopes_set_the_current_arena) {
+    EXPECT_EQ(Arena::current(), nullptr);
+    auto arena = std::make_shared<Arena>();
+    {
+        ArenaScope arena_scope{ arena };
+        EXPECT_EQ(Arena::current(), arena);
+        {
+            ArenaScope heap_scope{ nullptr };
+            EXPECT_EQ(Arena::current(), nullptr);
+        }
+        EXPECT_EQ(Arena::current(), arena);
+    }
+    EXPECT_EQ(Arena::current(), nullptr);
+}
+
+}  // namespace cqasm::tree
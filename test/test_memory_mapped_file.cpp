@@ -0,0 +1,43 @@
+#include "libqasm/memory_mapped_file.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+
+#include "libqasm/error.hpp"
+#include "utils.hpp"
+
+namespace fs = std::filesystem;
+
+namespace cqasm {
+
+class MemoryMappedFileTest : public ::testing::Test {
+protected:
+    void TearDown() override { fs::remove(file_path); }
+
+    fs::path file_path = fs::temp_directory_path() / "libqasm_test_memory_mapped_file.cq";
+};
+
+TEST_F(MemoryMappedFileTest, data_is_the_file_contents) {
+    std::string contents = "version 3.0\n\nqubit[2] q\n// caf\xc3\xa9\nH q[0]\n";
+    test::write_file(file_path, contents);
+    MemoryMappedFile file{ file_path };
+    EXPECT_EQ(file.data(), contents);
+}
+
+TEST_F(MemoryMappedFileTest, empty_file) {
+    test::write_file(file_path, "");
+    MemoryMappedFile file{ file_path };
+    EXPECT_TRUE(file.data().empty());
+}
+
+TEST_F(MemoryMappedFileTest, missing_file) {
+    EXPECT_THROW(MemoryMappedFile{ file_path }, error::ParseError);
+}
+
+TEST_F(MemoryMappedFileTest, directory) {
+    EXPECT_THROW(MemoryMappedFile{ fs::temp_directory_path() }, error::ParseError);
+}
+
+}  // namespace cqasm
@@ -24,6 +24,23 @@ namespace fs = std::filesystem;
 class IntegrationTest : public ::testing::Test {
     fs::path path_{};
 
+    static std::string get_ast_dump(const parser::ParseResult& parse_result) {
+        return parse_result.errors.empty() ? fmt::format("SUCCESS\n{}\n", *parse_result.root)
+                                           : fmt::format("ERROR\n{}\n", fmt::join(parse_result.errors, "\n"));
+    }
+
+    static std::string get_semantic_dump(const analyzer::AnalysisResult& analysis_result) {
+        return analysis_result.errors.empty()
+            ? fmt::format("SUCCESS\n{}\n", *analysis_result.root)
+            : fmt::format("ERROR\n{}\n", fmt::join(analysis_result.errors, "\n"));
+    }
+
+    static void register_defaults(analyzer::Analyzer& analyzer) {
+        analyzer.register_default_constants();
+        analyzer.register_default_functions();
+        analyzer.register_default_instructions();
+    }
+
 public:
     explicit IntegrationTest(fs::path path)
     : path_{ std::move(path) } {}
@@ -36,9 +53,7 @@ public:
         parse_result = parser::parse_string(input, "input.cq");
 
         // Check the debug dump of the parse result
-        std::string ast_actual_file_contents = parse_result.errors.empty()
-            ? fmt::format("SUCCESS\n{}\n", *parse_result.root)
-            : fmt::format("ERROR\n{}\n", fmt::join(parse_result.errors, "\n"));
+        std::string ast_actual_file_contents = get_ast_dump(parse_result);
         std::string ast_golden_file_contents{};
         auto ast_actual_file_path = path_ / "ast.actual.txt";
         auto ast_golden_file_path = path_ / "ast.golden.txt";
@@ -46,6 +61,20 @@ public:
         EXPECT_TRUE(cqasm::test::read_file(ast_golden_file_path, ast_golden_file_contents));
         EXPECT_TRUE(ast_actual_file_contents == ast_golden_file_contents);
 
+        // Check the other parse options lead to the same parse result
+        for (const auto& options : std::vector<parser::ParseOptions>{
+                 { .lexer_type = parser::LexerType::hand_written },
+                 { .prediction_strategy = parser::PredictionStrategy::sll_then_ll },
+                 { .lexer_type = parser::LexerType::hand_written,
+                     .build_mode = parser::BuildMode::statement_by_statement },
+                 { .build_mode = parser::BuildMode::statement_by_statement,
+                     .expression_parser = parser::ExpressionParserType::precedence_climbing },
+                 { .build_mode = parser::BuildMode::parallel_chunks },
+             }) {
+            auto other_parse_result = parser::parse_string(input, "input.cq", options);
+            EXPECT_TRUE(get_ast_dump(other_parse_result) == ast_golden_file_contents);
+        }
+
         // Check the JSON dump of the parse result
         if (auto json_golden_file_path = path_ / "ast.golden.json"; fs::exists(json_golden_file_path)) {
             auto json_actual_file_path = path_ / "ast.actual.json";
@@ -68,18 +97,13 @@ public:
         // If there were no errors, try semantic analysis
         for (const auto& api_version : std::vector<std::string>({ "3.0" })) {
             auto analyzer = analyzer::Analyzer{ api_version };
-
-            analyzer.register_default_constants();
-            analyzer.register_default_functions();
-            analyzer.register_default_instructions();
+            register_defaults(analyzer);
 
             // Run the actual semantic analysis
             auto analysis_result = analyzer.analyze(*parse_result.root->as_program());
 
             // Check the debug dump of the analysis result
-            std::string semantic_actual_file_contents = analysis_result.errors.empty()
-                ? fmt::format("SUCCESS\n{}\n", *analysis_result.root)
-                : fmt::format("ERROR\n{}\n", fmt::join(analysis_result.errors, "\n"));
+            std::string semantic_actual_file_contents = get_semantic_dump(analysis_result);
             auto semantic_actual_file_path = path_ / fmt::format("semantic.{}.actual.txt", api_version);
             auto semantic_golden_file_path = path_ / fmt::format("semantic.{}.golden.txt", api_version);
             cqasm::test::write_file(semantic_actual_file_path, semantic_actual_file_contents);
@@ -87,6 +111,13 @@ public:
             EXPECT_TRUE(cqasm::test::read_file(semantic_golden_file_path, semantic_golden_file_contents));
             EXPECT_TRUE(semantic_actual_file_contents == semantic_golden_file_contents);
 
+            // Check the fused pipeline leads to the same analysis result
+            auto fused_analyzer = analyzer::Analyzer{ api_version };
+            register_defaults(fused_analyzer);
+            fused_analyzer.pipeline_mode = analyzer::PipelineMode::fused;
+            auto fused_analysis_result = fused_analyzer.analyze_string(input, "input.cq");
+            EXPECT_TRUE(get_semantic_dump(fused_analysis_result) == semantic_golden_file_contents);
+
             // Check the JSON dump of the analysis result
             if (auto semantic_json_golden_file_path = path_ / fmt::format("semantic.{}.golden.json", api_version);
                 fs::exists(semantic_json_golden_file_path)) {
@@ -9,7 +9,7 @@
 namespace cqasm::v3x::analyzer {
 
 struct MockSemanticAnalyzer : public SemanticAnalyzer {
-    explicit MockSemanticAnalyzer(Analyzer& analyzer)
+    explicit MockSemanticAnalyzer(const Analyzer& analyzer)
     : SemanticAnalyzer{ analyzer } {}
 
     [[nodiscard]] AnalysisResult& result() { return result_; }
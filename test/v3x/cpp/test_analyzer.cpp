@@ -1,10 +1,17 @@
+#include <fmt/format.h>
+#include <fmt/ranges.h>
 #include <gmock/gmock.h>
 
 #include <functional>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "libqasm/error.hpp"
 #include "libqasm/tree.hpp"
 #include "libqasm/v3x/analyzer.hpp"
+#include "libqasm/v3x/cqasm.hpp"  // default_analyzer
+#include "libqasm/v3x/parse_helper.hpp"
 #include "libqasm/v3x/parse_result.hpp"
 #include "libqasm/v3x/syntactic.hpp"
 #include "libqasm/version.hpp"
@@ -48,6 +55,84 @@ TEST_F(AnalyzerAnalyzeTest, parser_returns_errors) {
     EXPECT_THAT(error.what(), ::testing::HasSubstr(parse_error_message));
 }
 
+//--------------------------//
+// AnalyzerPipelineModeTest //
+//--------------------------//
+
+/**
+ * Analyzes the input with a default analyzer in the given pipeline mode, and returns a dump of the result.
+ */
+std::string analyze_string_dump(const std::string& input, PipelineMode pipeline_mode) {
+    auto analyzer = Analyzer{};
+    analyzer.register_default_constants();
+    analyzer.register_default_functions();
+    analyzer.register_default_instructions();
+    analyzer.pipeline_mode = pipeline_mode;
+    auto analysis_result = analyzer.analyze_string(input, "input.cq");
+    return analysis_result.errors.empty() ? fmt::format("SUCCESS\n{}\n", *analysis_result.root)
+                                          : fmt::format("ERROR\n{}\n", fmt::join(analysis_result.errors, "\n"));
+}
+
+TEST(AnalyzerPipelineModeTest, fused_pipeline_analyzes_a_program_as_the_two_phase_pipeline) {
+    std::string input = "version 3.0\nqubit[2] q\nbit[2] b\nH q[0]\nCNOT q[0], q[1]\nb = measure q\n";
+    auto dump = analyze_string_dump(input, PipelineMode::fused);
+    EXPECT_THAT(dump, StartsWith("SUCCESS"));
+    EXPECT_EQ(dump, analyze_string_dump(input, PipelineMode::two_phase));
+}
+
+TEST(AnalyzerPipelineModeTest, fused_pipeline_reports_the_same_errors_as_the_two_phase_pipeline) {
+    for (const std::string input : {
+             // Semantic errors only
+             "version 3.0\nqubit[2] q\nH r[0]\nCNOT q[0], q[0], q[1]\nX q[0]\n",
+             // Semantic errors before a parse error, which are not reported
+             "version 3.0\nqubit[2] q\nH r[0]\nCNOT q[0] q[1]\n",
+             // Parse error in the version section
+             "version 3.0 qubit[2] q\n",
+         }) {
+        auto dump = analyze_string_dump(input, PipelineMode::fused);
+        EXPECT_THAT(dump, StartsWith("ERROR"));
+        EXPECT_EQ(dump, analyze_string_dump(input, PipelineMode::two_phase));
+    }
+}
+
+//--------------------------------//
+// AnalyzerSourceLocationModeTest //
+//--------------------------------//
+
+TEST(AnalyzerSourceLocationModeTest, errors_are_reported_at_the_location_of_their_gate_or_statement) {
+    std::string input = "version 3.0\nqubit q\nRx(EU) q\n";
+    auto analyzer = Analyzer{};
+    analyzer.register_default_constants();
+    analyzer.register_default_functions();
+    analyzer.register_default_instructions();
+    EXPECT_EQ(fmt::format("{}", analyzer.analyze_string(input, "input.cq").errors[0]),
+        "Error at input.cq:3:4..6: failed to resolve variable 'EU'");
+    analyzer.source_location_mode = parser::SourceLocationMode::statements;
+    EXPECT_EQ(fmt::format("{}", analyzer.analyze_string(input, "input.cq").errors[0]),
+        "Error at input.cq:3:1..3: failed to resolve variable 'EU'");
+}
+
+//----------------------------//
+// AnalyzerAsmDeclarationTest //
+//----------------------------//
+
+TEST(AnalyzerAsmDeclarationTest, backend_code_is_shared_with_the_syntactic_tree) {
+    std::string input = "version 3.0\nasm(Backend) '''\n  a ' \" // /*\n'''\n";
+    auto parse_result = parser::parse_string(input, "input.cq");
+    ASSERT_TRUE(parse_result.errors.empty());
+    const auto& syntactic_backend_code =
+        parse_result.root->as_program()->block->statements[0]->as_asm_declaration()->backend_code;
+    EXPECT_EQ(syntactic_backend_code, "\n  a ' \" // /*\n");
+    EXPECT_EQ(syntactic_backend_code.str(), "\n  a ' \" // /*\n");
+
+    auto analyzer = Analyzer{};
+    auto analysis_result = analyzer.analyze(parse_result);
+    ASSERT_TRUE(analysis_result.errors.empty());
+    const auto& semantic_backend_code = analysis_result.root->block->statements[0]->as_asm_declaration()->backend_code;
+    EXPECT_EQ(semantic_backend_code, syntactic_backend_code);
+    EXPECT_EQ(semantic_backend_code.view().data(), syntactic_backend_code.view().data());
+}
+
 //--------------//
 // AnalyzerTest //
 //--------------//
@@ -68,8 +153,6 @@ protected:
 TEST_F(AnalyzerTest, constructor) {
     MockAnalyzer analyzer{};
     EXPECT_EQ(analyzer.scope_stack().size(), 1);
-    EXPECT_FALSE(analyzer.current_block().empty());
-    EXPECT_TRUE(analyzer.current_variables().empty());
 }
 TEST_F(AnalyzerTest, push_scope) {
     MockAnalyzer analyzer{};
@@ -81,33 +164,32 @@ TEST_F(AnalyzerTest, pop_scope) {
     analyzer.pop_scope();
     EXPECT_TRUE(analyzer.scope_stack().empty());
 }
-TEST_F(AnalyzerTest, add_statement_to_current_scope) {
-    MockAnalyzer analyzer{};
-    analyzer.add_statement_to_current_scope(statement);
-    EXPECT_EQ(analyzer.current_block()->statements.size(), 1);
+TEST_F(AnalyzerTest, add_statement_to_block) {
+    auto block = tree::make<semantic::Block>();
+    MockAnalyzer::add_statement_to_block(block, statement);
+    EXPECT_EQ(block->statements.size(), 1);
 }
-TEST_F(AnalyzerTest, add_statement_with_source_location_information_to_current_scope) {
-    MockAnalyzer analyzer{};
+TEST_F(AnalyzerTest, add_statement_with_source_location_information_to_block) {
+    auto block = tree::make<semantic::Block>();
     const auto& statement_source_location = annotations::SourceLocation{
         "input.cq", { { 10, 20 }, { 11, 10 } }
     };
     statement->set_annotation(statement_source_location);
-    analyzer.add_statement_to_current_scope(statement);
-    EXPECT_EQ(analyzer.current_block()->statements.size(), 1);
-    const auto& block_source_location = analyzer.current_block()->get_annotation<annotations::SourceLocation>();
+    MockAnalyzer::add_statement_to_block(block, statement);
+    EXPECT_EQ(block->statements.size(), 1);
+    const auto& block_source_location = block->get_annotation<annotations::SourceLocation>();
     EXPECT_EQ(block_source_location.file_name, statement_source_location.file_name);
     EXPECT_EQ(block_source_location.range, statement_source_location.range);
 }
-TEST_F(AnalyzerTest,
-    add_statement_with_source_location_information_to_current_scope_and_block_has_source_location_information) {
-    MockAnalyzer analyzer{};
+TEST_F(AnalyzerTest, add_statement_with_source_location_information_to_block_with_source_location_information) {
+    auto block = tree::make<semantic::Block>();
     //     10 15 20 25 30
     //  5      <
     //  8               >
     const auto& block_initial_source_location = annotations::SourceLocation{
         "input.cq", { { 5, 15 }, { 8, 30 } }
     };
-    analyzer.current_block()->set_annotation(block_initial_source_location);
+    block->set_annotation(block_initial_source_location);
     //     10 15 20 25 30
     // 10   <
     // 11         >
@@ -115,12 +197,12 @@ TEST_F(AnalyzerTest,
         "input.cq", { { 10, 10 }, { 11, 20 } }
     };
     statement->set_annotation(statement_source_location);
-    analyzer.add_statement_to_current_scope(statement);
-    EXPECT_EQ(analyzer.current_block()->statements.size(), 1);
+    MockAnalyzer::add_statement_to_block(block, statement);
+    EXPECT_EQ(block->statements.size(), 1);
     //     10 15 20 25 30
     //  5      <
     // 11         >
-    const auto& block_final_source_location = analyzer.current_block()->get_annotation<annotations::SourceLocation>();
+    const auto& block_final_source_location = block->get_annotation<annotations::SourceLocation>();
     EXPECT_EQ(block_final_source_location.file_name, "input.cq");
     EXPECT_EQ(block_final_source_location.range,
         (annotations::SourceLocation::Range{
@@ -129,4 +211,124 @@ TEST_F(AnalyzerTest,
     }));
 }
 
+//---------------------//
+// AnalyzerResolveTest //
+//---------------------//
+
+TEST(AnalyzerResolveTest, try_resolve_variable_looks_up_outer_scopes) {
+    MockAnalyzer analyzer{};
+    auto value = values::Value{ tree::make<values::ConstInt>(1) };
+    analyzer.register_variable("x", value);
+    analyzer.push_scope();
+    EXPECT_TRUE(analyzer.try_resolve_variable("x").equals(value));
+    EXPECT_TRUE(analyzer.try_resolve_variable("y").empty());
+    EXPECT_THAT([&]() { static_cast<void>(analyzer.resolve_variable("y")); },
+        ThrowsMessage<error::AnalysisError>(HasSubstr("failed to resolve variable 'y'")));
+}
+TEST(AnalyzerResolveTest, try_resolve_instruction_returns_empty_for_unknown_names_and_overloads) {
+    MockAnalyzer analyzer{};
+    analyzer.register_instruction("measure", "BQ");
+    auto bit = values::Value{ tree::make<values::ConstBool>(true) };
+    EXPECT_TRUE(analyzer.try_resolve_instruction("reset", values::Values{ bit }).empty());
+    EXPECT_TRUE(analyzer.try_resolve_instruction("measure", values::Values{ bit }).empty());
+    EXPECT_THAT([&]() { static_cast<void>(analyzer.resolve_instruction("measure", values::Values{ bit })); },
+        ThrowsMessage<error::AnalysisError>(HasSubstr("failed to resolve instruction 'measure'")));
+}
+TEST(AnalyzerResolveTest, memoized_resolutions_promote_each_argument_list) {
+    Analyzer analyzer{};
+    analyzer.register_consteval_core_function("identity", "f", [](const values::Values& args) { return args[0]; });
+    for (primitives::Int i : { 1, 2 }) {
+        auto arg = values::Value{ tree::make<values::ConstInt>(i) };
+        auto ret = analyzer.resolve_function("identity", values::Values{ arg });
+        ASSERT_NE(ret->as_const_float(), nullptr);
+        EXPECT_EQ(ret->as_const_float()->value, static_cast<primitives::Float>(i));
+    }
+    EXPECT_THAT([&]() { static_cast<void>(analyzer.resolve_function("identity", values::Values{})); },
+        ThrowsMessage<error::AnalysisError>(HasSubstr("failed to resolve overload for 'identity'")));
+}
+
+//------------------//
+// AnalyzerCopyTest //
+//------------------//
+
+TEST(AnalyzerCopyTest, registering_on_a_copy_does_not_change_the_original) {
+    Analyzer original{};
+    original.register_variable("x", tree::make<values::ConstInt>(1));
+    original.register_instruction("wait", "i");
+    Analyzer copy{ original };
+    copy.register_variable("y", tree::make<values::ConstInt>(2));
+    copy.register_instruction("barrier", "i");
+    auto arg = values::Value{ tree::make<values::ConstInt>(3) };
+    EXPECT_FALSE(copy.try_resolve_variable("x").empty());
+    EXPECT_FALSE(copy.try_resolve_instruction("wait", values::Values{ arg }).empty());
+    EXPECT_FALSE(copy.try_resolve_instruction("barrier", values::Values{ arg }).empty());
+    EXPECT_TRUE(original.try_resolve_variable("y").empty());
+    EXPECT_TRUE(original.try_resolve_instruction("barrier", values::Values{ arg }).empty());
+}
+TEST(AnalyzerCopyTest, copies_keep_the_registrations_of_every_scope) {
+    Analyzer original{};
+    original.register_variable("x", tree::make<values::ConstInt>(1));
+    original.push_scope();
+    original.register_variable("y", tree::make<values::ConstInt>(2));
+    Analyzer copy{ original };
+    EXPECT_FALSE(copy.try_resolve_variable("x").empty());
+    EXPECT_FALSE(copy.try_resolve_variable("y").empty());
+    copy.register_variable("z", tree::make<values::ConstInt>(3));
+    EXPECT_TRUE(original.try_resolve_variable("z").empty());
+    copy.pop_scope();
+    EXPECT_FALSE(copy.try_resolve_variable("x").empty());
+    EXPECT_TRUE(copy.try_resolve_variable("y").empty());
+    EXPECT_FALSE(original.try_resolve_variable("y").empty());
+}
+TEST(AnalyzerCopyTest, default_analyzers_do_not_share_registrations_nor_analyses) {
+    auto analyzer = default_analyzer();
+    analyzer.register_instruction("wait_for", "i");
+    auto arg = values::Value{ tree::make<values::ConstInt>(1) };
+    EXPECT_FALSE(analyzer.try_resolve_instruction("wait_for", values::Values{ arg }).empty());
+    EXPECT_TRUE(default_analyzer().try_resolve_instruction("wait_for", values::Values{ arg }).empty());
+    const std::string program = "version 3.0\nqubit q\nH q";
+    EXPECT_TRUE(default_analyzer().analyze_string(program, std::nullopt).errors.empty());
+    EXPECT_TRUE(default_analyzer().analyze_string(program, std::nullopt).errors.empty());
+}
+
+//------------------------//
+// AnalyzerReentrancyTest //
+//------------------------//
+
+const std::string reentrancy_program = "version 3.0\nqubit[2] q\nbit[2] b\nH q[0]\nCNOT q[0], q[1]\nb = measure q\n";
+
+TEST(AnalyzerReentrancyTest, analyses_do_not_change_the_analyzer) {
+    const auto analyzer = default_analyzer();
+    EXPECT_TRUE(analyzer.analyze_string(reentrancy_program, "input.cq").errors.empty());
+    EXPECT_TRUE(analyzer.analyze_string(reentrancy_program, "input.cq").errors.empty());
+    EXPECT_TRUE(analyzer.try_resolve_variable("q").empty());
+}
+TEST(AnalyzerReentrancyTest, variables_cannot_redeclare_registered_constants) {
+    const auto analyzer = default_analyzer();
+    auto result = analyzer.analyze_string("version 3.0\nqubit pi", "input.cq");
+    ASSERT_EQ(result.errors.size(), 1);
+    EXPECT_THAT(result.errors[0].what(), HasSubstr("trying to redeclare variable 'pi'"));
+}
+TEST(AnalyzerReentrancyTest, many_threads_analyze_with_the_same_analyzer) {
+    const auto analyzer = default_analyzer();
+    const auto expected_dump = fmt::format("{}", *analyzer.analyze_string(reentrancy_program, "input.cq").root);
+    std::vector<std::thread> threads;
+    std::vector<std::vector<std::string>> dumps(4);
+    for (auto& thread_dumps : dumps) {
+        threads.emplace_back([&analyzer, &thread_dumps]() {
+            for (auto i = 0; i < 100; ++i) {
+                auto result = analyzer.analyze_string(reentrancy_program, "input.cq");
+                thread_dumps.push_back(
+                    result.errors.empty() ? fmt::format("{}", *result.root) : fmt::format("{}", result.errors[0]));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& thread_dumps : dumps) {
+        EXPECT_THAT(thread_dumps, Each(expected_dump));
+    }
+}
+
 }  // namespace cqasm::v3x::analyzer
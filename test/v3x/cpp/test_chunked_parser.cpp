@@ -0,0 +1,118 @@
+#include "libqasm/v3x/chunked_parser.hpp"
+
+#include <fmt/format.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+#include "libqasm/error.hpp"
+#include "libqasm/v3x/antlr_custom_error_listener.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "libqasm/v3x/syntactic.hpp"
+#include "libqasm/v3x/syntactic_analyzer.hpp"
+
+namespace cqasm::v3x::parser {
+
+using namespace ::testing;
+
+/**
+ * Parses the input split into chunks, as the parallel_chunks build mode does.
+ */
+std::string parse_chunks_dump(
+    const std::string& input, const std::vector<ChunkStart>& chunk_starts, const ParseOptions& options) {
+    SyntacticAnalyzer builder_visitor{ "input.cq" };
+    AntlrCustomErrorListener error_listener{ "input.cq" };
+    builder_visitor.addErrorListener(&error_listener);
+    return fmt::format("{}", *parse_chunks(input, chunk_starts, builder_visitor, options));
+}
+
+TEST(ChunkedParserTest, chunks_start_at_new_line_tokens) {
+    std::string input = "version 3\nqubit[2] q /*\n*/\r\nasm(x) '''\n'''\n// \xc3\xa9\nH q[0]\n";
+    EXPECT_EQ(find_chunk_starts(input, 100, 1),
+        (std::vector<ChunkStart>{ { 0, 1, 0 }, { 9, 1, 9 }, { 26, 3, 2 }, { 42, 5, 3 }, { 48, 6, 4 }, { 55, 7, 6 } }));
+    EXPECT_EQ(find_chunk_starts(input, 3, 1), (std::vector<ChunkStart>{ { 0, 1, 0 }, { 26, 3, 2 }, { 48, 6, 4 } }));
+}
+
+TEST(ChunkedParserTest, small_input_is_a_single_chunk) {
+    std::string input = "version 3\nqubit[2] q\nH q[0]\nCNOT q[0], q[1]\n";
+    EXPECT_EQ(find_chunk_starts(input, 8, min_chunk_size), std::vector<ChunkStart>{ ChunkStart{} });
+    EXPECT_EQ(find_chunk_starts(input, 1, 1), std::vector<ChunkStart>{ ChunkStart{} });
+}
+
+TEST(ChunkedParserTest, program_is_the_same_as_with_parse_string) {
+    std::string input = "// \xc3\xa9\nversion 3.0\n\nqubit[2] q\r\nbit[2] b\n";
+    for (auto i = 0; i < 20; ++i) {
+        input += "H q[0]; CNOT q[0], q[1] /* \xc3\xa9\n */\r\n\nRx(pi / 2) q[1] // \xc3\xa9\n";
+        input += "asm(Backend) '''\n  a ' \" // /*\n'''\nb = measure q\n";
+    }
+    auto parse_result = parse_string(input, "input.cq");
+    ASSERT_TRUE(parse_result.errors.empty());
+    auto expected_dump = fmt::format("{}", *parse_result.root);
+    for (const auto& options : { ParseOptions{},
+             ParseOptions{ .lexer_type = LexerType::hand_written,
+                 .expression_parser = ExpressionParserType::precedence_climbing } }) {
+        for (size_t number_of_chunks : { 1, 2, 7 }) {
+            auto chunk_starts = find_chunk_starts(input, number_of_chunks, 1);
+            EXPECT_EQ(chunk_starts.size(), number_of_chunks);
+            EXPECT_EQ(parse_chunks_dump(input, chunk_starts, options), expected_dump);
+        }
+    }
+}
+
+TEST(ChunkedParserTest, parallel_chunks_build_mode_is_the_same_as_parse_tree) {
+    static constexpr size_t number_of_statements = 20'000;
+    std::string input = "version 3.0\nqubit[2] q\n";
+    for (size_t i = 0; i < number_of_statements; ++i) {
+        input += "CNOT q[0], q[1]\n";
+    }
+    ParseOptions options{ .build_mode = BuildMode::parallel_chunks };
+    EXPECT_EQ(fmt::format("{}", *parse_string(input, "input.cq", options).root),
+        fmt::format("{}", *parse_string(input, "input.cq").root));
+
+    // Errors are reported by parsing the whole program again
+    for (const std::string error : { "H q[\n", "Rx(1e999) q[0]\n" }) {
+        auto input_with_errors = input + error + input.substr(input.find("CNOT")) + error;
+        auto parse_result = parse_string(input_with_errors, "input.cq", options);
+        auto expected_parse_result = parse_string(input_with_errors, "input.cq");
+        ASSERT_FALSE(expected_parse_result.errors.empty());
+        ASSERT_EQ(parse_result.errors.size(), expected_parse_result.errors.size());
+        EXPECT_EQ(fmt::format("{}", parse_result.errors[0]), fmt::format("{}", expected_parse_result.errors[0]));
+    }
+}
+
+TEST(ChunkedParserTest, value_out_of_range_in_another_chunk_is_thrown) {
+    static constexpr size_t number_of_statements = 100;
+    std::string input = "version 3.0\nqubit[2] q\n";
+    for (size_t i = 0; i < number_of_statements; ++i) {
+        input += "CNOT q[0], q[1]\n";
+    }
+    input += "Rx(1e999) q[0]\n";
+    auto chunk_starts = find_chunk_starts(input, 4, 1);
+    ASSERT_EQ(chunk_starts.size(), 4);
+    SyntacticAnalyzer builder_visitor{ "input.cq" };
+    AntlrCustomErrorListener error_listener{ "input.cq" };
+    builder_visitor.addErrorListener(&error_listener);
+    auto expected_location = fmt::format("input.cq:{}:4", number_of_statements + 3);
+    // The threads parsing the other chunks are reused by the next parse
+    for (auto i = 0; i < 2; ++i) {
+        EXPECT_THAT([&]() { static_cast<void>(parse_chunks(input, chunk_starts, builder_visitor, {})); },
+            ThrowsMessage<error::ParseError>(
+                AllOf(HasSubstr(expected_location), HasSubstr("out of the FLOAT_LITERAL range"))));
+    }
+}
+
+TEST(ChunkedParserTest, parallel_chunks_build_mode_reports_values_out_of_range_in_another_chunk) {
+    std::string input = "version 3.0\nqubit[2] q\n";
+    while (input.size() < 4 * min_chunk_size) {
+        input += "CNOT q[0], q[1]\n";
+    }
+    input += "Rx(1e999) q[0]\n";
+    auto parse_result = parse_string(input, "input.cq", ParseOptions{ .build_mode = BuildMode::parallel_chunks });
+    auto expected_parse_result = parse_string(input, "input.cq");
+    ASSERT_EQ(expected_parse_result.errors.size(), 1);
+    ASSERT_EQ(parse_result.errors.size(), 1);
+    EXPECT_EQ(fmt::format("{}", parse_result.errors[0]), fmt::format("{}", expected_parse_result.errors[0]));
+}
+
+}  // namespace cqasm::v3x::parser
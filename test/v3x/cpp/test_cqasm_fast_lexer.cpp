@@ -0,0 +1,104 @@
+#include "libqasm/v3x/cqasm_fast_lexer.hpp"
+
+#include <antlr4-runtime.h>
+#include <fmt/format.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+#include "libqasm/v3x/CqasmLexer.h"
+#include "libqasm/v3x/utf8_char_stream.hpp"
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Error listener that records the errors instead of throwing.
+ */
+class RecordingErrorListener : public antlr4::BaseErrorListener {
+public:
+    std::vector<std::string> errors;
+
+    void syntaxError(antlr4::Recognizer* /* recognizer */, antlr4::Token* /* offending_symbol */, size_t line,
+        size_t char_position_in_line, const std::string& msg, std::exception_ptr /* e */) override {
+        errors.push_back(fmt::format("{}:{}: {}", line, char_position_in_line, msg));
+    }
+};
+
+/**
+ * Returns a dump of all the tokens and errors produced by a token source.
+ */
+std::vector<std::string> dump_tokens(antlr4::TokenSource& token_source, const RecordingErrorListener& listener) {
+    std::vector<std::string> ret{};
+    while (true) {
+        auto token = token_source.nextToken();
+        ret.push_back(fmt::format("{} '{}' {}:{} [{}, {}] after {} errors", token->getType(), token->getText(),
+            token->getLine(), token->getCharPositionInLine(), token->getStartIndex(), token->getStopIndex(),
+            listener.errors.size()));
+        if (token->getType() == antlr4::Token::EOF) {
+            break;
+        }
+    }
+    ret.insert(ret.end(), listener.errors.begin(), listener.errors.end());
+    return ret;
+}
+
+class CqasmFastLexerTest : public ::testing::TestWithParam<std::string> {
+protected:
+    template <typename Lexer>
+    static std::vector<std::string> lexer_tokens(antlr4::CharStream& is) {
+        Lexer lexer{ &is };
+        RecordingErrorListener listener{};
+        lexer.removeErrorListeners();
+        lexer.addErrorListener(&listener);
+        return dump_tokens(lexer, listener);
+    }
+    static std::vector<std::string> antlr_lexer_tokens(const std::string& input) {
+        antlr4::ANTLRInputStream is{ input };
+        return lexer_tokens<CqasmLexer>(is);
+    }
+    static std::vector<std::string> fast_lexer_tokens(const std::string& input) {
+        antlr4::ANTLRInputStream is{ input };
+        return lexer_tokens<CqasmFastLexer>(is);
+    }
+};
+
+TEST_P(CqasmFastLexerTest, same_tokens_as_antlr_lexer) {
+    const auto& input = GetParam();
+    EXPECT_EQ(fast_lexer_tokens(input), antlr_lexer_tokens(input));
+}
+
+/**
+ * Raw text strings are matched by searching the input bytes when reading from a Utf8CharStream.
+ */
+TEST_P(CqasmFastLexerTest, same_tokens_as_antlr_lexer_from_utf8_input) {
+    const auto& input = GetParam();
+    Utf8CharStream fast_lexer_is{ input };
+    Utf8CharStream antlr_lexer_is{ input };
+    EXPECT_EQ(lexer_tokens<CqasmFastLexer>(fast_lexer_is), lexer_tokens<CqasmLexer>(antlr_lexer_is));
+}
+
+INSTANTIATE_TEST_SUITE_P(CqasmFastLexer, CqasmFastLexerTest,
+    ::testing::Values(
+        // Empty input, version statement
+        "", "version 3", "version 3.0\n", "version\t3.01", "version 3.", "version\n3", "version v3", "version 1.2.3",
+        // New lines, white spaces, and comments
+        "\n\r\n \t\n", "\r", "\rx", "// comment\r\nx", "/* multi\nline */x", "/**/x", "/***/x", "/*/x", "/* unterminated",
+        // Signs and operators
+        ";:,.=[]()+-~!*/%", "** <<>> >= <= == != && ^^ || ? < > & ^ |", "a**-b", "x=!=y", "<<=", ">>=",
+        // Keywords and identifiers
+        "measure reset init barrier wait inv pow ctrl qubit bit asm true false",
+        "versions measured _ _x x1 trueish false_ QUBIT Bit", "version3 qubit[2] q",
+        // Numeric literals
+        "0 123 1.5 1. .5 1.e5 1.5e-3 .5E+10", "1e5 1.5e 1.5e+ .e5 1..2", "007 3.14159265358979323846",
+        // Raw text strings
+        "asm(Backend) ''' a ' \" {} () [] b '''", "'''''' x", "''''''' x", "'''\nmulti\nline\n'''",
+        "''' unterminated", "'' x", "'x", "'",
+        "asm(B) '''\xce\xbb\n\xe2\x82\xac \xc3\xa9'''\nx '''\n\xf0\x9f\x98\x80 ''' y", "''' \xc3\xa9\n\n",
+        // Token recognition errors
+        "#", "x # y\n$ z", "q@0", "x = 1 \\ 2", "\xc3\xa9t\xc3\xa9",
+        // A complete program
+        "version 3.0\n\nqubit[5] q\nbit[2] b\n\nH q[0:2]\nCNOT q[0], q[1,3]\nRx(pi / 2) q[4]\n"
+        "inv.pow(2).ctrl.X q[0], q[1]\nb = measure q[0, 1]\nreset\nbarrier q\nwait(5) q[2]\n"));
+
+}  // namespace cqasm::v3x::parser
@@ -0,0 +1,114 @@
+#include "libqasm/v3x/expression_parser.hpp"
+
+#include <antlr4-runtime.h>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <gmock/gmock.h>
+
+#include <any>
+#include <string>
+
+#include "libqasm/v3x/CqasmLexer.h"
+#include "libqasm/v3x/CqasmParser.h"
+#include "libqasm/v3x/antlr_custom_error_listener.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "libqasm/v3x/parse_options.hpp"
+#include "libqasm/v3x/syntactic.hpp"
+#include "libqasm/v3x/syntactic_analyzer.hpp"
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Token stream over an input string.
+ */
+struct ExpressionTokens {
+    antlr4::ANTLRInputStream is;
+    CqasmLexer lexer{ &is };
+    antlr4::CommonTokenStream tokens{ &lexer };
+
+    explicit ExpressionTokens(const std::string& input)
+    : is{ input } {}
+};
+
+class ExpressionParserTest : public ::testing::TestWithParam<std::string> {
+protected:
+    void SetUp() override { builder_visitor.addErrorListener(&error_listener); }
+
+    std::string antlr_parser_dump(const std::string& input) {
+        ExpressionTokens expression_tokens{ input };
+        CqasmParser parser{ &expression_tokens.tokens };
+        auto expression = std::any_cast<syntactic::One<syntactic::Expression>>(
+            parser.expression()->accept(&builder_visitor));
+        EXPECT_EQ(expression_tokens.tokens.LA(1), antlr4::Token::EOF);
+        return fmt::format("{}", *expression);
+    }
+    std::string expression_parser_dump(const std::string& input) {
+        ExpressionTokens expression_tokens{ input };
+        ExpressionParser expression_parser{ expression_tokens.tokens, builder_visitor };
+        auto expression = expression_parser.parse_expression();
+        EXPECT_EQ(expression_tokens.tokens.LA(1), antlr4::Token::EOF);
+        return fmt::format("{}", *expression);
+    }
+
+    AntlrCustomErrorListener error_listener{ "input.cq" };
+    SyntacticAnalyzer builder_visitor{ "input.cq" };
+};
+
+TEST_P(ExpressionParserTest, same_expression_as_antlr_parser) {
+    const auto& input = GetParam();
+    EXPECT_EQ(expression_parser_dump(input), antlr_parser_dump(input));
+}
+
+INSTANTIATE_TEST_SUITE_P(ExpressionParser, ExpressionParserTest,
+    ::testing::Values(
+        // Primary expressions
+        "x", "true", "42", "3.14", "f()", "f(x, 2)", "q[0]", "q[0, 2:4, i]", "(((x)))",
+        // Precedence and associativity
+        "1 + 2 * 3", "1 * 2 + 3", "1 - 2 - 3", "1 / 2 / 3 % 4", "2 ** 3 ** 4", "-2 ** 2", "2 ** -2 ** 2",
+        "+-~!x", "~a ** b", "!a ** b", "a << 1 + b >> 2", "a < b == c >= d != e", "a & b ^ c | d",
+        "a && b ^^ c || d", "a || b && c", "a | b && c & d", "(1 + 2) * 3",
+        // Ternary conditional expressions
+        "a ? b : c", "a ? b : c ? d : e", "a ? b ? c : d : e", "a || b ? c + 1 : d * 2", "f(a ? b : c, q[a ? 0 : 1])",
+        // Index ranges with ternary conditional expressions
+        "q[a ? b : c : d]", "q[1 : 2 ? 3 : 4]",
+        // Positions spanning several lines
+        "1 +\t/* multi\nline comment */ 2 * f(\n/**/x)"));
+
+TEST_F(ExpressionParserTest, incomplete_expression_is_a_mismatch) {
+    ExpressionTokens expression_tokens{ "1 + " };
+    ExpressionParser expression_parser{ expression_tokens.tokens, builder_visitor };
+    EXPECT_THROW(expression_parser.parse_expression(), ExpressionParserMismatch);
+}
+
+TEST_F(ExpressionParserTest, unbalanced_parentheses_are_a_mismatch) {
+    ExpressionTokens expression_tokens{ "(1 + 2" };
+    ExpressionParser expression_parser{ expression_tokens.tokens, builder_visitor };
+    EXPECT_THROW(expression_parser.parse_expression(), ExpressionParserMismatch);
+}
+
+TEST_F(ExpressionParserTest, instructions_are_the_same_as_with_the_antlr_parser) {
+    // 'X (a), b' and 'b = measure (q)' are left to the ANTLR parser
+    std::string input = "version 3.0\nqubit[2] q\nbit[2] b\nRx(pi / 2) q[0]\nX (q[0]) + 1\nX (q[0]), q[1]\n"
+                        "inv.pow(1 + 1).ctrl.X q[0], q[1]\nb = measure (q)\nb[0] = measure q[0]\n"
+                        "reset q; init q; barrier q\nwait(2 * 3) q[1]\nasm(Backend) ''' code '''\n";
+    auto parse_result = parse_string(input, "input.cq");
+    auto precedence_climbing_parse_result = parse_string(input, "input.cq",
+        ParseOptions{ .build_mode = BuildMode::statement_by_statement,
+            .expression_parser = ExpressionParserType::precedence_climbing });
+    ASSERT_TRUE(parse_result.errors.empty());
+    ASSERT_TRUE(precedence_climbing_parse_result.errors.empty());
+    EXPECT_EQ(fmt::format("{}", *precedence_climbing_parse_result.root), fmt::format("{}", *parse_result.root));
+}
+
+TEST_F(ExpressionParserTest, syntax_errors_are_the_same_as_with_the_antlr_parser) {
+    std::string input = "version 3.0\nqubit[2] q\nRx(pi / ) q[0]\n";
+    auto parse_result = parse_string(input, "input.cq");
+    auto precedence_climbing_parse_result = parse_string(input, "input.cq",
+        ParseOptions{ .build_mode = BuildMode::statement_by_statement,
+            .expression_parser = ExpressionParserType::precedence_climbing });
+    ASSERT_FALSE(parse_result.errors.empty());
+    EXPECT_EQ(fmt::format("{}", fmt::join(precedence_climbing_parse_result.errors, "\n")),
+        fmt::format("{}", fmt::join(parse_result.errors, "\n")));
+}
+
+}  // namespace cqasm::v3x::parser
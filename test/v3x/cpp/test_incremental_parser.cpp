@@ -0,0 +1,182 @@
+#include "libqasm/v3x/incremental_parser.hpp"
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <gmock/gmock.h>
+
+#include <stdexcept>  // invalid_argument
+#include <string>
+
+#include "libqasm/annotations.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "libqasm/v3x/syntactic.hpp"
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Returns the dump of the errors and of the program of a parse result.
+ */
+std::string get_dump(const ParseResult& parse_result) {
+    return fmt::format("{}\n{}", fmt::join(parse_result.errors, "\n"), *parse_result.root);
+}
+
+/**
+ * Returns the parse result of parse_string for a whole document, recovering from errors,
+ * as the incremental parser reports errors.
+ */
+ParseResult parse_document(const std::string& data) {
+    return parse_string(data, "input.cq", ParseOptions{ .recover_from_errors = true });
+}
+
+class IncrementalParserTest : public ::testing::Test {
+protected:
+    std::string input;
+
+    void SetUp() override {
+        input = "// \xc3\xa9\nversion 3.0\n\nqubit[2] q\r\nbit[2] b\n";
+        for (auto i = 0; i < 200; ++i) {
+            input += "H q[0]; CNOT q[0], q[1] /* \xc3\xa9\n */\r\n\nRx(pi / 2) q[1] // \xc3\xa9\n";
+            input += "asm(Backend) '''\n  a ' \" // /*\n'''\nb = measure q\n";
+        }
+        ASSERT_GT(input.size(), 4 * IncrementalParser::segment_size);
+    }
+
+    /**
+     * Applies the edit, and checks the result is the same as the one of parse_string for the edited document,
+     * recovering from errors.
+     */
+    void expect_edit(IncrementalParser& incremental_parser, const TextEdit& edit) {
+        const auto& errors = incremental_parser.apply_edit(edit);
+        EXPECT_EQ(errors.size(), parse_document(incremental_parser.data()).errors.size());
+        EXPECT_EQ(get_dump(incremental_parser.result()), get_dump(parse_document(incremental_parser.data())));
+    }
+};
+
+TEST_F(IncrementalParserTest, result_is_the_same_as_with_parse_string) {
+    for (const auto& options : { ParseOptions{},
+             ParseOptions{ .lexer_type = LexerType::hand_written,
+                 .expression_parser = ExpressionParserType::precedence_climbing } }) {
+        IncrementalParser incremental_parser{ input, "input.cq", options };
+        EXPECT_EQ(incremental_parser.data(), input);
+        ASSERT_TRUE(incremental_parser.result().errors.empty());
+        EXPECT_EQ(get_dump(incremental_parser.result()), get_dump(parse_string(input, "input.cq")));
+
+        auto middle = input.find("H q[0]", input.size() / 2);
+        // Statements and lines inserted and deleted
+        expect_edit(incremental_parser, { middle, 0, "X q[1]\nY q[0]; " });
+        expect_edit(incremental_parser, { middle, 8, "" });
+        expect_edit(incremental_parser, { middle, 0, "\n\n\n" });
+        expect_edit(incremental_parser, { middle, 3, "" });
+        // Edits within a line, and across segments
+        expect_edit(incremental_parser, { middle + 1, 1, "  " });
+        expect_edit(incremental_parser, { middle - 5000, 10000, "\nZ q[0]\n" });
+        // Edits within a comment and a raw text string
+        expect_edit(incremental_parser, { input.find("/* ") + 3, 0, "\n\n" });
+        expect_edit(incremental_parser, { input.find("'''\n") + 3, 0, "\r\n" });
+        // Edits at the start and at the end of the document
+        expect_edit(incremental_parser, { 0, 0, "\n// comment\n" });
+        expect_edit(incremental_parser, { incremental_parser.data().size(), 0, "\nI q" });
+    }
+}
+
+TEST_F(IncrementalParserTest, errors_are_the_same_as_with_parse_string) {
+    IncrementalParser incremental_parser{ input, "input.cq" };
+    auto middle = input.find("H q[0]", input.size() / 2);
+    // A comment left open, and then closed
+    expect_edit(incremental_parser, { middle, 0, "/*" });
+    EXPECT_FALSE(incremental_parser.result().errors.empty());
+    expect_edit(incremental_parser, { middle + 2, 0, "*/" });
+    EXPECT_TRUE(incremental_parser.result().errors.empty());
+    // An instruction being typed, at the end of the line before the middle one
+    auto offset = middle - 1;
+    for (const std::string text : { "\nR", "x", "(", "1e999", ")", " q", "[", "0", "]" }) {
+        expect_edit(incremental_parser, { offset, 0, text });
+        offset += text.size();
+    }
+    EXPECT_FALSE(incremental_parser.result().errors.empty());
+    expect_edit(incremental_parser, { incremental_parser.data().find("1e999"), 5, "1.5" });
+    EXPECT_TRUE(incremental_parser.result().errors.empty());
+    // A version statement being edited
+    auto version = incremental_parser.data().find("3.0");
+    expect_edit(incremental_parser, { version, 3, "" });
+    EXPECT_FALSE(incremental_parser.result().errors.empty());
+    expect_edit(incremental_parser, { version, 0, "3" });
+    EXPECT_TRUE(incremental_parser.result().errors.empty());
+}
+
+TEST_F(IncrementalParserTest, errors_are_reported_per_segment) {
+    IncrementalParser incremental_parser{ input, "input.cq" };
+    auto get_last_statement = [&incremental_parser]() {
+        const auto& statements = incremental_parser.result().root->as_program()->block->statements;
+        return statements[statements.size() - 1].get_ptr();
+    };
+    auto last_statement = get_last_statement();
+    auto number_of_statements = incremental_parser.result().root->as_program()->block->statements.size();
+    // Errors in the first and in the middle segment, with the statements after them left as they are
+    expect_edit(incremental_parser, { input.find("H q[0]"), 0, "H q[0\n" });
+    auto middle = incremental_parser.data().find("H q[0]", incremental_parser.data().size() / 2);
+    expect_edit(incremental_parser, { middle, 0, "X q[#]\n" });
+    ASSERT_EQ(incremental_parser.result().errors.size(), 2);
+    EXPECT_EQ(incremental_parser.result().root->as_program()->block->statements.size(), number_of_statements);
+    EXPECT_EQ(get_last_statement(), last_statement);
+    // Errors are still reported when editing another segment
+    expect_edit(incremental_parser, { incremental_parser.data().size(), 0, "\nY q[1]" });
+    EXPECT_EQ(incremental_parser.result().errors.size(), 2);
+}
+
+TEST_F(IncrementalParserTest, errors_at_the_end_of_a_segment_are_checked_on_the_whole_document) {
+    // The version section is after the end of the first segment
+    std::string comments{};
+    while (comments.size() < 2 * IncrementalParser::segment_size) {
+        comments += "// comment\n";
+    }
+    IncrementalParser incremental_parser{ comments + input, "input.cq" };
+    EXPECT_TRUE(incremental_parser.result().errors.empty());
+    EXPECT_EQ(get_dump(incremental_parser.result()), get_dump(parse_string(comments + input, "input.cq")));
+    // An instruction left incomplete at the end of a line
+    auto segment_end = incremental_parser.data().find("\n", incremental_parser.data().size() / 2);
+    expect_edit(incremental_parser, { segment_end, 0, " q[0" });
+    EXPECT_EQ(incremental_parser.result().errors.size(), 1);
+}
+
+TEST_F(IncrementalParserTest, statements_after_an_edit_are_reused) {
+    IncrementalParser incremental_parser{ input, "input.cq" };
+    auto get_last_statement = [&incremental_parser]() {
+        const auto& statements = incremental_parser.result().root->as_program()->block->statements;
+        return statements[statements.size() - 1].get_ptr();
+    };
+    auto last_statement = get_last_statement();
+    incremental_parser.apply_edit({ input.find("H q[0]"), 0, "X q[0]\n" });
+    EXPECT_EQ(get_last_statement(), last_statement);
+}
+
+TEST_F(IncrementalParserTest, source_locations_after_an_edit_are_shifted_by_result) {
+    IncrementalParser incremental_parser{ input, "input.cq" };
+    const auto& statements = incremental_parser.result().root->as_program()->block->statements;
+    auto last_statement = statements[statements.size() - 1];
+    auto get_last_line = [&last_statement]() {
+        return last_statement->get_annotation_ptr<annotations::SourceLocation>()->range.first.line;
+    };
+    auto last_line = get_last_line();
+    EXPECT_TRUE(incremental_parser.apply_edit({ 0, 0, "\n\n" }).empty());
+    EXPECT_EQ(get_last_line(), last_line);
+    EXPECT_EQ(get_dump(incremental_parser.result()), get_dump(parse_document(incremental_parser.data())));
+    EXPECT_EQ(get_last_line(), last_line + 2);
+}
+
+TEST_F(IncrementalParserTest, errors_are_available_without_the_result) {
+    IncrementalParser incremental_parser{ input, "input.cq" };
+    auto middle = input.find("H q[0]", input.size() / 2);
+    EXPECT_EQ(incremental_parser.apply_edit({ middle, 0, "X q[#]\n" }).size(), 1);
+    EXPECT_EQ(incremental_parser.errors().size(), 1);
+    EXPECT_EQ(fmt::format("{}", fmt::join(incremental_parser.errors(), "\n")),
+        fmt::format("{}", fmt::join(parse_document(incremental_parser.data()).errors, "\n")));
+}
+
+TEST_F(IncrementalParserTest, edit_out_of_range) {
+    IncrementalParser incremental_parser{ input, "input.cq" };
+    EXPECT_THROW(incremental_parser.apply_edit({ input.size() + 1, 0, "" }), std::invalid_argument);
+    EXPECT_THROW(incremental_parser.apply_edit({ input.size() - 1, 2, "" }), std::invalid_argument);
+}
+
+}  // namespace cqasm::v3x::parser
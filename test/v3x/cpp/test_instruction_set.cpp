@@ -186,3 +186,46 @@ TEST_F(InstructionSetTest, get_non_gate_param_types_with_param_count) {
     EXPECT_EQ(instruction_set.get_non_gate_param_types_with_param_count("measure", 3), "fff");
     EXPECT_EQ(instruction_set.get_non_gate_param_types_with_param_count("measure", 1), std::nullopt);
 }
+TEST_F(InstructionSetTest, get_opcode) {
+    EXPECT_NE(instruction_set.get_opcode("H"), Opcode::none);
+    EXPECT_NE(instruction_set.get_opcode("1q_H"), Opcode::none);
+    EXPECT_NE(instruction_set.get_opcode("measure"), Opcode::none);
+    EXPECT_NE(instruction_set.get_opcode("inv"), Opcode::none);
+    EXPECT_EQ(instruction_set.get_opcode("h"), Opcode::none);
+}
+TEST_F(InstructionSetTest, get_opcode_info) {
+    const auto& h = instruction_set.get_opcode_info(instruction_set.get_opcode("H"));
+    EXPECT_EQ(h.name, "H");
+    EXPECT_EQ(h.kind, InstructionKind::single_qubit_named_gate);
+    EXPECT_EQ(h.arity, 1);
+    EXPECT_TRUE(h.is_single_qubit_gate());
+    const auto& two_qubit_h = instruction_set.get_opcode_info(h.two_qubit_gate_composition);
+    EXPECT_EQ(two_qubit_h.name, "2q_H");
+    EXPECT_EQ(two_qubit_h.arity, 2);
+    EXPECT_EQ(two_qubit_h.named_gate, instruction_set.get_opcode("H"));
+    EXPECT_EQ(two_qubit_h.operand_types.size(), 4);
+    const auto& cnot = instruction_set.get_opcode_info(instruction_set.get_opcode("CNOT"));
+    EXPECT_TRUE(cnot.is_two_qubit_gate());
+    EXPECT_EQ(cnot.single_qubit_gate_composition, Opcode::none);
+    const auto& pow = instruction_set.get_opcode_info(instruction_set.get_opcode("pow"));
+    EXPECT_EQ(pow.modifier_kind, GateModifierKind::pow);
+    EXPECT_TRUE(pow.is_single_qubit_gate_modifier());
+    EXPECT_EQ(pow.param_types.front(), "f");
+}
+TEST_F(InstructionSetTest, get_opcode_catalog) {
+    size_t number_of_registered_overloads = 0;
+    for (const auto& info : instruction_set.get_opcode_catalog()) {
+        if (info.kind != InstructionKind::gate_modifier) {
+            number_of_registered_overloads += info.operand_types.size();
+        }
+    }
+    // Named gates, single-qubit and two-qubit compositions of single-qubit named gates, and non-gate instructions
+    EXPECT_EQ(number_of_registered_overloads, 60 + 40 + 80 + 16);
+}
+TEST_F(InstructionSetTest, get_non_gate_param_types_with_param_count_by_opcode) {
+    auto measure = instruction_set.get_opcode("measure");
+    EXPECT_TRUE(instruction_set.is_measure(measure));
+    EXPECT_FALSE(instruction_set.is_measure(instruction_set.get_opcode("reset")));
+    EXPECT_EQ(instruction_set.get_non_gate_param_types_with_param_count(measure, 3), "fff");
+    EXPECT_EQ(instruction_set.get_non_gate_param_types_with_param_count(measure, 1), std::nullopt);
+}
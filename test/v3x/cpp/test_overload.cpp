@@ -0,0 +1,51 @@
+#include "libqasm/overload.hpp"
+
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include "libqasm/v3x/types.hpp"
+#include "libqasm/v3x/values.hpp"
+
+namespace cqasm::v3x::values {
+
+using OverloadResolver = overload::OverloadResolver<std::string, types::TypeBase, ValueBase>;
+
+TEST(OverloadResolverTest, memoized_resolutions_promote_each_argument_list) {
+    OverloadResolver resolver{};
+    resolver.add_overload("float", types::from_spec("f"));
+    EXPECT_EQ(resolver.cache_size(), 0);
+    for (primitives::Int i : { 1, 2 }) {
+        auto resolution = resolver.resolve(Values{ Value{ tree::make<ConstInt>(i) } });
+        EXPECT_EQ(resolution.first, "float");
+        ASSERT_NE(resolution.second[0]->as_const_float(), nullptr);
+        EXPECT_EQ(resolution.second[0]->as_const_float()->value, static_cast<primitives::Float>(i));
+        // Both arguments have the same promotion codes, so the second resolution is a cache hit
+        EXPECT_EQ(resolver.cache_size(), 1);
+    }
+    EXPECT_FALSE(resolver.try_resolve(Values{}).has_value());
+    EXPECT_EQ(resolver.cache_size(), 2);
+    EXPECT_THROW(static_cast<void>(resolver.resolve(Values{})), overload::OverloadResolutionFailure);
+    EXPECT_EQ(resolver.cache_size(), 2);
+}
+
+TEST(OverloadResolverTest, adding_an_overload_invalidates_memoized_resolutions) {
+    OverloadResolver resolver{};
+    resolver.add_overload("float", types::from_spec("f"));
+    auto int_arg = Value{ tree::make<ConstInt>(1) };
+    EXPECT_EQ(resolver.resolve(Values{ int_arg }).first, "float");
+    EXPECT_FALSE(resolver.try_resolve(Values{ int_arg, int_arg }).has_value());
+    EXPECT_EQ(resolver.cache_size(), 2);
+
+    // A more specific overload wins over a memoized winning overload, and over a memoized failure
+    resolver.add_overload("int", types::from_spec("i"));
+    resolver.add_overload("int, int", types::from_spec("ii"));
+    EXPECT_EQ(resolver.cache_size(), 0);
+    auto resolution = resolver.resolve(Values{ int_arg });
+    EXPECT_EQ(resolution.first, "int");
+    EXPECT_NE(resolution.second[0]->as_const_int(), nullptr);
+    EXPECT_EQ(resolver.resolve(Values{ int_arg, int_arg }).first, "int, int");
+    EXPECT_EQ(resolver.cache_size(), 2);
+}
+
+}  // namespace cqasm::v3x::values
@@ -95,4 +95,45 @@ TEST_F(ParseHelperParseTest, parse_result_errors_is_empty_and_root_is_well_forme
     EXPECT_EQ(version, version_3_0);
 }
 
+TEST(ParseHelperAllocationModeTest, arena_allocation_mode_builds_the_same_tree) {
+    std::string input = "version 3.0\nqubit[2] q\nbit[2] b\nH q[0]\nCNOT q[0], q[1]\nRx(pi / 2) q[1]\nb = measure q\n";
+    auto heap_parse_result = parse_string(input, "input.cq");
+    EXPECT_EQ(heap_parse_result.arena, nullptr);
+    for (auto build_mode : { BuildMode::parse_tree, BuildMode::statement_by_statement, BuildMode::parallel_chunks }) {
+        auto arena_parse_result =
+            parse_string(input, "input.cq", { .build_mode = build_mode, .allocation_mode = AllocationMode::arena });
+        ASSERT_TRUE(arena_parse_result.errors.empty());
+        ASSERT_NE(arena_parse_result.arena, nullptr);
+        EXPECT_GT(arena_parse_result.arena->number_of_allocations(), 0);
+        EXPECT_EQ(fmt::format("{}", *arena_parse_result.root), fmt::format("{}", *heap_parse_result.root));
+    }
+}
+
+TEST(ParseHelperAllocationModeTest, nodes_outlive_the_parse_result) {
+    auto parse_result =
+        parse_string("version 3.0\nqubit q\nH q\n", "input.cq", { .allocation_mode = AllocationMode::arena });
+    auto statements = parse_result.root->as_program()->block->statements;
+    parse_result = ParseResult{};
+    ASSERT_EQ(statements.size(), 2);
+    EXPECT_EQ(statements[1]->as_gate_instruction()->gate->name->name, "H");
+}
+
+TEST(ParseHelperSourceLocationModeTest, statements_source_location_mode_only_annotates_statements_and_gates) {
+    std::string input = "version 3.0\nqubit[2] q\nH q[0]\n";
+    for (auto build_mode : { BuildMode::parse_tree, BuildMode::statement_by_statement }) {
+        auto parse_result = parse_string(input, "input.cq",
+            { .build_mode = build_mode, .source_location_mode = SourceLocationMode::statements });
+        ASSERT_TRUE(parse_result.errors.empty());
+        const auto& program = parse_result.root->as_program();
+        EXPECT_EQ(program->version->get_annotation_ptr<SourceLocation>(), nullptr);
+        const auto& variable = program->block->statements[0]->as_variable();
+        EXPECT_EQ(fmt::format("{}", variable->get_annotation<SourceLocation>()), "input.cq:2:10..11");
+        EXPECT_EQ(variable->typ->get_annotation_ptr<SourceLocation>(), nullptr);
+        const auto& gate_instruction = program->block->statements[1]->as_gate_instruction();
+        EXPECT_EQ(fmt::format("{}", gate_instruction->get_annotation<SourceLocation>()), "input.cq:3:1..2");
+        EXPECT_NE(gate_instruction->gate->get_annotation_ptr<SourceLocation>(), nullptr);
+        EXPECT_EQ(gate_instruction->operands->items[0]->get_annotation_ptr<SourceLocation>(), nullptr);
+    }
+}
+
 }  // namespace cqasm::v3x::parser
@@ -0,0 +1,91 @@
+#include "libqasm/v3x/parser_session.hpp"
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <gmock/gmock.h>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "libqasm/arena.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "utils.hpp"
+
+namespace fs = std::filesystem;
+
+namespace cqasm::v3x::parser {
+
+std::string get_parse_result_dump(const ParseResult& parse_result) {
+    return parse_result.errors.empty() ? fmt::format("SUCCESS\n{}\n", *parse_result.root)
+                                       : fmt::format("ERROR\n{}\n", fmt::join(parse_result.errors, "\n"));
+}
+
+class ParserSessionTest : public ::testing::TestWithParam<ParseOptions> {};
+
+TEST_P(ParserSessionTest, parse_results_are_the_same_as_with_parse_string) {
+    // Inputs with errors in between valid inputs check that the session is fully reset after an error
+    const std::vector<std::pair<std::string, std::optional<std::string>>> inputs{
+        { "version 3.0\nqubit[2] q\nH q[0]\nCNOT q[0], q[1]\n", "first.cq" },
+        { "version 3.0\nqubit[2] q\nH q[0\n", "second.cq" },
+        { "version 3.0\nqubit[2] q\nRx(pi / 2) q[1]\n", std::nullopt },
+        { "version 3.0\nqubit[2] q\nH q[#]\n", "fourth.cq" },
+        { "version 3.0\nqubit[2] q\nbit[2] b\nb = measure q\n", "fifth.cq" },
+        { "version 3.0\nqubit[2] q\nH q[0] X q[1]\n", "" },
+        { "", "seventh.cq" },
+    };
+    ParserSession parser_session{ GetParam() };
+    for (const auto& [input, file_name] : inputs) {
+        EXPECT_EQ(get_parse_result_dump(parser_session.parse_string(input, file_name)),
+            get_parse_result_dump(parse_string(input, file_name)));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(ParserSession, ParserSessionTest,
+    ::testing::Values(ParseOptions{}, ParseOptions{ .lexer_type = LexerType::hand_written },
+        ParseOptions{ .prediction_strategy = PredictionStrategy::sll_then_ll }));
+
+TEST(ParserSessionRecoveryTest, all_errors_are_reported_as_with_parse_string) {
+    const std::vector<std::string> inputs{
+        "version 3.0\nqubit[2] q\nH q[0\nX q[#]\nCNOT q[0] q[1]\nY q[1]\n",
+        "version 3.0\nqubit[2] q\nH q[0]\nCNOT q[0], q[1]\n",
+        "version 3.0\nqubit[2] q\nRx(1e999) q[0]\n$\nH q[0] X q[1]\n",
+    };
+    for (auto lexer_type : { LexerType::antlr, LexerType::hand_written }) {
+        auto options = ParseOptions{ .lexer_type = lexer_type, .recover_from_errors = true };
+        ParserSession parser_session{ options };
+        for (const auto& input : inputs) {
+            auto session_parse_result = parser_session.parse_string(input, "input.cq");
+            auto parse_result = parse_string(input, "input.cq", options);
+            EXPECT_EQ(fmt::format("{}", fmt::join(session_parse_result.errors, "\n")),
+                fmt::format("{}", fmt::join(parse_result.errors, "\n")));
+            EXPECT_EQ(fmt::format("{}", *session_parse_result.root), fmt::format("{}", *parse_result.root));
+        }
+    }
+}
+
+TEST(ParserSessionAllocationModeTest, arena_allocation_mode_is_the_same_as_with_parse_string) {
+    std::string input = "version 3.0\nqubit[2] q\nH q[0]\nCNOT q[0], q[1]\n";
+    ParserSession parser_session{ { .allocation_mode = AllocationMode::arena } };
+    for (auto i = 0; i < 2; ++i) {
+        auto session_parse_result = parser_session.parse_string(input, "input.cq");
+        ASSERT_TRUE(session_parse_result.errors.empty());
+        ASSERT_NE(session_parse_result.arena, nullptr);
+        EXPECT_GT(session_parse_result.arena->number_of_allocations(), 0);
+        EXPECT_EQ(get_parse_result_dump(session_parse_result), get_parse_result_dump(parse_string(input, "input.cq")));
+    }
+}
+
+TEST(ParserSessionFileTest, parse_file_is_the_same_as_parse_file) {
+    auto file_path = fs::temp_directory_path() / "libqasm_test_parser_session.cq";
+    cqasm::test::write_file(file_path, "version 3.0\nqubit[2] q\nH q[0]\nCNOT q[0], q[1]\n");
+    ParserSession parser_session{};
+    auto session_parse_result = parser_session.parse_file(file_path.string(), "input.cq");
+    auto parse_result = parse_file(file_path.string(), "input.cq");
+    fs::remove(file_path);
+    EXPECT_TRUE(session_parse_result.errors.empty());
+    EXPECT_EQ(get_parse_result_dump(session_parse_result), get_parse_result_dump(parse_result));
+}
+
+}  // namespace cqasm::v3x::parser
@@ -0,0 +1,96 @@
+#include "libqasm/v3x/prediction_telemetry.hpp"
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include "libqasm/v3x/parse_helper.hpp"
+#include "libqasm/v3x/parse_options.hpp"
+
+namespace cqasm::v3x::parser {
+
+using namespace ::testing;
+
+class PredictionTelemetryTest : public ::testing::Test {
+protected:
+    void SetUp() override { PredictionTelemetry::get_instance().reset(); }
+
+    static std::string get_errors(const ParseResult& parse_result) {
+        return fmt::format("{}", fmt::join(parse_result.errors, "\n"));
+    }
+
+    std::string valid_input = "version 3.0\nqubit[2] q\nbit[2] b\nRx(pi / 2 + 3 * tau / 7) q[0]\nb = measure q\n";
+    std::string invalid_input = "version 3.0\nqubit[2] q\nH q[0\nX q[1]\n";
+    ParseOptions sll_then_ll_options{ .prediction_strategy = PredictionStrategy::sll_then_ll };
+};
+
+TEST_F(PredictionTelemetryTest, sll_parse_of_valid_input_does_not_fall_back) {
+    auto parse_result = parse_string(valid_input, "input.cq", sll_then_ll_options);
+    EXPECT_TRUE(parse_result.errors.empty());
+    auto statistics = PredictionTelemetry::get_instance().get_statistics();
+    EXPECT_EQ(statistics.sll_parses, 1);
+    EXPECT_EQ(statistics.ll_fallbacks, 0);
+}
+
+TEST_F(PredictionTelemetryTest, sll_parse_of_invalid_input_falls_back_and_reports_the_same_errors) {
+    auto sll_then_ll_parse_result = parse_string(invalid_input, "input.cq", sll_then_ll_options);
+    auto ll_parse_result = parse_string(invalid_input, "input.cq");
+    EXPECT_FALSE(sll_then_ll_parse_result.errors.empty());
+    EXPECT_EQ(get_errors(sll_then_ll_parse_result), get_errors(ll_parse_result));
+    auto statistics = PredictionTelemetry::get_instance().get_statistics();
+    EXPECT_EQ(statistics.sll_parses, 1);
+    EXPECT_EQ(statistics.ll_fallbacks, 1);
+}
+
+TEST_F(PredictionTelemetryTest, ll_parse_does_not_attempt_sll) {
+    parse_string(valid_input, "input.cq");
+    auto statistics = PredictionTelemetry::get_instance().get_statistics();
+    EXPECT_EQ(statistics.sll_parses, 0);
+    EXPECT_EQ(statistics.ll_fallbacks, 0);
+}
+
+TEST_F(PredictionTelemetryTest, profiled_parse_records_predictions_per_rule) {
+    auto parse_result = parse_string(valid_input, "input.cq", ParseOptions{ .profile_prediction = true });
+    EXPECT_TRUE(parse_result.errors.empty());
+    auto statistics = PredictionTelemetry::get_instance().get_statistics();
+    // Instructions and expressions need more than one token of lookahead
+    EXPECT_THAT(statistics.predictions_per_rule, Contains(Pair("instruction", Gt(0))));
+    EXPECT_THAT(statistics.predictions_per_rule, Contains(Pair("expression", Gt(0))));
+    for (const auto& [rule_name, count] : statistics.full_context_predictions_per_rule) {
+        EXPECT_THAT(statistics.predictions_per_rule, Contains(Pair(rule_name, Ge(count))));
+    }
+}
+
+TEST_F(PredictionTelemetryTest, parse_without_profiling_does_not_record_predictions) {
+    parse_string(valid_input, "input.cq");
+    auto statistics = PredictionTelemetry::get_instance().get_statistics();
+    EXPECT_TRUE(statistics.predictions_per_rule.empty());
+    EXPECT_EQ(statistics.full_context_predictions, 0);
+}
+
+TEST_F(PredictionTelemetryTest, full_context_predictions_are_recorded_per_rule) {
+    auto& telemetry = PredictionTelemetry::get_instance();
+    telemetry.record_full_context_predictions("expression", 2);
+    telemetry.record_full_context_predictions("indexEntry", 1);
+    telemetry.record_full_context_predictions("gate", 0);
+    telemetry.record_full_context_predictions("expression", 1);
+    auto statistics = telemetry.get_statistics();
+    EXPECT_EQ(statistics.full_context_predictions, 4);
+    EXPECT_THAT(statistics.full_context_predictions_per_rule,
+        ElementsAre(Pair("expression", 3), Pair("indexEntry", 1)));
+}
+
+TEST_F(PredictionTelemetryTest, reset) {
+    parse_string(invalid_input, "input.cq", sll_then_ll_options);
+    PredictionTelemetry::get_instance().reset();
+    auto statistics = PredictionTelemetry::get_instance().get_statistics();
+    EXPECT_EQ(statistics.sll_parses, 0);
+    EXPECT_EQ(statistics.ll_fallbacks, 0);
+    EXPECT_EQ(statistics.full_context_predictions, 0);
+    EXPECT_TRUE(statistics.predictions_per_rule.empty());
+    EXPECT_TRUE(statistics.full_context_predictions_per_rule.empty());
+}
+
+}  // namespace cqasm::v3x::parser
@@ -0,0 +1,135 @@
+#include "libqasm/v3x/primitives.hpp"
+
+#include <gmock/gmock.h>
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>  // is_nothrow_move_assignable_v, is_nothrow_move_constructible_v
+#include <unordered_map>
+#include <vector>
+
+#include "libqasm/v3x/analyzer.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+
+namespace cqasm::v3x::primitives {
+
+//------------//
+// SymbolTest //
+//------------//
+
+TEST(SymbolTest, equal_texts_are_interned_once) {
+    auto pool_size = Symbol::pool_size();
+    Symbol symbol{ "interned_once" };
+    EXPECT_EQ(Symbol::pool_size(), pool_size + 1);
+    Symbol from_string{ std::string{ "interned_once" } };
+    Symbol from_string_view{ std::string_view{ "interned_once" } };
+    EXPECT_EQ(Symbol::pool_size(), pool_size + 1);
+    EXPECT_EQ(symbol, from_string);
+    EXPECT_EQ(symbol, from_string_view);
+    EXPECT_EQ(&symbol.str(), &from_string.str());
+    EXPECT_NE(symbol, Symbol{ "interned_twice" });
+}
+
+TEST(SymbolTest, texts_are_freed_with_their_last_symbol) {
+    auto pool_size = Symbol::pool_size();
+    {
+        Symbol symbol{ "freed_with_last_symbol" };
+        auto copy = symbol;
+        { Symbol other{ "freed_with_last_symbol" }; }
+        EXPECT_EQ(Symbol::pool_size(), pool_size + 1);
+        symbol = Symbol{ "reassigned" };
+        EXPECT_EQ(copy, "freed_with_last_symbol");
+        EXPECT_EQ(Symbol::pool_size(), pool_size + 2);
+    }
+    EXPECT_EQ(Symbol::pool_size(), pool_size);
+    {
+        auto parse_result = parser::parse_string("version 3.0\nqubit freed_with_its_tree\n", "input.cq");
+        ASSERT_TRUE(parse_result.errors.empty());
+        EXPECT_GT(Symbol::pool_size(), pool_size);
+    }
+    EXPECT_EQ(Symbol::pool_size(), pool_size);
+}
+
+TEST(SymbolTest, empty_symbols_are_not_pooled) {
+    auto pool_size = Symbol::pool_size();
+    Symbol symbol{};
+    Symbol from_string{ std::string{} };
+    EXPECT_EQ(symbol, from_string);
+    EXPECT_EQ(symbol.hash(), std::hash<std::string_view>{}(""));
+    EXPECT_EQ(Symbol::pool_size(), pool_size);
+}
+
+TEST(SymbolTest, moves_take_over_the_entry) {
+    static_assert(std::is_nothrow_move_constructible_v<Symbol>);
+    static_assert(std::is_nothrow_move_assignable_v<Symbol>);
+    auto pool_size = Symbol::pool_size();
+    Symbol symbol{ "moved" };
+    Symbol moved{ std::move(symbol) };
+    EXPECT_TRUE(symbol.empty());  // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(moved, "moved");
+    Symbol assigned{ "overwritten" };
+    EXPECT_EQ(Symbol::pool_size(), pool_size + 2);
+    assigned = std::move(moved);
+    EXPECT_TRUE(moved.empty());  // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(assigned, "moved");
+    EXPECT_EQ(Symbol::pool_size(), pool_size + 1);
+    assigned = Symbol{};
+    EXPECT_EQ(Symbol::pool_size(), pool_size);
+}
+
+TEST(SymbolTest, compares_with_strings) {
+    Symbol symbol{ "q" };
+    EXPECT_EQ(symbol, "q");
+    EXPECT_EQ(symbol, std::string{ "q" });
+    EXPECT_EQ(symbol, std::string_view{ "q" });
+    EXPECT_NE(symbol, "b");
+    EXPECT_EQ(symbol.size(), 1);
+    EXPECT_TRUE(Symbol{}.empty());
+    EXPECT_EQ(Symbol{}, "");
+    EXPECT_EQ(fmt::format("{}", symbol), "q");
+}
+
+TEST(SymbolTest, hash_is_the_hash_of_the_text) {
+    Symbol symbol{ "CNOT" };
+    EXPECT_EQ(symbol.hash(), std::hash<std::string_view>{}("CNOT"));
+    EXPECT_EQ(std::hash<Symbol>{}(symbol), symbol.hash());
+    std::unordered_map<Symbol, int> map{ { symbol, 1 } };
+    EXPECT_EQ(map.at("CNOT"), 1);
+}
+
+TEST(SymbolTest, interning_is_thread_safe) {
+    std::vector<std::thread> threads;
+    std::vector<std::vector<Symbol>> symbols(4);
+    for (auto& thread_symbols : symbols) {
+        threads.emplace_back([&thread_symbols]() {
+            for (auto i = 0; i < 1000; ++i) {
+                thread_symbols.emplace_back(fmt::format("thread_safe_{}", i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& thread_symbols : symbols) {
+        EXPECT_EQ(thread_symbols, symbols[0]);
+    }
+}
+
+TEST(SymbolTest, names_are_shared_by_syntactic_and_semantic_trees) {
+    auto parse_result = parser::parse_string("version 3.0\nqubit q\nH q\n", "input.cq");
+    ASSERT_TRUE(parse_result.errors.empty());
+    const auto& statements = parse_result.root->as_program()->block->statements;
+    const auto& syntactic_name = statements[0]->as_variable()->name->name;
+    const auto& syntactic_gate_name = statements[1]->as_gate_instruction()->gate->name->name;
+
+    auto analyzer = analyzer::Analyzer{};
+    analyzer.register_default_instructions();
+    auto analysis_result = analyzer.analyze(parse_result);
+    ASSERT_TRUE(analysis_result.errors.empty());
+    const auto& program = analysis_result.root;
+    EXPECT_EQ(&program->variables[0]->name.str(), &syntactic_name.str());
+    EXPECT_EQ(&program->block->statements[0]->as_gate_instruction()->gate->name.str(), &syntactic_gate_name.str());
+}
+
+}  // namespace cqasm::v3x::primitives
@@ -0,0 +1,130 @@
+#include "libqasm/v3x/result_cache.hpp"
+
+#include <gmock/gmock.h>
+
+#include <memory>  // make_shared
+#include <string>
+
+#include "libqasm/v3x/analyzer.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "libqasm/v3x/values.hpp"
+
+namespace cqasm::v3x {
+
+namespace {
+
+const std::string program = "version 3.0\nqubit[2] q\nH q[0]\nCNOT q[0], q[1]\n";
+
+/**
+ * Creates an analyzer with the default constants, functions, and instructions, using the given cache.
+ */
+std::unique_ptr<analyzer::Analyzer> make_analyzer(const std::shared_ptr<analyzer::AnalysisResultCache>& cache) {
+    auto ret = std::make_unique<analyzer::Analyzer>();
+    ret->register_default_constants();
+    ret->register_default_functions();
+    ret->register_default_instructions();
+    ret->result_cache = cache;
+    return ret;
+}
+
+}  // namespace
+
+TEST(ResultCacheTest, parse_results_are_shared) {
+    parser::ParseResultCache cache{ 1024 * 1024 };
+    auto result = parser::parse_string(program, "input.cq", cache);
+    ASSERT_TRUE(result->errors.empty());
+    EXPECT_EQ(parser::parse_string(program, "input.cq", cache), result);
+    // Different file names and options are different keys
+    EXPECT_NE(parser::parse_string(program, "other.cq", cache), result);
+    EXPECT_NE(parser::parse_string(program, "input.cq", cache, { .recover_from_errors = true }), result);
+
+    auto statistics = cache.get_statistics();
+    EXPECT_EQ(statistics.hits, 1);
+    EXPECT_EQ(statistics.misses, 3);
+    EXPECT_EQ(statistics.entries, 3);
+    EXPECT_GT(statistics.memory_usage, 3 * program.size());
+}
+
+TEST(ResultCacheTest, least_recently_used_results_are_evicted) {
+    auto memory_usage = program.size() + estimate_memory_usage(parser::parse_string(program, "input.cq"));
+    parser::ParseResultCache cache{ 2 * memory_usage };
+    auto first = parser::parse_string(program, "first.cq", cache);
+    auto second = parser::parse_string(program, "second.cq", cache);
+    EXPECT_EQ(parser::parse_string(program, "first.cq", cache), first);
+    parser::parse_string(program, "third.cq", cache);
+    EXPECT_EQ(parser::parse_string(program, "first.cq", cache), first);
+    EXPECT_NE(parser::parse_string(program, "second.cq", cache), second);
+
+    auto statistics = cache.get_statistics();
+    EXPECT_EQ(statistics.entries, 2);
+    EXPECT_EQ(statistics.evictions, 2);
+    EXPECT_LE(statistics.memory_usage, 2 * memory_usage);
+
+    cache.clear();
+    EXPECT_EQ(cache.get_statistics().entries, 0);
+    EXPECT_EQ(cache.get_statistics().memory_usage, 0);
+}
+
+TEST(ResultCacheTest, results_larger_than_the_cap_are_not_cached) {
+    parser::ParseResultCache cache{ program.size() };
+    auto result = parser::parse_string(program, "input.cq", cache);
+    EXPECT_NE(parser::parse_string(program, "input.cq", cache), result);
+    EXPECT_EQ(cache.get_statistics().entries, 0);
+}
+
+TEST(ResultCacheTest, analysis_results_are_shared_by_analyzers_with_the_same_configuration) {
+    auto cache = std::make_shared<analyzer::AnalysisResultCache>(1024 * 1024);
+    auto result = make_analyzer(cache)->analyze_string(program, "input.cq");
+    ASSERT_TRUE(result.errors.empty());
+    EXPECT_EQ(make_analyzer(cache)->analyze_string(program, "input.cq").root.get_ptr(), result.root.get_ptr());
+
+    // An analyzer with another instruction set does not share the result
+    auto other_analyzer = make_analyzer(cache);
+    other_analyzer->register_instruction("my_gate", "Q");
+    EXPECT_NE(other_analyzer->analyze_string(program, "input.cq").root.get_ptr(), result.root.get_ptr());
+
+    auto statistics = cache->get_statistics();
+    EXPECT_EQ(statistics.hits, 1);
+    EXPECT_EQ(statistics.misses, 2);
+}
+
+TEST(ResultCacheTest, analysis_results_do_not_resolve_the_variables_of_popped_scopes) {
+    auto cache = std::make_shared<analyzer::AnalysisResultCache>(1024 * 1024);
+    const std::string program_using_angle = "version 3.0\nqubit q\nRx(angle) q\n";
+    auto analyzer = make_analyzer(cache);
+    auto result = analyzer->analyze_string(program_using_angle, "input.cq");
+    ASSERT_FALSE(result.errors.empty());
+
+    analyzer->push_scope();
+    analyzer->register_variable("angle", tree::make<values::ConstFloat>(1.0));
+    EXPECT_TRUE(analyzer->analyze_string(program_using_angle, "input.cq").errors.empty());
+    analyzer->pop_scope();
+
+    // The configuration is the same as before the scope was pushed
+    auto result_after_pop = analyzer->analyze_string(program_using_angle, "input.cq");
+    EXPECT_FALSE(result_after_pop.errors.empty());
+    EXPECT_EQ(result_after_pop.root.get_ptr(), result.root.get_ptr());
+
+    auto statistics = cache->get_statistics();
+    EXPECT_EQ(statistics.hits, 1);
+    EXPECT_EQ(statistics.misses, 2);
+}
+
+TEST(ResultCacheTest, analyzers_with_custom_functions_do_not_use_the_cache) {
+    auto cache = std::make_shared<analyzer::AnalysisResultCache>(1024 * 1024);
+    const std::string program_using_f = "version 3.0\nqubit q\nRx(f(1.0)) q\n";
+    auto make_analyzer_with_f = [&cache](double factor) {
+        auto ret = make_analyzer(cache);
+        ret->register_consteval_core_function("f", "f", [factor](const values::Values& args) {
+            return values::Value{ tree::make<values::ConstFloat>(factor * args[0]->as_const_float()->value) };
+        });
+        return ret;
+    };
+    auto result = make_analyzer_with_f(1.0)->analyze_string(program_using_f, "input.cq");
+    ASSERT_TRUE(result.errors.empty());
+    EXPECT_NE(make_analyzer_with_f(2.0)->analyze_string(program_using_f, "input.cq").root.get_ptr(),
+        result.root.get_ptr());
+    EXPECT_EQ(cache->get_statistics().entries, 0);
+}
+
+}  // namespace cqasm::v3x
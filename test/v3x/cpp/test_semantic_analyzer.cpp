@@ -65,4 +65,24 @@ TEST_F(VisitFunctionResolveTest, analyzer_resolve_function_throws) {
         ThrowsMessage<std::runtime_error>(::testing::HasSubstr(error_message.c_str())));
 }
 
+TEST_F(VisitFunctionResolveTest, analyze_expression_returns_the_function_value) {
+    const auto& function_return_value = values::Value{ cqasm::tree::make<values::ConstInt>(3) };
+    expect_analyzer_resolve_function_ok(function_return_value);
+
+    auto name = cqasm::tree::make<syntactic::Identifier>("function_that_returns_a_non_empty_value");
+    auto arguments = cqasm::tree::make<syntactic::ExpressionList>(cqasm::tree::Any<syntactic::Expression>{});
+    auto function_call = syntactic::FunctionCall{ name, arguments };
+    auto ret = visitor.analyze_expression(function_call);
+    EXPECT_TRUE(ret.equals(function_return_value));
+}
+
+TEST_F(VisitFunctionResolveTest, analyze_expression_list_returns_the_literal_values) {
+    auto expression_list = syntactic::ExpressionList{ cqasm::tree::Any<syntactic::Expression>{
+        cqasm::tree::make<syntactic::IntegerLiteral>(1), cqasm::tree::make<syntactic::BooleanLiteral>(true) } };
+    auto ret = visitor.analyze_expression_list(expression_list);
+    ASSERT_EQ(ret.size(), 2);
+    EXPECT_TRUE(ret[0].equals(values::Value{ cqasm::tree::make<values::ConstInt>(1) }));
+    EXPECT_TRUE(ret[1].equals(values::Value{ cqasm::tree::make<values::ConstBool>(true) }));
+}
+
 }  // namespace cqasm::v3x::analyzer
@@ -0,0 +1,171 @@
+#include "libqasm/v3x/statement_parser.hpp"
+
+#include <antlr4-runtime.h>
+#include <fmt/format.h>
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include "libqasm/v3x/CqasmLexer.h"
+#include "libqasm/v3x/antlr_custom_error_listener.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "libqasm/v3x/syntactic.hpp"
+#include "libqasm/v3x/syntactic_analyzer.hpp"
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Token stream over an input string, whose lexer bails out at the first error.
+ */
+struct Tokens {
+    antlr4::ANTLRInputStream is;
+    CqasmLexer lexer{ &is };
+    antlr4::CommonTokenStream tokens{ &lexer };
+
+    Tokens(const std::string& input, antlr4::ANTLRErrorListener* error_listener)
+    : is{ input } {
+        lexer.removeErrorListeners();
+        lexer.addErrorListener(error_listener);
+    }
+};
+
+class StatementParserTest : public ::testing::Test {
+protected:
+    void SetUp() override { builder_visitor.addErrorListener(&error_listener); }
+
+    BailErrorListener bail_error_listener{};
+    AntlrCustomErrorListener error_listener{ "input.cq" };
+    SyntacticAnalyzer builder_visitor{ "input.cq" };
+};
+
+TEST_F(StatementParserTest, statements_are_the_same_as_in_the_parse_tree_mode) {
+    std::string input = "\nversion 3.0;\n\nqubit[2] q\n bit[2] b;H q[0]\nCNOT q[0], q[1]\n\nb = measure q\n\n";
+    Tokens tokens{ input, &bail_error_listener };
+    StatementParser statement_parser{ tokens.tokens, builder_visitor, &bail_error_listener, false };
+    auto program = tree::make<syntactic::Program>();
+    program->version = statement_parser.parse_version();
+    program->block = tree::make<syntactic::GlobalBlock>();
+    for (auto statement = statement_parser.parse_statement(); !statement.empty();
+         statement = statement_parser.parse_statement()) {
+        program->block->statements.add(statement);
+    }
+    EXPECT_EQ(program->block->statements.size(), 5);
+    EXPECT_TRUE(statement_parser.parse_statement().empty());
+
+    auto parse_result = parse_string(input, "input.cq");
+    ASSERT_TRUE(parse_result.errors.empty());
+    EXPECT_EQ(fmt::format("{}", *program), fmt::format("{}", *parse_result.root));
+}
+
+TEST_F(StatementParserTest, missing_statement_separator_bails_out) {
+    Tokens tokens{ "version 3.0\nqubit[2] q H q[0]\n", &bail_error_listener };
+    StatementParser statement_parser{ tokens.tokens, builder_visitor, &bail_error_listener, false };
+    statement_parser.parse_version();
+    EXPECT_FALSE(statement_parser.parse_statement().empty());
+    EXPECT_THROW(statement_parser.parse_statement(), antlr4::ParseCancellationException);
+}
+
+TEST_F(StatementParserTest, syntax_error_bails_out) {
+    Tokens tokens{ "version 3.0\nqubit[2] q\nH q[0\n", &bail_error_listener };
+    StatementParser statement_parser{ tokens.tokens, builder_visitor, &bail_error_listener, true };
+    statement_parser.parse_version();
+    EXPECT_FALSE(statement_parser.parse_statement().empty());
+    EXPECT_THROW(statement_parser.parse_statement(), antlr4::ParseCancellationException);
+}
+
+TEST_F(StatementParserTest, lexer_error_bails_out) {
+    Tokens tokens{ "version 3.0\nqubit[2] q\nH q[#]\n", &bail_error_listener };
+    StatementParser statement_parser{ tokens.tokens, builder_visitor, &bail_error_listener, false };
+    statement_parser.parse_version();
+    EXPECT_FALSE(statement_parser.parse_statement().empty());
+    EXPECT_THROW(statement_parser.parse_statement(), antlr4::ParseCancellationException);
+}
+
+TEST_F(StatementParserTest, skip_statement_recovers_from_an_error) {
+    Tokens tokens{ "version 3.0
+qubit[2] q
+H q[0; X q[1]
+CNOT q[0] q[1]
+Y q[0]
+", &bail_error_listener };
+    StatementParser statement_parser{ tokens.tokens, builder_visitor, &bail_error_listener, false };
+    statement_parser.parse_version();
+    EXPECT_FALSE(statement_parser.parse_statement().empty());
+    EXPECT_THROW(statement_parser.parse_statement(), antlr4::ParseCancellationException);
+    statement_parser.skip_statement();
+    EXPECT_FALSE(statement_parser.parse_statement().empty());
+    EXPECT_THROW(statement_parser.parse_statement(), antlr4::ParseCancellationException);
+    statement_parser.skip_statement();
+    EXPECT_FALSE(statement_parser.parse_statement().empty());
+    EXPECT_TRUE(statement_parser.parse_statement().empty());
+}
+
+TEST_F(StatementParserTest, parse_trees_are_released_after_every_instruction) {
+    std::string input = "version 3.0\nqubit[2] q\n";
+    for (auto i = 0; i < 1000; ++i) {
+        input += "H q[0]\nCNOT q[0], q[1]\n";
+    }
+    Tokens tokens{ input, &bail_error_listener };
+    StatementParser statement_parser{
+        tokens.tokens, builder_visitor, &bail_error_listener, false, ExpressionParserType::precedence_climbing
+    };
+    statement_parser.parse_version();
+    EXPECT_EQ(statement_parser.tracked_parse_tree_count(), 0);
+    for (auto statement = statement_parser.parse_statement(); !statement.empty();
+         statement = statement_parser.parse_statement()) {
+        EXPECT_EQ(statement_parser.tracked_parse_tree_count(), 0);
+    }
+}
+
+TEST(ErrorRecoveryTest, all_errors_are_reported_together_with_a_partial_program) {
+    std::string input = "version 3\nqubit[2] q\nH q[0\nX q[#]\nCNOT q[0] q[1]\nRx(1e999) q[0]\nY q[1]\n";
+    for (auto options : { ParseOptions{},
+             ParseOptions{ .lexer_type = LexerType::hand_written,
+                 .expression_parser = ExpressionParserType::precedence_climbing } }) {
+        options.recover_from_errors = true;
+        auto parse_result = parse_string(input, "input.cq", options);
+        // A lexer error is reported instead of the parser error it causes in the same statement
+        ASSERT_EQ(parse_result.errors.size(), 4);
+        for (size_t i = 0; i < parse_result.errors.size(); ++i) {
+            EXPECT_THAT(fmt::format("{}", parse_result.errors[i]),
+                ::testing::HasSubstr(fmt::format("input.cq:{}:", i + 3)));
+        }
+        const auto* program = parse_result.root->as_program();
+        ASSERT_NE(program, nullptr);
+        EXPECT_FALSE(program->version.empty());
+        EXPECT_EQ(program->block->statements.size(), 2);
+    }
+}
+
+TEST(ErrorRecoveryTest, lexer_errors_of_the_next_statement_do_not_drop_parser_errors) {
+    std::string input = "version 3\nqubit[2] q\nH q[0\n#\nX q[1] q[0]\n$ q[0]\n";
+    for (auto lexer_type : { LexerType::antlr, LexerType::hand_written }) {
+        auto parse_result = parse_string(
+            input, "input.cq", ParseOptions{ .lexer_type = lexer_type, .recover_from_errors = true });
+        ASSERT_EQ(parse_result.errors.size(), 4);
+        for (size_t i = 0; i < parse_result.errors.size(); ++i) {
+            EXPECT_THAT(fmt::format("{}", parse_result.errors[i]),
+                ::testing::HasSubstr(fmt::format("input.cq:{}:", i + 3)));
+        }
+    }
+}
+
+TEST(ErrorRecoveryTest, first_error_is_the_same_as_without_recovery) {
+    for (const std::string input : { "version 3\nqubit[2] q\nH q[0\n", "version 3\nqubit[2] q\nH q[#]\n",
+             "version 3\nqubit[2] q\nRx(1e999) q[0]\n" }) {
+        auto expected_parse_result = parse_string(input, "input.cq");
+        ASSERT_EQ(expected_parse_result.errors.size(), 1);
+        auto parse_result = parse_string(input, "input.cq", ParseOptions{ .recover_from_errors = true });
+        ASSERT_EQ(parse_result.errors.size(), 1);
+        EXPECT_EQ(fmt::format("{}", parse_result.errors[0]), fmt::format("{}", expected_parse_result.errors[0]));
+    }
+}
+
+TEST(ErrorRecoveryTest, program_without_errors_is_the_same_as_without_recovery) {
+    std::string input = "\nversion 3.0;\n\nqubit[2] q\n bit[2] b;H q[0]\nCNOT q[0], q[1]\n\nb = measure q\n\n";
+    auto parse_result = parse_string(input, "input.cq", ParseOptions{ .recover_from_errors = true });
+    ASSERT_TRUE(parse_result.errors.empty());
+    EXPECT_EQ(fmt::format("{}", *parse_result.root), fmt::format("{}", *parse_string(input, "input.cq").root));
+}
+
+}  // namespace cqasm::v3x::parser
@@ -0,0 +1,98 @@
+#include "libqasm/v3x/statement_stream.hpp"
+
+#include <fmt/format.h>
+#include <gmock/gmock.h>
+
+#include <filesystem>
+#include <string>
+
+#include "libqasm/error.hpp"
+#include "libqasm/memory_mapped_file.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "libqasm/v3x/syntactic.hpp"
+#include "utils.hpp"
+
+namespace fs = std::filesystem;
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Builds a program out of the version and statements yielded by a statement stream.
+ */
+syntactic::One<syntactic::Program> build_program(StatementStream& statement_stream) {
+    auto program = tree::make<syntactic::Program>();
+    program->version = statement_stream.version();
+    program->block = tree::make<syntactic::GlobalBlock>();
+    for (auto statement = statement_stream.next(); !statement.empty(); statement = statement_stream.next()) {
+        program->block->statements.add(statement);
+    }
+    return program;
+}
+
+/**
+ * Returns the error message of the first error parse_string reports for the input.
+ */
+std::string parse_string_error(const std::string& input) {
+    auto parse_result = parse_string(input, "input.cq");
+    return parse_result.errors.empty() ? std::string{} : fmt::format("{}", parse_result.errors[0]);
+}
+
+/**
+ * Returns the error message of the first error a statement stream reports for the input.
+ */
+std::string statement_stream_error(const std::string& input) {
+    try {
+        StatementStream statement_stream{ input, "input.cq" };
+        build_program(statement_stream);
+    } catch (const error::ParseError& err) {
+        return fmt::format("{}", err);
+    }
+    return {};
+}
+
+TEST(StatementStreamTest, statements_are_the_same_as_with_parse_string) {
+    std::string input =
+        "\nversion 3.0;\n\nqubit[2] q\n bit[2] b;H q[0]\nRx(pi / 2) q[1]\nCNOT q[0], q[1]\n\nb = measure q\n\n";
+    auto parse_result = parse_string(input, "input.cq");
+    ASSERT_TRUE(parse_result.errors.empty());
+    for (const auto& options : { ParseOptions{},
+             ParseOptions{ .lexer_type = LexerType::hand_written,
+                 .expression_parser = ExpressionParserType::precedence_climbing } }) {
+        StatementStream statement_stream{ input, "input.cq", options };
+        auto program = build_program(statement_stream);
+        EXPECT_EQ(program->block->statements.size(), 6);
+        EXPECT_TRUE(statement_stream.next().empty());
+        EXPECT_EQ(fmt::format("{}", *program), fmt::format("{}", *parse_result.root));
+    }
+}
+
+TEST(StatementStreamTest, errors_are_the_same_as_with_parse_string) {
+    for (const std::string input : { "version 3\nqubit[2] q\nH q[0\n", "version 3\nqubit[2] q H q[0]\n",
+             "version 3\nqubit[2] q\nH q[#]\n", "version 3\nqubit[2] q\nRx(1e999) q[0]\n", "version 3 H q[0]\n" }) {
+        auto expected_error = parse_string_error(input);
+        ASSERT_FALSE(expected_error.empty());
+        EXPECT_EQ(statement_stream_error(input), expected_error);
+    }
+}
+
+TEST(StatementStreamTest, statements_of_a_large_memory_mapped_file) {
+    static constexpr size_t number_of_statements = 100'000;
+    std::string input = "version 3.0\nqubit[2] q\n";
+    for (size_t i = 0; i < number_of_statements; ++i) {
+        input += "CNOT q[0], q[1]\n";
+    }
+    auto file_path = fs::temp_directory_path() / "libqasm_test_statement_stream.cq";
+    cqasm::test::write_file(file_path, input);
+    size_t count = 0;
+    {
+        MemoryMappedFile file{ file_path };
+        StatementStream statement_stream{ file.data(), "input.cq" };
+        for (auto statement = statement_stream.next(); !statement.empty(); statement = statement_stream.next()) {
+            ++count;
+        }
+    }
+    fs::remove(file_path);
+    EXPECT_EQ(count, number_of_statements + 1);
+}
+
+}  // namespace cqasm::v3x::parser
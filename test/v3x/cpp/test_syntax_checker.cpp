@@ -0,0 +1,53 @@
+#include "libqasm/v3x/syntax_checker.hpp"
+
+#include <fmt/format.h>
+#include <gmock/gmock.h>
+
+#include <filesystem>
+#include <string>
+
+#include "libqasm/error.hpp"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "utils.hpp"
+
+namespace fs = std::filesystem;
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Returns the first error of a list of errors, or an empty string if there are none.
+ */
+std::string get_first_error(const error::ParseErrors& errors) {
+    return errors.empty() ? std::string{} : fmt::format("{}", errors[0]);
+}
+
+TEST(SyntaxCheckerTest, errors_are_the_same_as_with_parse_string) {
+    for (const auto& options : { ParseOptions{},
+             ParseOptions{ .lexer_type = LexerType::hand_written,
+                 .prediction_strategy = PredictionStrategy::sll_then_ll } }) {
+        for (const std::string input : { "\nversion 3.0;\n\nqubit[2] q\n bit[2] b;H q[0]\nb = measure q\n",
+                 "version 3\nqubit[2] q\nH q[0\n", "version 3\nqubit[2] q H q[0]\n", "version 3\nqubit[2] q\nH q[#]\n",
+                 "version 3\nqubit[2] q\nRx(1e999) q[0]\n", "version 3\nqubit[99999999999999999999] q\n",
+                 "version 3.99999999999999999999\n", "version 3 H q[0]\n" }) {
+            auto errors = check_string(input, "input.cq", options);
+            auto parse_result = parse_string(input, "input.cq", options);
+            EXPECT_EQ(errors.size(), parse_result.errors.size());
+            EXPECT_EQ(get_first_error(errors), get_first_error(parse_result.errors));
+        }
+    }
+}
+
+TEST(SyntaxCheckerTest, check_file) {
+    auto file_path = fs::temp_directory_path() / "libqasm_test_syntax_checker.cq";
+    cqasm::test::write_file(file_path, "version 3\nqubit[2] q\nH q[0\n");
+    auto errors = check_file(file_path.string(), "input.cq");
+    fs::remove(file_path);
+    ASSERT_EQ(errors.size(), 1);
+    EXPECT_THAT(fmt::format("{}", errors[0]), ::testing::HasSubstr("input.cq:3:"));
+}
+
+TEST(SyntaxCheckerTest, check_file_that_does_not_exist) {
+    EXPECT_THROW(check_file("libqasm_test_syntax_checker_does_not_exist.cq", "input.cq"), error::ParseError);
+}
+
+}  // namespace cqasm::v3x::parser
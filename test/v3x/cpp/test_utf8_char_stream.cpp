@@ -0,0 +1,154 @@
+#include "libqasm/v3x/utf8_char_stream.hpp"
+
+#include <antlr4-runtime.h>
+#include <fmt/format.h>
+#include <gmock/gmock.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "libqasm/memory_mapped_file.hpp"
+#include "libqasm/v3x/CqasmLexer.h"
+#include "libqasm/v3x/parse_helper.hpp"
+#include "utils.hpp"
+
+namespace fs = std::filesystem;
+
+namespace cqasm::v3x::parser {
+
+/**
+ * Error listener that records the errors instead of throwing.
+ */
+class Utf8RecordingErrorListener : public antlr4::BaseErrorListener {
+public:
+    std::vector<std::string> errors;
+
+    void syntaxError(antlr4::Recognizer* /* recognizer */, antlr4::Token* /* offending_symbol */, size_t line,
+        size_t char_position_in_line, const std::string& msg, std::exception_ptr /* e */) override {
+        errors.push_back(fmt::format("{}:{}: {}", line, char_position_in_line, msg));
+    }
+};
+
+/**
+ * Returns a dump of the tokens, and the errors, produced by the ANTLR-generated lexer over a character stream.
+ * Token start and stop indices are left out, as they are code point offsets for an ANTLRInputStream,
+ * but byte offsets for a Utf8CharStream.
+ */
+std::vector<std::string> dump_tokens(antlr4::CharStream& is) {
+    CqasmLexer lexer{ &is };
+    Utf8RecordingErrorListener listener{};
+    lexer.removeErrorListeners();
+    lexer.addErrorListener(&listener);
+    std::vector<std::string> ret{};
+    for (auto token = lexer.nextToken(); true; token = lexer.nextToken()) {
+        ret.push_back(fmt::format("{} '{}' {}:{}", token->getType(), token->getText(), token->getLine(),
+            token->getCharPositionInLine()));
+        if (token->getType() == antlr4::Token::EOF) {
+            break;
+        }
+    }
+    ret.insert(ret.end(), listener.errors.begin(), listener.errors.end());
+    return ret;
+}
+
+class Utf8CharStreamTokensTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(Utf8CharStreamTokensTest, same_tokens_as_antlr_input_stream) {
+    const auto& input = GetParam();
+    antlr4::ANTLRInputStream antlr_input_stream{ input };
+    Utf8CharStream utf8_char_stream{ input };
+    EXPECT_EQ(dump_tokens(utf8_char_stream), dump_tokens(antlr_input_stream));
+}
+
+INSTANTIATE_TEST_SUITE_P(Utf8CharStream, Utf8CharStreamTokensTest,
+    ::testing::Values("", "version 3.0\nqubit[2] q\nH q[0]\n",
+        // Multi-byte code points in comments and raw text strings
+        "// caf\xc3\xa9\nH q  /* \xe2\x82\xac\n\xf0\x9f\x98\x80 */ X q",
+        "asm(Backend) ''' \xce\xbb \xe2\x82\xac '''\nH q",
+        // Multi-byte code points in token recognition errors
+        "H q[\xc3\xa9]", "x \xe2\x82\xac\xe2\x82\xac y\n\xf0\x9f\x98\x80 z"));
+
+TEST(Utf8CharStreamTest, indices_are_byte_offsets) {
+    Utf8CharStream is{ "a\xc3\xa9\xe2\x82\xac" "b" };
+    EXPECT_EQ(is.size(), 7);
+    EXPECT_EQ(is.LA(1), 'a');
+    EXPECT_EQ(is.LA(2), 0xE9);
+    EXPECT_EQ(is.LA(3), 0x20AC);
+    EXPECT_EQ(is.LA(4), 'b');
+    EXPECT_EQ(is.LA(5), antlr4::Token::EOF);
+    is.consume();
+    is.consume();
+    EXPECT_EQ(is.index(), 3);
+    EXPECT_EQ(is.LA(1), 0x20AC);
+    EXPECT_EQ(is.LA(-1), 0xE9);
+    EXPECT_EQ(is.LA(-2), 'a');
+    is.consume();
+    is.consume();
+    EXPECT_EQ(is.index(), 7);
+    EXPECT_EQ(is.LA(1), antlr4::Token::EOF);
+    EXPECT_THROW(is.consume(), antlr4::IllegalStateException);
+    is.seek(1);
+    EXPECT_EQ(is.LA(1), 0xE9);
+}
+
+TEST(Utf8CharStreamTest, text_includes_the_whole_last_code_point) {
+    Utf8CharStream is{ "a\xc3\xa9\xe2\x82\xac" "b" };
+    EXPECT_EQ(is.getText({ size_t{ 0 }, size_t{ 2 } }), "a\xc3\xa9");
+    EXPECT_EQ(is.getText({ size_t{ 1 }, size_t{ 3 } }), "\xc3\xa9\xe2\x82\xac");
+    EXPECT_EQ(is.getText({ size_t{ 6 }, size_t{ 10 } }), "b");
+    EXPECT_EQ(is.getText({ size_t{ 7 }, size_t{ 10 } }), "");
+}
+
+TEST(Utf8CharStreamTest, token_text_is_a_view_into_the_input) {
+    std::string input = "version 3\nbit[12] b\n";
+    Utf8CharStream is{ input };
+    CqasmLexer lexer{ &is };
+    antlr4::CommonTokenStream tokens{ &lexer };
+    tokens.fill();
+    for (auto* token : tokens.getTokens()) {
+        if (token->getType() == CqasmLexer::INTEGER_LITERAL) {
+            std::string buffer{};
+            auto text = get_token_text(*token, buffer);
+            EXPECT_EQ(text, "12");
+            EXPECT_EQ(text.data(), input.data() + input.find("12"));
+            EXPECT_TRUE(buffer.empty());
+        }
+    }
+
+    antlr4::ANTLRInputStream ais{ input };
+    CqasmLexer ais_lexer{ &ais };
+    antlr4::CommonTokenStream ais_tokens{ &ais_lexer };
+    ais_tokens.fill();
+    std::string buffer{};
+    EXPECT_EQ(get_token_text(*ais_tokens.get(1), buffer), "3");
+    EXPECT_EQ(buffer, "3");
+}
+
+TEST(Utf8CharStreamTest, invalid_bytes_are_replacement_characters) {
+    Utf8CharStream is{ "\xc3(\xff\xe2\x82" };
+    EXPECT_EQ(is.LA(1), 0xFFFD);
+    EXPECT_EQ(is.LA(2), '(');
+    EXPECT_EQ(is.LA(3), 0xFFFD);
+    EXPECT_EQ(is.LA(4), 0xFFFD);
+    EXPECT_EQ(is.LA(5), 0xFFFD);
+    EXPECT_EQ(is.LA(6), antlr4::Token::EOF);
+}
+
+TEST(Utf8CharStreamTest, parsing_a_memory_mapped_file_is_the_same_as_parsing_a_file) {
+    auto file_path = fs::temp_directory_path() / "libqasm_test_utf8_char_stream.cq";
+    cqasm::test::write_file(
+        file_path, "version 3.0\n// caf\xc3\xa9\nqubit[2] q\nH q[0]\nCNOT q[0], q[1]\nX q[\xc3\xa9]\n");
+    auto parse_result = parse_file(file_path.string(), "input.cq");
+    ParseResult memory_mapped_parse_result{};
+    {
+        MemoryMappedFile file{ file_path };
+        memory_mapped_parse_result = parse_file(file, "input.cq");
+    }
+    fs::remove(file_path);
+    ASSERT_EQ(parse_result.errors.size(), 1);
+    ASSERT_EQ(memory_mapped_parse_result.errors.size(), 1);
+    EXPECT_EQ(fmt::format("{}", memory_mapped_parse_result.errors[0]), fmt::format("{}", parse_result.errors[0]));
+}
+
+}  // namespace cqasm::v3x::parser